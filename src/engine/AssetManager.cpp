@@ -5,7 +5,7 @@
 
 AssetManager::~AssetManager() {
     for (auto& pair : m_textures) {
-        UnloadTexture(pair.second);
+        Renderer::DestroyTexture(pair.second);
     }
     m_textures.clear();
 }
@@ -21,7 +21,9 @@ Texture2D AssetManager::LoadTexture(const std::string& filepath) {
         return it->second;
     }
 
-    Texture2D texture = ::LoadTexture(filepath.c_str());
+    Image image = LoadImage(filepath.c_str());
+    Texture2D texture = Renderer::CreateTexture(image);
+    if (image.data) UnloadImage(image);
     if (texture.id == 0) {
         Logger::Instance().Error("Failed to load image " + filepath);
         return texture;
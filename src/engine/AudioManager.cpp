@@ -3,6 +3,7 @@
 #include <iostream>
 
 AudioManager::~AudioManager() {
+    if (!m_enabled) return;
     for (auto& pair : m_sounds) {
         UnloadSound(pair.second);
     }
@@ -15,7 +16,13 @@ AudioManager::~AudioManager() {
     CloseAudioDevice();
 }
 
-bool AudioManager::Initialize() {
+bool AudioManager::Initialize(bool headless) {
+    m_musicLoaded = false;
+    if (headless) {
+        Logger::Instance().Info("Audio disabled (headless)");
+        return true;
+    }
+
     InitAudioDevice();
     
     if (!IsAudioDeviceReady()) {
@@ -23,11 +30,12 @@ bool AudioManager::Initialize() {
         return false;
     }
     
-    m_musicLoaded = false;
+    m_enabled = true;
     return true;
 }
 
 void AudioManager::PlayMusicFile(const std::string& filepath, int loops) {
+    if (!m_enabled) return;
     if (m_musicLoaded) {
         UnloadMusicStream(m_currentMusic);
     }
@@ -45,6 +53,7 @@ void AudioManager::PlayMusicFile(const std::string& filepath, int loops) {
 }
 
 void AudioManager::PlaySoundFile(const std::string& filepath) {
+    if (!m_enabled) return;
     Sound sound = {};
     
     auto it = m_sounds.find(filepath);
@@ -63,17 +72,20 @@ void AudioManager::PlaySoundFile(const std::string& filepath) {
 }
 
 void AudioManager::StopMusicPlayback() {
+    if (!m_enabled) return;
     if (m_musicLoaded) {
         StopMusicStream(m_currentMusic);
     }
 }
 
 void AudioManager::SetMusicVolume(int volume) {
+    if (!m_enabled) return;
     if (m_musicLoaded) {
         ::SetMusicVolume(m_currentMusic, volume / 128.0f);
     }
 }
 
 void AudioManager::SetSoundVolume(int volume) {
+    if (!m_enabled) return;
     SetMasterVolume(volume / 128.0f);
 }
@@ -10,7 +10,9 @@ public:
     AudioManager() = default;
     ~AudioManager();
 
-    bool Initialize();
+    // Headless: no audio device is opened and every call is a no-op
+    bool Initialize(bool headless = false);
+    bool IsEnabled() const { return m_enabled; }
     
     void PlayMusicFile(const std::string& filepath, int loops = -1);
     void PlaySoundFile(const std::string& filepath);
@@ -20,8 +22,9 @@ public:
     void SetSoundVolume(int volume); // 0-128
 
 private:
-    Music m_currentMusic;
-    bool m_musicLoaded;
+    Music m_currentMusic{};
+    bool m_musicLoaded = false;
+    bool m_enabled = false;
     std::unordered_map<std::string, Sound> m_sounds;
 };
 
@@ -0,0 +1,33 @@
+#include "FixedTimestep.h"
+#include <algorithm>
+
+FixedTimestep::FixedTimestep(int tickRate, int maxCatchUpSteps) {
+    Configure(tickRate, maxCatchUpSteps);
+}
+
+void FixedTimestep::Configure(int tickRate, int maxCatchUpSteps) {
+    m_tickRate = std::max(1, tickRate);
+    m_maxCatchUpSteps = std::max(1, maxCatchUpSteps);
+    m_step = 1.0 / m_tickRate;
+    Reset();
+}
+
+void FixedTimestep::Reset() {
+    m_accumulator = 0.0;
+    m_ticks = 0;
+    m_dropped = 0.0;
+}
+
+int FixedTimestep::Advance(double elapsedSeconds) {
+    if (elapsedSeconds > 0.0) m_accumulator += elapsedSeconds;
+
+    int steps = static_cast<int>(m_accumulator / m_step);
+    m_accumulator -= steps * m_step;
+    if (m_accumulator < 0.0) m_accumulator = 0.0;   // Rounding
+    if (steps > m_maxCatchUpSteps) {
+        m_dropped += (steps - m_maxCatchUpSteps) * m_step;
+        steps = m_maxCatchUpSteps;
+    }
+    m_ticks += steps;
+    return steps;
+}
@@ -0,0 +1,43 @@
+#ifndef FIXEDTIMESTEP_H
+#define FIXEDTIMESTEP_H
+
+#include <cstdint>
+
+/**
+ * FixedTimestep - turns variable frame times into whole simulation ticks
+ *
+ * Advance() adds the real time since the last frame to an accumulator and
+ * returns how many fixed steps to simulate, so timers, AI and movement
+ * behave the same at any frame rate. A frame that would need more than
+ * maxCatchUpSteps ticks drops the excess instead (the game slows down
+ * rather than spiralling into ever longer frames). The leftover time is
+ * kept: GetAlpha() says how far it reaches into the next tick, for drawing
+ * between the previous and the current simulation state.
+ */
+class FixedTimestep {
+public:
+    explicit FixedTimestep(int tickRate = 60, int maxCatchUpSteps = 5);
+
+    void Configure(int tickRate, int maxCatchUpSteps);
+    void Reset();
+    int Advance(double elapsedSeconds);
+
+    double GetStep() const { return m_step; }
+    float GetAlpha() const { return static_cast<float>(m_accumulator / m_step); }
+    int GetTickRate() const { return m_tickRate; }
+    int GetMaxCatchUpSteps() const { return m_maxCatchUpSteps; }
+
+    // Counters since the last Reset
+    std::uint64_t GetTickCount() const { return m_ticks; }
+    double GetDroppedTime() const { return m_dropped; }
+
+private:
+    int m_tickRate;
+    int m_maxCatchUpSteps;
+    double m_step;
+    double m_accumulator = 0.0;
+    std::uint64_t m_ticks = 0;
+    double m_dropped = 0.0;
+};
+
+#endif // FIXEDTIMESTEP_H
@@ -1,17 +1,26 @@
 #include "Game.h"
+#include "FixedTimestep.h"
 #include "Renderer.h"
+#include "RenderQueue.h"
 #include "Input.h"
 #include "AssetManager.h"
 #include "AudioManager.h"
 #include "SpriteSheet.h"
 #include "TilesetConfig.h"
 #include "Logger.h"
+#include "../entities/ActorRegistry.h"
 #include "../entities/Player.h"
 #include "../entities/Enemy.h"
 #include "../entities/NPC.h"
 #include "../world/Map.h"
+#include "../world/ChunkStreamer.h"
+#include "../world/FlowField.h"
+#include "../world/MapFile.h"
+#include "../world/PathService.h"
+#include "../world/SpatialHash.h"
 #include "../world/WorldGenerator.h"
 #include "../world/Tile.h"
+#include "../systems/ActorSystems.h"
 #include "../systems/Combat.h"
 #include "../systems/Farming.h"
 #include "../systems/Inventory.h"
@@ -24,10 +33,26 @@
 #include "../systems/Fishing.h"
 #include "../ui/HUD.h"
 #include <raylib.h>
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
 #include <iostream>
+#include <thread>
+
+// Re-file an entity in its grid after it has moved
+template <typename T>
+static void TrackInGrid(SpatialHash<T>& grid, T* entity) {
+    float x, y, w, h;
+    entity->GetPosition(x, y);
+    entity->GetSize(w, h);
+    grid.Update(entity, x, y, w, h);
+}
 
 Game::Game()
     : m_running(false)
+    , m_headless(false)
+    , m_renderThread(true)
+    , m_timestep(std::make_unique<FixedTimestep>(TICK_RATE, MAX_CATCH_UP_STEPS))
     , m_windowWidth(0)
     , m_windowHeight(0)
     , m_gold(0)
@@ -43,23 +68,27 @@ Game::~Game() {
     Shutdown();
 }
 
-bool Game::Initialize(const std::string& title, int width, int height) {
+bool Game::Initialize(const std::string& title, int width, int height, bool headless) {
     m_windowWidth = width;
     m_windowHeight = height;
+    m_headless = headless;
 
     // Initialize Raylib window
     SetTraceLogLevel(LOG_WARNING);
-    InitWindow(width, height, title.c_str());
-    if (!IsWindowReady()) {
-        Logger::Instance().Error("Window creation failed");
-        return false;
+    if (m_headless) {
+        Logger::Instance().Info("Running headless: no window, frames are counted only");
+    } else {
+        InitWindow(width, height, title.c_str());
+        if (!IsWindowReady()) {
+            Logger::Instance().Error("Window creation failed");
+            return false;
+        }
+        SetTargetFPS(TARGET_FPS);
     }
 
-    SetTargetFPS(TARGET_FPS);
-
     // Initialize subsystems
     m_renderer = std::make_unique<Renderer>();
-    if (!m_renderer->Initialize(width, height)) {
+    if (!m_renderer->Initialize(width, height, m_headless ? RenderBackend::HEADLESS : RenderBackend::RAYLIB)) {
         Logger::Instance().Error("Renderer initialization failed");
         return false;
     }
@@ -73,7 +102,7 @@ bool Game::Initialize(const std::string& title, int width, int height) {
         return false;
     }
 
-    if (!m_audioManager->Initialize()) {
+    if (!m_audioManager->Initialize(m_headless)) {
         Logger::Instance().Error("Audio manager initialization failed");
         return false;
     }
@@ -83,9 +112,21 @@ bool Game::Initialize(const std::string& title, int width, int height) {
 
     // Load sprite sheets (will gracefully fallback if files don't exist)
     SpriteSheetManager::Instance().LoadDefaultAssets(m_renderer.get());
+    if (!SpriteSheetManager::Instance().GetSpriteSheet("world_tiles")) {
+        // No world art: rasterise the flat-colour look once so tiles still take the textured path
+        Logger::Instance().Info("No world tileset found, generating fallback tiles");
+        SpriteSheetManager::Instance().AddSpriteSheet("world_tiles", Map::GenerateFallbackTileset(),
+                                                      Map::TILE_SIZE, Map::TILE_SIZE);
+    }
+    // One shared page means map, entities and HUD batch without texture switches
+    SpriteSheetManager::Instance().BuildAtlas();
 
     // Initialize game objects
     m_player = std::make_unique<Player>();
+    m_actors = std::make_unique<ActorRegistry>();
+    m_enemyGrid = std::make_unique<SpatialHash<Enemy>>();
+    m_npcGrid = std::make_unique<SpatialHash<NPC>>();
+    m_enemyFlowField = std::make_unique<FlowField>();
     m_player->SetPosition(400, 300); // Start in center
     
     // Initialize game systems
@@ -106,7 +147,7 @@ bool Game::Initialize(const std::string& title, int width, int height) {
     }
     
     // Generate world using new system
-    m_currentMap = std::make_unique<Map>(25, 19);
+    m_currentMap = std::make_unique<Map>(MAP_WIDTH, MAP_HEIGHT);
     
     Logger::Instance().Info("");
     Logger::Instance().Info("=== HARVEST QUEST ===");
@@ -116,9 +157,23 @@ bool Game::Initialize(const std::string& title, int width, int height) {
     
     // Default: Generate farm
     WorldGenerator generator(12345);
-    generator.GenerateFarm(m_currentMap.get(), 25, 19);
+    generator.GenerateFarm(m_currentMap.get(), MAP_WIDTH, MAP_HEIGHT);
     Logger::Instance().Info("Generated: Farm (default)");
 
+    // Keep the player inside the world and stream chunks around the camera
+    float worldWidth, worldHeight;
+    m_currentMap->TileToWorld(MAP_WIDTH, MAP_HEIGHT, worldWidth, worldHeight);
+    m_player->SetWorldBounds(worldWidth, worldHeight);
+    m_player->SetMap(m_currentMap.get());
+    m_actors->SetMap(m_currentMap.get());
+    m_actors->SetFlowField(m_enemyFlowField.get());
+
+    ChunkStreamerConfig streamerConfig;
+    streamerConfig.residencyRadius = CHUNK_RESIDENCY_RADIUS;
+    streamerConfig.memoryBudgetBytes = CHUNK_MEMORY_BUDGET;
+    m_chunkStreamer = std::make_unique<ChunkStreamer>(m_currentMap.get(), streamerConfig);
+    m_pathService = std::make_unique<PathService>(m_currentMap.get());
+
     // Spawn initial NPCs on the farm
     SpawnNPCs();
 
@@ -150,16 +205,85 @@ bool Game::Initialize(const std::string& title, int width, int height) {
     return true;
 }
 
-void Game::Run() {
-    while (m_running && !WindowShouldClose()) {
-        float deltaTime = GetFrameTime();
+void Game::SetSimulationRate(int tickRate, int maxCatchUpSteps) {
+    m_timestep->Configure(tickRate, maxCatchUpSteps);
+}
+
+void Game::SetTargetFrameRate(int fps) {
+    if (!m_headless && IsWindowReady()) SetTargetFPS(fps);
+}
+
+void Game::Run(int maxFrames) {
+    m_timestep->Reset();
+    if (!m_renderThread) {
+        RunSingleThreaded(maxFrames);
+        return;
+    }
+
+    RenderQueue queue;
+    m_input->Poll();
+    std::thread simulation(&Game::RunSimulation, this, std::ref(queue), maxFrames);
+
+    // This thread owns the window: draw whatever the simulation hands over
+    while (const RenderCommandList* frame = queue.AcquireFrame()) {
+        m_renderer->Replay(*frame);   // EndDrawing polls events and paces to the target FPS
+        queue.ReleaseFrame();
+        m_input->Poll();
+        if (!m_headless && WindowShouldClose()) m_running = false;
+    }
+    simulation.join();
+}
+
+void Game::RunSingleThreaded(int maxFrames) {
+    int frames = 0;
+    while (m_running && (m_headless || !WindowShouldClose())) {
+        if (maxFrames > 0 && frames++ >= maxFrames) break;
+        // Without a window there is no frame clock; frames come at the target rate
+        double elapsed = m_headless ? 1.0 / TARGET_FPS : GetFrameTime();
 
-        HandleEvents();
-        Update(deltaTime);
+        m_input->Poll();
+        SimulateFrame(elapsed);
         Render();
     }
 }
 
+void Game::RunSimulation(RenderQueue& queue, int maxFrames) {
+    // raylib's frame time belongs to the render thread; time frames here instead
+    using Clock = std::chrono::steady_clock;
+    Clock::time_point last = Clock::now();
+    int frames = 0;
+    while (m_running) {
+        if (maxFrames > 0 && frames++ >= maxFrames) break;
+        Clock::time_point now = Clock::now();
+        double elapsed = m_headless ? 1.0 / TARGET_FPS : std::chrono::duration<double>(now - last).count();
+        last = now;
+
+        SimulateFrame(elapsed);
+
+        RenderCommandList* list = queue.BeginRecord();   // Waits while the render thread is a frame behind
+        if (!list) break;
+        m_renderer->BeginRecording(list);
+        Render();
+        m_renderer->EndRecording();
+        queue.Submit();
+    }
+    queue.Close();
+}
+
+void Game::SimulateFrame(double elapsedSeconds) {
+    int steps = m_timestep->Advance(elapsedSeconds);
+    float step = static_cast<float>(m_timestep->GetStep());
+    for (int i = 0; i < steps && m_running; ++i) {
+        if (m_player) m_player->StorePreviousPosition();
+        ActorSystems::StorePreviousPositions(*m_actors, ActorKind::ENEMY);
+        ActorSystems::StorePreviousPositions(*m_actors, ActorKind::NPC);
+
+        HandleEvents();   // Key presses reach the first tick only
+        Update(step);
+    }
+    m_renderer->SetInterpolation(m_timestep->GetAlpha());
+}
+
 void Game::HandleEvents() {
     m_input->Update();
 }
@@ -172,23 +296,20 @@ void Game::Update(float deltaTime) {
     // World generation hotkeys
     if (m_input->IsKeyPressed(KEY_ONE)) {
         WorldGenerator generator;
-        generator.GenerateFarm(m_currentMap.get(), 25, 19);
-        m_enemies.clear();
-        SpawnNPCs();
+        generator.GenerateFarm(m_currentMap.get(), MAP_WIDTH, MAP_HEIGHT);
+        SpawnActorsForMap();
         Logger::Instance().Info("Generated: Farm");
     }
     if (m_input->IsKeyPressed(KEY_TWO)) {
         WorldGenerator generator;
-        generator.GenerateDungeon(m_currentMap.get(), 25, 19);
-        m_npcs.clear();
-        SpawnEnemies();
+        generator.GenerateDungeon(m_currentMap.get(), MAP_WIDTH, MAP_HEIGHT);
+        SpawnActorsForMap();
         Logger::Instance().Info("Generated: Dungeon (with enemies)");
     }
     if (m_input->IsKeyPressed(KEY_THREE)) {
         WorldGenerator generator;
-        generator.GenerateOverworld(m_currentMap.get(), 25, 19, Biome::PLAINS);
-        m_enemies.clear();
-        m_npcs.clear();
+        generator.GenerateOverworld(m_currentMap.get(), MAP_WIDTH, MAP_HEIGHT, Biome::PLAINS);
+        SpawnActorsForMap();
         Logger::Instance().Info("Generated: Overworld");
     }
 
@@ -233,41 +354,20 @@ void Game::Update(float deltaTime) {
 
     // Update player
     if (m_player) {
-        // Save previous position for collision resolution
-        float prevX, prevY;
-        m_player->GetPosition(prevX, prevY);
-        
+        // Tile collision happens inside the move (see Entity::Move)
         m_player->Update(deltaTime, m_input.get());
-        
-        // Collision detection with tile system
-        float px, py;
-        m_player->GetPosition(px, py);
-        
-        // Get actual player dimensions
-        float pw, ph;
-        m_player->GetSize(pw, ph);
-        
-        // Check horizontal movement (keep previous Y)
-        if (m_currentMap->IsAreaSolid(px, prevY, pw, ph)) {
-            px = prevX;
-        }
-        
-        // Check vertical movement (use resolved X)
-        if (m_currentMap->IsAreaSolid(px, py, pw, ph)) {
-            py = prevY;
-        }
-        
-        m_player->SetPosition(px, py);
     }
 
     // Update enemies
+    UpdateEnemyFlowField();
+    UpdateEnemySight();
+    float px, py;
+    m_player->GetPosition(px, py);
+    ActorSystems::SetEnemyTargets(*m_actors, px, py);
+    ActorSystems::UpdateEnemies(*m_actors, deltaTime);
     for (auto& enemy : m_enemies) {
         if (enemy && enemy->IsActive()) {
-            // Update target to player position
-            float px, py;
-            m_player->GetPosition(px, py);
-            enemy->SetTarget(px, py);
-            enemy->Update(deltaTime);
+            TrackInGrid(*m_enemyGrid, enemy.get());
         }
     }
 
@@ -275,6 +375,7 @@ void Game::Update(float deltaTime) {
     for (auto& npc : m_npcs) {
         if (npc && npc->IsActive()) {
             npc->Update(deltaTime);
+            TrackInGrid(*m_npcGrid, npc.get());
         }
     }
 
@@ -282,12 +383,9 @@ void Game::Update(float deltaTime) {
     if (m_damageCooldown > 0.0f) {
         m_damageCooldown -= deltaTime;
     } else {
-        for (auto& enemy : m_enemies) {
-            if (Combat::EnemyContact(enemy.get(), m_player.get(), 1)) {
-                m_damageCooldown = Combat::DAMAGE_COOLDOWN;
-                Logger::Instance().Info("Player hit! Health: " + std::to_string(m_player->GetHealth()));
-                break;
-            }
+        if (Combat::EnemyContact(*m_enemyGrid, m_player.get(), 1)) {
+            m_damageCooldown = Combat::DAMAGE_COOLDOWN;
+            Logger::Instance().Info("Player hit! Health: " + std::to_string(m_player->GetHealth()));
         }
     }
 
@@ -296,6 +394,12 @@ void Game::Update(float deltaTime) {
         m_currentMap->Update(deltaTime);
     }
 
+    // Follow the player, then stream chunks around the new view
+    UpdateCamera(1.0f);
+    if (m_chunkStreamer) {
+        m_chunkStreamer->Update(*m_renderer);
+    }
+
     // Update HUD
     UpdateHUD();
 }
@@ -346,12 +450,12 @@ void Game::HandleFarmingActions() {
     }
 
     if (m_input->IsKeyPressed(KEY_H)) {
-        Tile* tile = m_currentMap->GetTileAt(tileX, tileY);
-        if (tile && tile->GetSoilState() == SoilState::HARVEST) {
+        const FarmPlot* plot = m_currentMap->GetFarmPlot(tileX, tileY);
+        if (plot && plot->GetSoilState() == SoilState::HARVEST) {
             if (m_energy && !m_energy->HasEnergy(Energy::COST_HARVEST)) {
                 m_actionText = "Too tired to harvest!";
             } else {
-                CropType type = static_cast<CropType>(tile->GetCropType());
+                CropType type = static_cast<CropType>(plot->GetCropType());
                 std::string cropName = FarmingSystem::GetCropName(type);
                 int cropValue = FarmingSystem::GetCropValue(type);
 
@@ -411,24 +515,23 @@ void Game::HandleCombatActions() {
             m_actionText = "Too tired to attack!";
         } else {
             if (m_energy) m_energy->Consume(Energy::COST_ATTACK);
-            bool hitAny = false;
-            for (auto& enemy : m_enemies) {
-                if (Combat::PlayerAttack(m_player.get(), enemy.get(), 1)) {
-                    hitAny = true;
-                    if (m_skills) m_skills->AddXP(SkillType::COMBAT, 10);
-                    if (!enemy->IsActive()) {
-                        m_gold += Combat::ENEMY_KILL_GOLD;
-                        m_actionText = "Enemy defeated! +" + std::to_string(Combat::ENEMY_KILL_GOLD) + "g";
-                        Logger::Instance().Info("Enemy defeated! Gold: " + std::to_string(m_gold));
-
-                        // Update quest objective
-                        if (m_questSystem) {
-                            m_questSystem->UpdateObjective("monster_slayer", 0, 1);
-                            m_questSystem->CheckCompletion("monster_slayer");
-                        }
-                    } else {
-                        m_actionText = "Hit enemy! HP: " + std::to_string(enemy->GetHealth());
+            std::vector<Enemy*> hits;
+            bool hitAny = Combat::PlayerAttack(m_player.get(), *m_enemyGrid, 1, hits);
+            for (Enemy* enemy : hits) {
+                if (m_skills) m_skills->AddXP(SkillType::COMBAT, 10);
+                if (!enemy->IsActive()) {
+                    m_enemyGrid->Remove(enemy);
+                    m_gold += Combat::ENEMY_KILL_GOLD;
+                    m_actionText = "Enemy defeated! +" + std::to_string(Combat::ENEMY_KILL_GOLD) + "g";
+                    Logger::Instance().Info("Enemy defeated! Gold: " + std::to_string(m_gold));
+
+                    // Update quest objective
+                    if (m_questSystem) {
+                        m_questSystem->UpdateObjective("monster_slayer", 0, 1);
+                        m_questSystem->CheckCompletion("monster_slayer");
                     }
+                } else {
+                    m_actionText = "Hit enemy! HP: " + std::to_string(enemy->GetHealth());
                 }
             }
             if (!hitAny) {
@@ -449,33 +552,36 @@ void Game::AdvanceDay() {
     }
     
     // Grow crops on the map
-    int width = m_currentMap->GetWidth();
-    int height = m_currentMap->GetHeight();
-    for (int y = 0; y < height; ++y) {
-        for (int x = 0; x < width; ++x) {
-            Tile* tile = m_currentMap->GetTileAt(x, y);
-            if (tile && tile->GetSoilState() == SoilState::CROP) {
-                int stage = tile->GetGrowthStage();
-                CropType type = static_cast<CropType>(tile->GetCropType());
-                int maxDays = FarmingSystem::GetGrowthDays(type);
-                
-                stage++;
-                if (stage >= maxDays) {
-                    tile->SetSoilState(SoilState::HARVEST);
-                    tile->SetGrowthStage(Tile::MAX_GROWTH_STAGE);
-                } else {
-                    tile->SetGrowthStage(stage);
-                }
-            }
-        }
-    }
+    m_currentMap->AdvanceDay();
 
     m_actionText = m_calendar->GetSeasonName() + " " + std::to_string(m_calendar->GetDay()) + " - Day advanced!";
     Logger::Instance().Info("Day advanced: " + m_calendar->GetSeasonName() + " " + std::to_string(m_calendar->GetDay()));
 }
 
+void Game::SpawnActorsForMap() {
+    switch (m_currentMap->GetOrigin().kind) {
+        case MapOrigin::Kind::FARM:
+            m_enemies.clear();
+            m_enemyGrid->Clear();
+            SpawnNPCs();
+            break;
+        case MapOrigin::Kind::DUNGEON:
+            m_npcs.clear();
+            m_npcGrid->Clear();
+            SpawnEnemies();
+            break;
+        default:
+            m_enemies.clear();
+            m_npcs.clear();
+            m_enemyGrid->Clear();
+            m_npcGrid->Clear();
+            break;
+    }
+}
+
 void Game::SpawnEnemies() {
     m_enemies.clear();
+    m_enemyGrid->Clear();
 
     // Spawn enemies on walkable floor tiles
     int width = m_currentMap->GetWidth();
@@ -488,13 +594,14 @@ void Game::SpawnEnemies() {
             if (tile && tile->GetType() == TileType::FLOOR && !tile->IsSolid()) {
                 // Only spawn on some floor tiles (spread them out)
                 if ((x + y) % SPAWN_SPACING == 0) {
-                    auto enemy = std::make_unique<Enemy>();
+                    auto enemy = std::make_unique<Enemy>(m_actors.get());
                     float wx, wy;
                     m_currentMap->TileToWorld(x, y, wx, wy);
                     enemy->SetPosition(wx, wy);
                     enemy->SetPatrolOrigin(wx, wy);
                     enemy->SetSize(28, 28);
                     enemy->SetAIState(Enemy::AIState::PATROL);
+                    m_enemyGrid->Update(enemy.get(), wx, wy, 28, 28);
                     m_enemies.push_back(std::move(enemy));
                     spawned++;
                 }
@@ -504,8 +611,49 @@ void Game::SpawnEnemies() {
     Logger::Instance().Info("Spawned " + std::to_string(spawned) + " enemies");
 }
 
+void Game::UpdateEnemySight() {
+    if (m_enemies.empty() || !m_player || !m_currentMap) return;
+
+    // One batched raycast from every enemy's centre to the player's, straight
+    // from the registry's columns into its sight flags
+    const ActorColumns& c = m_actors->GetColumns(ActorKind::ENEMY);
+    int count = m_actors->GetCount(ActorKind::ENEMY);
+    m_sightX.resize(count);
+    m_sightY.resize(count);
+    for (int i = 0; i < count; ++i) {
+        m_sightX[i] = c.x[i] + c.width[i] * 0.5f;
+        m_sightY[i] = c.y[i] + c.height[i] * 0.5f;
+    }
+
+    float px, py, pw, ph;
+    m_player->GetPosition(px, py);
+    m_player->GetSize(pw, ph);
+    m_currentMap->HasLineOfSight(px + pw * 0.5f, py + ph * 0.5f, Enemy::LOSE_RANGE,
+                                 m_sightX.data(), m_sightY.data(), count,
+                                 m_actors->GetEnemyColumns().targetVisible.data());
+}
+
+void Game::UpdateEnemyFlowField() {
+    if (m_enemies.empty() || !m_player || !m_currentMap) return;
+
+    // One search per player tile change (or solidity change, which includes a
+    // new map), shared by every chasing enemy
+    float px, py, pw, ph;
+    m_player->GetPosition(px, py);
+    m_player->GetSize(pw, ph);
+    int tileX, tileY;
+    m_currentMap->WorldToTile(px + pw * 0.5f, py + ph * 0.5f, tileX, tileY);
+    if (m_enemyFlowField->IsTarget(tileX, tileY) &&
+        m_flowFieldSolidityGeneration == m_currentMap->GetSolidityGeneration()) {
+        return;
+    }
+    m_enemyFlowField->Build(*m_currentMap, tileX, tileY);
+    m_flowFieldSolidityGeneration = m_currentMap->GetSolidityGeneration();
+}
+
 void Game::SpawnNPCs() {
     m_npcs.clear();
+    m_npcGrid->Clear();
     if (!m_currentMap) return;
 
     // Create a few NPCs on the farm
@@ -522,10 +670,11 @@ void Game::SpawnNPCs() {
     };
 
     for (const auto& def : defs) {
-        auto npc = std::make_unique<NPC>();
+        auto npc = std::make_unique<NPC>(m_actors.get());
         npc->SetName(def.name);
         npc->SetPosition(def.x, def.y);
         npc->SetSize(32, 32);
+        npc->SetPathService(m_pathService.get());
 
         // Build a small dialogue tree for each NPC
         Dialogue& dlg = npc->GetDialogue();
@@ -549,6 +698,7 @@ void Game::SpawnNPCs() {
         npc->AddScheduleEntry(8, def.x + 40.0f, def.y - 20.0f);
         npc->AddScheduleEntry(18, def.x, def.y);
 
+        m_npcGrid->Update(npc.get(), def.x, def.y, 32, 32);
         m_npcs.push_back(std::move(npc));
     }
 
@@ -587,48 +737,61 @@ void Game::HandleNPCInteraction() {
         float px, py;
         m_player->GetPosition(px, py);
 
-        for (auto& npc : m_npcs) {
-            if (npc && npc->IsActive() && npc->IsPlayerNearby(px, py)) {
-                Dialogue& dlg = npc->GetDialogue();
-                if (!dlg.IsActive()) {
-                    dlg.Start();
-                    npc->AddFriendship(1);
-                    m_dialogueChoiceIndex = 0;
-                    const DialogueNode* node = dlg.GetCurrentNode();
-                    if (node) {
-                        m_actionText = node->speakerLine;
-                        if (!node->choices.empty()) {
-                            m_actionText += " [" + node->choices[0].text + "]";
-                        }
+        // Only talk to the closest NPC in range
+        std::vector<NPC*> nearby;
+        m_npcGrid->QueryRadius(px, py, NPC::INTERACT_RANGE, nearby);
+        NPC* npc = nullptr;
+        float closestSq = 0.0f;
+        for (NPC* candidate : nearby) {
+            if (!candidate->IsActive() || !candidate->IsPlayerNearby(px, py)) continue;
+            float nx, ny;
+            candidate->GetPosition(nx, ny);
+            float distSq = (nx - px) * (nx - px) + (ny - py) * (ny - py);
+            if (!npc || distSq < closestSq) {
+                npc = candidate;
+                closestSq = distSq;
+            }
+        }
+
+        if (npc) {
+            Dialogue& dlg = npc->GetDialogue();
+            if (!dlg.IsActive()) {
+                dlg.Start();
+                npc->AddFriendship(1);
+                m_dialogueChoiceIndex = 0;
+                const DialogueNode* node = dlg.GetCurrentNode();
+                if (node) {
+                    m_actionText = node->speakerLine;
+                    if (!node->choices.empty()) {
+                        m_actionText += " [" + node->choices[0].text + "]";
                     }
+                }
 
-                    // Update quest objective
-                    if (m_questSystem) {
-                        m_questSystem->UpdateObjective("community_helper", 0, 1);
-                        m_questSystem->CheckCompletion("community_helper");
+                // Update quest objective
+                if (m_questSystem) {
+                    m_questSystem->UpdateObjective("community_helper", 0, 1);
+                    m_questSystem->CheckCompletion("community_helper");
+                }
+            } else {
+                // Advance or close dialogue
+                const DialogueNode* node = dlg.GetCurrentNode();
+                if (node && node->choices.empty()) {
+                    dlg.Advance();
+                } else if (node && !node->choices.empty()) {
+                    // Use Up/Down to navigate choices, E to confirm
+                    dlg.SelectChoice(m_dialogueChoiceIndex);
+                    m_dialogueChoiceIndex = 0;
+                }
+                const DialogueNode* next = dlg.GetCurrentNode();
+                if (next) {
+                    m_actionText = next->speakerLine;
+                    if (!next->choices.empty()) {
+                        int idx = std::min(m_dialogueChoiceIndex, static_cast<int>(next->choices.size()) - 1);
+                        m_actionText += " [" + next->choices[idx].text + "]";
                     }
                 } else {
-                    // Advance or close dialogue
-                    const DialogueNode* node = dlg.GetCurrentNode();
-                    if (node && node->choices.empty()) {
-                        dlg.Advance();
-                    } else if (node && !node->choices.empty()) {
-                        // Use Up/Down to navigate choices, E to confirm
-                        dlg.SelectChoice(m_dialogueChoiceIndex);
-                        m_dialogueChoiceIndex = 0;
-                    }
-                    const DialogueNode* next = dlg.GetCurrentNode();
-                    if (next) {
-                        m_actionText = next->speakerLine;
-                        if (!next->choices.empty()) {
-                            int idx = std::min(m_dialogueChoiceIndex, static_cast<int>(next->choices.size()) - 1);
-                            m_actionText += " [" + next->choices[idx].text + "]";
-                        }
-                    } else {
-                        m_actionText = npc->GetName() + ": See you later!";
-                    }
+                    m_actionText = npc->GetName() + ": See you later!";
                 }
-                break; // Only talk to closest NPC
             }
         }
     }
@@ -704,6 +867,14 @@ void Game::HandleSaveLoad() {
                              m_calendar.get(), m_gold,
                              m_energy.get(), m_skills.get(),
                              m_questSystem.get())) {
+            // Only what the player changed since the map was generated. A map
+            // that can't be delta-saved must not leave an older delta behind
+            // for F9 to pair with this save.
+            if (!m_currentMap->HasOrigin() ||
+                !MapFile::SaveDelta(*m_currentMap, SaveSystem::DEFAULT_MAP_SAVE_PATH)) {
+                std::error_code ec;
+                std::filesystem::remove(SaveSystem::DEFAULT_MAP_SAVE_PATH, ec);
+            }
             m_actionText = "Game saved!";
         } else {
             m_actionText = "Save failed!";
@@ -716,6 +887,11 @@ void Game::HandleSaveLoad() {
                              m_calendar.get(), m_gold,
                              m_energy.get(), m_skills.get(),
                              m_questSystem.get())) {
+            // The delta may rebuild a different kind of map; repopulate it to match
+            if (std::filesystem::exists(SaveSystem::DEFAULT_MAP_SAVE_PATH) &&
+                MapFile::LoadDelta(*m_currentMap, SaveSystem::DEFAULT_MAP_SAVE_PATH)) {
+                SpawnActorsForMap();
+            }
             m_actionText = "Game loaded!";
         } else {
             m_actionText = "No save file found!";
@@ -723,6 +899,25 @@ void Game::HandleSaveLoad() {
     }
 }
 
+void Game::UpdateCamera(float alpha) {
+    if (!m_player || !m_currentMap) return;
+
+    float px, py, pw, ph;
+    m_player->GetRenderPosition(alpha, px, py);
+    m_player->GetSize(pw, ph);
+
+    // Centre on the player, clamped so the view stays inside the world
+    float worldWidth, worldHeight;
+    m_currentMap->TileToWorld(m_currentMap->GetWidth(), m_currentMap->GetHeight(), worldWidth, worldHeight);
+    int viewW = m_renderer->GetWidth();
+    int viewH = m_renderer->GetHeight();
+    int cameraX = static_cast<int>(px + pw / 2) - viewW / 2;
+    int cameraY = static_cast<int>(py + ph / 2) - viewH / 2;
+    cameraX = std::max(0, std::min(cameraX, static_cast<int>(worldWidth) - viewW));
+    cameraY = std::max(0, std::min(cameraY, static_cast<int>(worldHeight) - viewH));
+    m_renderer->SetCamera(cameraX, cameraY);
+}
+
 void Game::UpdateHUD() {
     if (!m_hud || !m_player || !m_calendar) return;
 
@@ -762,6 +957,8 @@ void Game::UpdateHUD() {
 
 void Game::Render() {
     m_renderer->Clear(20, 20, 30); // Dark background
+    m_renderer->SetLayer(RenderLayer::WORLD);
+    UpdateCamera(m_renderer->GetInterpolation());   // Follow the player as drawn
 
     // Render map (with seasonal tileset support)
     if (m_currentMap) {
@@ -769,36 +966,59 @@ void Game::Render() {
         m_currentMap->Render(m_renderer.get(), season, m_tilesetConfig.get());
     }
 
-    // Render enemies
-    for (auto& enemy : m_enemies) {
-        if (enemy && enemy->IsActive()) {
+    // Render enemies and NPCs under the camera, found through their grids
+    m_renderer->SetLayer(RenderLayer::ENTITIES);
+    int cameraX, cameraY;
+    m_renderer->GetCamera(cameraX, cameraY);
+    float viewX = static_cast<float>(cameraX);
+    float viewY = static_cast<float>(cameraY);
+    float viewW = static_cast<float>(m_renderer->GetWidth());
+    float viewH = static_cast<float>(m_renderer->GetHeight());
+
+    m_visibleEnemies.clear();
+    m_enemyGrid->QueryAABB(viewX, viewY, viewW, viewH, m_visibleEnemies);
+    for (Enemy* enemy : m_visibleEnemies) {
+        if (enemy->IsActive()) {
             enemy->Render(m_renderer.get());
         }
     }
 
-    // Render NPCs
-    for (auto& npc : m_npcs) {
-        if (npc && npc->IsActive()) {
+    m_visibleNPCs.clear();
+    m_npcGrid->QueryAABB(viewX, viewY, viewW, viewH, m_visibleNPCs);
+    for (NPC* npc : m_visibleNPCs) {
+        if (npc->IsActive()) {
             npc->Render(m_renderer.get());
         }
     }
 
     // Render player
     if (m_player) {
-        m_player->Render(m_renderer.get());
+        float px, py, pw, ph;
+        m_player->GetPosition(px, py);
+        m_player->GetSize(pw, ph);
+        if (m_renderer->IsVisible(px, py, pw, ph)) {
+            m_player->Render(m_renderer.get());
+        }
     }
 
-    // Render HUD (on top of everything)
+    // Render HUD (on top of everything, in screen space)
+    m_renderer->SetLayer(RenderLayer::UI);
     if (m_hud) {
+        m_renderer->SetCamera(0, 0);
         m_hud->Render(m_renderer.get());
+        m_renderer->SetCamera(cameraX, cameraY);
     }
 
     m_renderer->Present();
 }
 
 void Game::Shutdown() {
+    m_enemyGrid.reset();
+    m_npcGrid.reset();
+    m_enemyFlowField.reset();
     m_enemies.clear();
     m_npcs.clear();
+    m_actors.reset();
     m_hud.reset();
     m_calendar.reset();
     m_inventory.reset();
@@ -809,6 +1029,8 @@ void Game::Shutdown() {
     m_fishingSystem.reset();
     m_tilesetConfig.reset();
     m_player.reset();
+    m_chunkStreamer.reset();
+    m_pathService.reset();
     m_currentMap.reset();
     
     // Cleanup sprite sheets
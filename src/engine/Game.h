@@ -1,18 +1,27 @@
 #ifndef GAME_H
 #define GAME_H
 
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
 #include <memory>
 #include <string>
 #include <vector>
 
 class Renderer;
+class RenderQueue;
+class FixedTimestep;
 class Input;
 class AssetManager;
 class AudioManager;
 class Player;
+class ActorRegistry;
 class Enemy;
 class NPC;
 class Map;
+class ChunkStreamer;
+class FlowField;
+class PathService;
 class HUD;
 class Calendar;
 class Inventory;
@@ -23,22 +32,43 @@ class Skills;
 class QuestSystem;
 class FishingSystem;
 class TilesetConfig;
+template <typename T> class SpatialHash;
 
 /**
  * Main game class that manages the game loop and core systems
+ *
+ * By default Run() splits the frame across two threads. The calling thread
+ * owns the window: it replays recorded frames and polls input. A simulation
+ * thread runs HandleEvents/Update/Render, where Render only records into a
+ * RenderQueue, so simulating frame N+1 overlaps drawing frame N.
+ *
+ * Update always advances by one fixed tick. Each frame runs as many ticks
+ * as real time calls for (capped; see FixedTimestep) and then draws
+ * entities and the camera interpolated between the last two ticks.
  */
 class Game {
 public:
     Game();
     ~Game();
 
-    bool Initialize(const std::string& title, int width, int height);
-    void Run();
+    // Headless opens no window or audio device; frames are counted, not drawn
+    bool Initialize(const std::string& title, int width, int height, bool headless = false);
+    // Runs until quit, or for maxFrames frames when that is positive
+    void Run(int maxFrames = 0);
+    // Off: simulate and draw back to back on the calling thread (set before Run)
+    void SetRenderThread(bool enabled) { m_renderThread = enabled; }
+    // Simulation ticks per second, and the most ticks one frame may run to catch up
+    void SetSimulationRate(int tickRate, int maxCatchUpSteps);
+    // Frame cap for drawing, independent of the tick rate (0 = uncapped)
+    void SetTargetFrameRate(int fps);
+    const FixedTimestep& GetTimestep() const { return *m_timestep; }
     void Shutdown();
 
     // Game state
     bool IsRunning() const { return m_running; }
+    bool IsHeadless() const { return m_headless; }
     void Quit() { m_running = false; }
+    bool UsesRenderThread() const { return m_renderThread; }
 
     // Subsystem access
     Renderer* GetRenderer() const { return m_renderer.get(); }
@@ -48,8 +78,13 @@ public:
 
     // Game constants
     static constexpr int TARGET_FPS = 60;
+    static constexpr int TICK_RATE = 60;
+    static constexpr int MAX_CATCH_UP_STEPS = 5;
 
 private:
+    void RunSingleThreaded(int maxFrames);
+    void RunSimulation(RenderQueue& queue, int maxFrames);
+    void SimulateFrame(double elapsedSeconds);
     void HandleEvents();
     void Update(float deltaTime);
     void Render();
@@ -64,10 +99,17 @@ private:
     void HandleSaveLoad();
     void AdvanceDay();
     void SpawnEnemies();
+    void UpdateEnemyFlowField();
+    void UpdateEnemySight();
     void SpawnNPCs();
+    void SpawnActorsForMap();   // Enemies for dungeons, NPCs for the farm, nobody elsewhere
     void UpdateHUD();
+    void UpdateCamera(float alpha);
 
-    bool m_running;
+    std::atomic<bool> m_running;   // Cleared by either thread
+    bool m_headless;
+    bool m_renderThread;
+    std::unique_ptr<FixedTimestep> m_timestep;
     int m_windowWidth;
     int m_windowHeight;
 
@@ -80,8 +122,18 @@ private:
     // Game objects
     std::unique_ptr<Player> m_player;
     std::unique_ptr<Map> m_currentMap;
+    std::unique_ptr<ChunkStreamer> m_chunkStreamer;   // Declared after the map so it goes first
+    std::unique_ptr<PathService> m_pathService;       // NPC schedule paths; also goes before the map
+    std::unique_ptr<ActorRegistry> m_actors;          // Enemy/NPC component arrays; outlives their views
     std::vector<std::unique_ptr<Enemy>> m_enemies;
     std::vector<std::unique_ptr<NPC>> m_npcs;
+    std::unique_ptr<SpatialHash<Enemy>> m_enemyGrid;   // Active enemies, kept in step as they move
+    std::unique_ptr<SpatialHash<NPC>> m_npcGrid;
+    std::vector<Enemy*> m_visibleEnemies;             // Per-frame culling scratch
+    std::vector<NPC*> m_visibleNPCs;
+    std::unique_ptr<FlowField> m_enemyFlowField;       // Toward the player; rebuilt when they change tile
+    std::uint32_t m_flowFieldSolidityGeneration = 0;
+    std::vector<float> m_sightX, m_sightY;             // Enemy eye points for the batched sight check
 
     // Game systems
     std::unique_ptr<HUD> m_hud;
@@ -103,6 +155,14 @@ private:
     std::string m_actionText;
     int m_dialogueChoiceIndex; // For dialogue choice navigation
 
+    // World size in tiles (Map storage is chunked, so larger worlds are cheap)
+    static constexpr int MAP_WIDTH = 25;
+    static constexpr int MAP_HEIGHT = 19;
+
+    // Chunk streaming around the camera
+    static constexpr int CHUNK_RESIDENCY_RADIUS = 2;
+    static constexpr std::size_t CHUNK_MEMORY_BUDGET = 4 * 1024 * 1024;
+
     // Spawn tuning
     static constexpr int MAX_ENEMIES = 5;
     static constexpr int SPAWN_BORDER = 2;
@@ -4,28 +4,45 @@ Input::Input()
 {
 }
 
+void Input::Poll() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (int key = 0; key < MAX_KEYS; ++key) {
+        m_polled.down[key] = ::IsKeyDown(key);
+        if (::IsKeyPressed(key)) m_polled.pressed[key] = true;
+        if (::IsKeyReleased(key)) m_polled.released[key] = true;
+    }
+    for (int button = 0; button < MAX_BUTTONS; ++button) {
+        m_polled.buttons[button] = ::IsMouseButtonDown(button);
+    }
+    Vector2 pos = ::GetMousePosition();
+    m_polled.mouseX = static_cast<int>(pos.x);
+    m_polled.mouseY = static_cast<int>(pos.y);
+}
+
 void Input::Update() {
-    // Raylib handles input polling internally each frame
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_current = m_polled;
+    m_polled.pressed.reset();
+    m_polled.released.reset();
 }
 
 bool Input::IsKeyDown(int key) const {
-    return ::IsKeyDown(key);
+    return key >= 0 && key < MAX_KEYS && m_current.down[key];
 }
 
 bool Input::IsKeyPressed(int key) const {
-    return ::IsKeyPressed(key);
+    return key >= 0 && key < MAX_KEYS && m_current.pressed[key];
 }
 
 bool Input::IsKeyReleased(int key) const {
-    return ::IsKeyReleased(key);
+    return key >= 0 && key < MAX_KEYS && m_current.released[key];
 }
 
 void Input::GetMousePosition(int& x, int& y) const {
-    Vector2 pos = ::GetMousePosition();
-    x = static_cast<int>(pos.x);
-    y = static_cast<int>(pos.y);
+    x = m_current.mouseX;
+    y = m_current.mouseY;
 }
 
 bool Input::IsMouseButtonDown(int button) const {
-    return ::IsMouseButtonDown(button);
+    return button >= 0 && button < MAX_BUTTONS && m_current.buttons[button];
 }
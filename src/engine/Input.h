@@ -2,15 +2,24 @@
 #define INPUT_H
 
 #include <raylib.h>
+#include <bitset>
+#include <mutex>
 
 /**
  * Input handling system for keyboard and gamepad
+ *
+ * Queries read a snapshot, not raylib. Poll() copies raylib's state on the
+ * thread that owns the window (right after it has polled events); Update()
+ * publishes everything polled since the previous Update() to the queries.
+ * Presses and releases accumulate between updates, so a simulation running
+ * on another thread sees every edge exactly once.
  */
 class Input {
 public:
     Input();
     ~Input() = default;
 
+    void Poll();
     void Update();
 
     // Keyboard
@@ -21,6 +30,23 @@ public:
     // Mouse
     void GetMousePosition(int& x, int& y) const;
     bool IsMouseButtonDown(int button) const;
+
+private:
+    static constexpr int MAX_KEYS = 512;        // raylib's keyboard table size
+    static constexpr int MAX_BUTTONS = 8;
+
+    struct State {
+        std::bitset<MAX_KEYS> down;
+        std::bitset<MAX_KEYS> pressed;
+        std::bitset<MAX_KEYS> released;
+        std::bitset<MAX_BUTTONS> buttons;
+        int mouseX = 0;
+        int mouseY = 0;
+    };
+
+    State m_polled;         // Written by Poll, guarded by m_mutex
+    State m_current;        // Read by the queries
+    std::mutex m_mutex;
 };
 
 #endif // INPUT_H
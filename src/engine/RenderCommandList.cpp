@@ -0,0 +1,68 @@
+#include "RenderCommandList.h"
+#include <algorithm>
+#include <cstring>
+
+void RenderCommandList::Reset() {
+    m_clearColor = Color{ 0, 0, 0, 255 };
+    m_commands.clear();
+    m_quads.clear();
+    m_text.clear();
+}
+
+void RenderCommandList::AddQuads(RenderLayer layer, const RenderQuad* quads, std::size_t count) {
+    if (count == 0) return;
+    Command command{};
+    command.type = Type::QUADS;
+    command.layer = layer;
+    command.sequence = static_cast<std::uint32_t>(m_commands.size());
+    command.first = static_cast<std::uint32_t>(m_quads.size());
+    command.count = static_cast<std::uint32_t>(count);
+    m_quads.insert(m_quads.end(), quads, quads + count);
+    m_commands.push_back(command);
+}
+
+void RenderCommandList::AddText(RenderLayer layer, const char* text, int x, int y, int fontSize, Color color) {
+    Command command{};
+    command.type = Type::TEXT;
+    command.layer = layer;
+    command.sequence = static_cast<std::uint32_t>(m_commands.size());
+    command.first = static_cast<std::uint32_t>(m_text.size());
+    command.count = static_cast<std::uint32_t>(std::strlen(text));
+    command.x = x;
+    command.y = y;
+    command.fontSize = fontSize;
+    command.color = color;
+    m_text.append(text, command.count);
+    m_text.push_back('\0');
+    m_commands.push_back(command);
+}
+
+void RenderCommandList::AddTarget(Type type, RenderLayer layer, std::uint32_t target, int width, int height) {
+    Command command{};
+    command.type = type;
+    command.layer = layer;
+    command.sequence = static_cast<std::uint32_t>(m_commands.size());
+    command.target = target;
+    command.x = width;
+    command.y = height;
+    m_commands.push_back(command);
+}
+
+void RenderCommandList::AddTargetQuad(RenderLayer layer, std::uint32_t target, const RenderQuad& quad) {
+    Command command{};
+    command.type = Type::DRAW_TARGET;
+    command.layer = layer;
+    command.sequence = static_cast<std::uint32_t>(m_commands.size());
+    command.first = static_cast<std::uint32_t>(m_quads.size());
+    command.count = 1;
+    command.target = target;
+    m_quads.push_back(quad);
+    m_commands.push_back(command);
+}
+
+void RenderCommandList::Sort() {
+    std::sort(m_commands.begin(), m_commands.end(), [](const Command& a, const Command& b) {
+        if (a.layer != b.layer) return a.layer < b.layer;
+        return a.sequence < b.sequence;
+    });
+}
@@ -0,0 +1,73 @@
+#ifndef RENDERCOMMANDLIST_H
+#define RENDERCOMMANDLIST_H
+
+#include <raylib.h>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Draw order between groups of commands. Within a layer, commands keep
+// their submission order (later draws land on top).
+enum class RenderLayer : std::uint8_t { WORLD, ENTITIES, UI };
+
+// One textured quad in screen space. Texture id 0 means solid colour
+// (raylib's default white texture, resolved when the quad is drawn).
+struct RenderQuad {
+    unsigned int textureId;
+    float x, y, w, h;
+    float u0, v0, u1, v1;
+    Color color;
+};
+
+/**
+ * RenderCommandList - one frame of drawing, recorded instead of executed
+ *
+ * Holds everything the Renderer would have sent to raylib for a frame:
+ * the clear colour, runs of quads and text draws, each tagged with a layer.
+ * Render targets appear by handle only: begin/end brackets around the draws
+ * that fill one, a quad that draws one, and its destruction. The textures
+ * themselves are created on replay. Recording touches no GL state, so a list
+ * can be built on one thread and replayed on the thread that owns the
+ * window. Sort() puts commands in layer order before replay. Lists are
+ * reused frame to frame; Reset() keeps the allocations.
+ */
+class RenderCommandList {
+public:
+    enum class Type : std::uint8_t { QUADS, TEXT, BEGIN_TARGET, END_TARGET, DRAW_TARGET, DESTROY_TARGET };
+
+    struct Command {
+        Type type;
+        RenderLayer layer;
+        std::uint32_t sequence;     // Submission order, keeps the sort stable
+        std::uint32_t first;        // QUADS, DRAW_TARGET: first quad; TEXT: offset into the text pool
+        std::uint32_t count;        // QUADS, DRAW_TARGET: quad count; TEXT: length
+        std::uint32_t target;       // *_TARGET: render target handle
+        int x, y, fontSize;         // TEXT: position; BEGIN_TARGET: x, y are the target's size
+        Color color;                // TEXT only
+    };
+
+    RenderCommandList() = default;
+
+    void Reset();
+    void SetClearColor(Color color) { m_clearColor = color; }
+    void AddQuads(RenderLayer layer, const RenderQuad* quads, std::size_t count);
+    void AddText(RenderLayer layer, const char* text, int x, int y, int fontSize, Color color);
+    void AddTarget(Type type, RenderLayer layer, std::uint32_t target, int width = 0, int height = 0);
+    void AddTargetQuad(RenderLayer layer, std::uint32_t target, const RenderQuad& quad);
+    void Sort();
+
+    Color GetClearColor() const { return m_clearColor; }
+    const std::vector<Command>& GetCommands() const { return m_commands; }
+    const RenderQuad* GetQuads(const Command& command) const { return m_quads.data() + command.first; }
+    const char* GetText(const Command& command) const { return m_text.data() + command.first; }
+    int GetQuadCount() const { return static_cast<int>(m_quads.size()); }
+
+private:
+    Color m_clearColor = { 0, 0, 0, 255 };
+    std::vector<Command> m_commands;
+    std::vector<RenderQuad> m_quads;
+    std::string m_text;             // Null-terminated strings back to back
+};
+
+#endif // RENDERCOMMANDLIST_H
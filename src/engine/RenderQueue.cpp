@@ -0,0 +1,83 @@
+#include "RenderQueue.h"
+
+RenderCommandList* RenderQueue::BeginRecord() {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    if (m_recording >= 0) return &m_slots[m_recording].list;
+
+    int free = -1;
+    m_changed.wait(lock, [this, &free] {
+        if (m_closed) return true;
+        for (int i = 0; i < 2; ++i) {
+            if (m_slots[i].state == SlotState::FREE) {
+                free = i;
+                return true;
+            }
+        }
+        return false;
+    });
+    if (m_closed) return nullptr;
+
+    m_recording = free;
+    m_slots[free].state = SlotState::RECORDING;
+    m_slots[free].list.Reset();
+    return &m_slots[free].list;
+}
+
+void RenderQueue::Submit() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_recording < 0) return;
+        Slot& slot = m_slots[m_recording];
+        slot.state = SlotState::READY;
+        slot.frame = ++m_submitted;
+        m_recording = -1;
+    }
+    m_changed.notify_all();
+}
+
+const RenderCommandList* RenderQueue::AcquireFrame() {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    if (m_reading >= 0) return &m_slots[m_reading].list;
+
+    int ready = -1;
+    m_changed.wait(lock, [this, &ready] {
+        for (int i = 0; i < 2; ++i) {
+            if (m_slots[i].state != SlotState::READY) continue;
+            if (ready < 0 || m_slots[i].frame < m_slots[ready].frame) ready = i;
+        }
+        return ready >= 0 || m_closed;
+    });
+    if (ready < 0) return nullptr;
+
+    m_reading = ready;
+    m_slots[ready].state = SlotState::READING;
+    return &m_slots[ready].list;
+}
+
+void RenderQueue::ReleaseFrame() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_reading < 0) return;
+        m_slots[m_reading].state = SlotState::FREE;
+        m_reading = -1;
+    }
+    m_changed.notify_all();
+}
+
+void RenderQueue::Close() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_closed = true;
+    }
+    m_changed.notify_all();
+}
+
+bool RenderQueue::IsClosed() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_closed;
+}
+
+std::uint64_t RenderQueue::GetSubmittedCount() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_submitted;
+}
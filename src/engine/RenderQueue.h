@@ -0,0 +1,59 @@
+#ifndef RENDERQUEUE_H
+#define RENDERQUEUE_H
+
+#include "RenderCommandList.h"
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+
+/**
+ * RenderQueue - double-buffered hand-off of recorded frames
+ *
+ * The simulation thread records frame N+1 into one list while the render
+ * thread replays frame N from the other. BeginRecord() blocks while both
+ * lists are in use, so the simulation runs at most one frame ahead and
+ * never drops a frame. AcquireFrame() blocks until a frame is submitted
+ * and returns null once the queue is closed and every frame has been taken.
+ *
+ * One thread records, one thread replays.
+ */
+class RenderQueue {
+public:
+    RenderQueue() = default;
+
+    RenderQueue(const RenderQueue&) = delete;
+    RenderQueue& operator=(const RenderQueue&) = delete;
+
+    // Simulation side: a reset list to record into (null once closed), then hand it over
+    RenderCommandList* BeginRecord();
+    void Submit();
+
+    // Render side: the oldest submitted frame, then give its list back
+    const RenderCommandList* AcquireFrame();
+    void ReleaseFrame();
+
+    // Wakes both sides; frames already submitted can still be acquired
+    void Close();
+    bool IsClosed() const;
+
+    std::uint64_t GetSubmittedCount() const;
+
+private:
+    enum class SlotState { FREE, RECORDING, READY, READING };
+
+    struct Slot {
+        RenderCommandList list;
+        SlotState state = SlotState::FREE;
+        std::uint64_t frame = 0;
+    };
+
+    Slot m_slots[2];
+    int m_recording = -1;
+    int m_reading = -1;
+    std::uint64_t m_submitted = 0;
+    bool m_closed = false;
+    mutable std::mutex m_mutex;
+    std::condition_variable m_changed;
+};
+
+#endif // RENDERQUEUE_H
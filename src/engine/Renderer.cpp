@@ -1,6 +1,12 @@
 #include "Renderer.h"
 #include "Logger.h"
+#include <rlgl.h>
+#include <cmath>
 #include <iostream>
+#include <utility>
+
+RenderBackend Renderer::s_backend = RenderBackend::RAYLIB;
+unsigned int Renderer::s_nextHeadlessTexture = 1;
 
 Renderer::Renderer()
     : m_cameraX(0)
@@ -11,44 +17,326 @@ Renderer::Renderer()
 }
 
 Renderer::~Renderer() {
+    // Once the window is gone its GL objects went with it
+    if (IsHeadless() || !IsWindowReady()) return;
+    for (const auto& entry : m_targets) UnloadRenderTexture(entry.second);
 }
 
-bool Renderer::Initialize(int width, int height) {
+bool Renderer::Initialize(int width, int height, RenderBackend backend) {
     m_width = width;
     m_height = height;
+    s_backend = backend;
+    m_totals = RenderStats();
     return true;
 }
 
+Texture2D Renderer::CreateTexture(const Image& image) {
+    if (IsHeadless()) {
+        // Nothing to upload; the size is all that drawing code looks at
+        if (!image.data) return Texture2D{};
+        Texture2D texture{};
+        texture.id = s_nextHeadlessTexture++;
+        texture.width = image.width;
+        texture.height = image.height;
+        texture.mipmaps = 1;
+        texture.format = image.format;
+        return texture;
+    }
+    return LoadTextureFromImage(image);
+}
+
+void Renderer::DestroyTexture(Texture2D texture) {
+    if (texture.id == 0 || IsHeadless()) return;
+    UnloadTexture(texture);
+}
+
 void Renderer::Clear(unsigned char r, unsigned char g, unsigned char b) {
-    BeginDrawing();
-    ClearBackground(Color{r, g, b, 255});
+    m_quads.clear();
+    if (m_recording) {
+        m_recording->SetClearColor(Color{r, g, b, 255});
+        for (std::uint32_t target : m_destroyedTargets) {
+            m_recording->AddTarget(RenderCommandList::Type::DESTROY_TARGET, m_layer, target);
+        }
+        m_destroyedTargets.clear();
+        return;
+    }
+    for (std::uint32_t target : m_destroyedTargets) EmitDestroyTarget(target);
+    m_destroyedTargets.clear();
+    BeginFrame(Color{r, g, b, 255});
 }
 
 void Renderer::Present() {
+    Flush();
+    if (m_recording) return;
+    EndFrame();
+}
+
+void Renderer::BeginFrame(Color clearColor) {
+    m_frameQuads = 0;
+    m_frameBatches = 0;
+    m_frameTexts = 0;
+    m_batchOpen = false;
+    if (IsHeadless()) return;
+    BeginDrawing();
+    ClearBackground(clearColor);
+}
+
+void Renderer::EndFrame() {
+    m_totals.frames++;
+    m_totals.quads += m_frameQuads;
+    m_totals.batches += m_frameBatches;
+    m_totals.textDraws += m_frameTexts;
+    if (IsHeadless()) return;
     EndDrawing();
 }
 
 void Renderer::DrawRect(int x, int y, int w, int h, unsigned char r, unsigned char g, unsigned char b, unsigned char a) {
-    DrawRectangleLines(x - m_cameraX, y - m_cameraY, w, h, Color{r, g, b, a});
+    // Outline as four one-pixel quads
+    Color color{r, g, b, a};
+    float fx = static_cast<float>(x);
+    float fy = static_cast<float>(y);
+    float fw = static_cast<float>(w);
+    float fh = static_cast<float>(h);
+    DrawSolidQuad(fx, fy, fw, 1.0f, color);
+    DrawSolidQuad(fx, fy + fh - 1.0f, fw, 1.0f, color);
+    DrawSolidQuad(fx, fy + 1.0f, 1.0f, fh - 2.0f, color);
+    DrawSolidQuad(fx + fw - 1.0f, fy + 1.0f, 1.0f, fh - 2.0f, color);
 }
 
 void Renderer::FillRect(int x, int y, int w, int h, unsigned char r, unsigned char g, unsigned char b, unsigned char a) {
-    DrawRectangle(x - m_cameraX, y - m_cameraY, w, h, Color{r, g, b, a});
+    DrawSolidQuad(static_cast<float>(x), static_cast<float>(y), static_cast<float>(w), static_cast<float>(h),
+                  Color{r, g, b, a});
 }
 
 void Renderer::DrawTextureRect(Texture2D texture, int x, int y) {
-    if (texture.id == 0) return;
-    DrawTexture(texture, x - m_cameraX, y - m_cameraY, WHITE);
+    Rectangle src = { 0.0f, 0.0f, static_cast<float>(texture.width), static_cast<float>(texture.height) };
+    Rectangle dst = { static_cast<float>(x), static_cast<float>(y), src.width, src.height };
+    DrawQuad(texture, src, dst, WHITE);
 }
 
 void Renderer::DrawTextureRect(Texture2D texture, const Rectangle* srcRect, const Rectangle* dstRect) {
-    if (texture.id == 0) return;
-    Rectangle adjustedDst = *dstRect;
-    adjustedDst.x -= m_cameraX;
-    adjustedDst.y -= m_cameraY;
-    DrawTexturePro(texture, *srcRect, adjustedDst, Vector2{0, 0}, 0.0f, WHITE);
+    DrawQuad(texture, *srcRect, *dstRect, WHITE);
 }
 
 void Renderer::DrawGameText(const char* text, int x, int y, int fontSize, unsigned char r, unsigned char g, unsigned char b, unsigned char a) {
-    DrawText(text, x, y, fontSize, Color{r, g, b, a});
+    Flush();   // Text goes through raylib directly; keep it above what was queued before it
+    if (m_recording) {
+        m_recording->AddText(m_layer, text, x, y, fontSize, Color{r, g, b, a});
+        return;
+    }
+    EmitText(text, x, y, fontSize, Color{r, g, b, a});
+}
+
+void Renderer::EmitText(const char* text, int x, int y, int fontSize, Color color) {
+    if (m_discarding) return;
+    m_frameTexts++;
+    m_batchOpen = false;
+    if (IsHeadless()) return;
+    DrawText(text, x, y, fontSize, color);
+}
+
+void Renderer::DrawQuad(const Texture2D& texture, const Rectangle& srcRect, const Rectangle& dstRect, Color tint) {
+    if (texture.id == 0 || texture.width <= 0 || texture.height <= 0) return;
+    if (dstRect.width <= 0.0f || dstRect.height <= 0.0f) return;
+
+    // Same convention as DrawTexturePro: a negative source size flips that axis
+    float width = std::fabs(srcRect.width);
+    float height = std::fabs(srcRect.height);
+    float u0 = srcRect.x / texture.width;
+    float v0 = srcRect.y / texture.height;
+    float u1 = (srcRect.x + width) / texture.width;
+    float v1 = (srcRect.y + height) / texture.height;
+    if (srcRect.width < 0.0f) std::swap(u0, u1);
+    if (srcRect.height < 0.0f) std::swap(v0, v1);
+
+    m_quads.push_back(RenderQuad{ texture.id,
+                                  dstRect.x - m_cameraX, dstRect.y - m_cameraY, dstRect.width, dstRect.height,
+                                  u0, v0, u1, v1, tint });
+}
+
+void Renderer::DrawSolidQuad(float x, float y, float w, float h, Color color) {
+    if (w <= 0.0f || h <= 0.0f) return;
+    // Texture id 0 never belongs to a real texture; EmitQuads swaps in raylib's white one
+    m_quads.push_back(RenderQuad{ 0,
+                                  x - m_cameraX, y - m_cameraY, w, h,
+                                  0.0f, 0.0f, 1.0f, 1.0f, color });
+}
+
+void Renderer::Flush() {
+    if (m_recording) {
+        m_recording->AddQuads(m_layer, m_quads.data(), m_quads.size());
+    } else {
+        EmitQuads(m_quads.data(), m_quads.size());
+    }
+    m_quads.clear();
+}
+
+void Renderer::EmitQuads(const RenderQuad* quads, std::size_t count) {
+    if (m_discarding) return;
+    std::size_t start = 0;
+    while (start < count) {
+        unsigned int textureId = quads[start].textureId;
+        std::size_t end = start;
+        while (end < count && quads[end].textureId == textureId) ++end;
+        if (!m_batchOpen || textureId != m_lastTexture) m_frameBatches++;
+        m_batchOpen = true;
+        m_lastTexture = textureId;
+        if (IsHeadless()) {
+            start = end;
+            continue;
+        }
+
+        // One rlgl batch for the whole run
+        rlSetTexture(textureId != 0 ? textureId : rlGetTextureIdDefault());
+        rlBegin(RL_QUADS);
+        for (std::size_t i = start; i < end; ++i) {
+            const RenderQuad& quad = quads[i];
+            rlColor4ub(quad.color.r, quad.color.g, quad.color.b, quad.color.a);
+            rlNormal3f(0.0f, 0.0f, 1.0f);
+            rlTexCoord2f(quad.u0, quad.v0);
+            rlVertex2f(quad.x, quad.y);
+            rlTexCoord2f(quad.u0, quad.v1);
+            rlVertex2f(quad.x, quad.y + quad.h);
+            rlTexCoord2f(quad.u1, quad.v1);
+            rlVertex2f(quad.x + quad.w, quad.y + quad.h);
+            rlTexCoord2f(quad.u1, quad.v0);
+            rlVertex2f(quad.x + quad.w, quad.y);
+        }
+        rlEnd();
+        rlSetTexture(0);
+        start = end;
+    }
+    m_frameQuads += static_cast<int>(count);
+}
+
+void Renderer::BeginRecording(RenderCommandList* list) {
+    m_quads.clear();
+    m_recording = list;
+    m_layer = RenderLayer::WORLD;
+}
+
+void Renderer::EndRecording() {
+    if (!m_recording) return;
+    Flush();
+    m_recording->Sort();
+    m_recording = nullptr;
+}
+
+void Renderer::SetLayer(RenderLayer layer) {
+    if (layer == m_layer) return;
+    Flush();   // Queued quads belong to the old layer
+    m_layer = layer;
+}
+
+void Renderer::Replay(const RenderCommandList& list) {
+    BeginFrame(list.GetClearColor());
+    for (const RenderCommandList::Command& command : list.GetCommands()) {
+        switch (command.type) {
+            case RenderCommandList::Type::QUADS:
+                EmitQuads(list.GetQuads(command), command.count);
+                break;
+            case RenderCommandList::Type::TEXT:
+                EmitText(list.GetText(command), command.x, command.y, command.fontSize, command.color);
+                break;
+            case RenderCommandList::Type::BEGIN_TARGET:
+                EmitBeginTarget(command.target, command.x, command.y);
+                break;
+            case RenderCommandList::Type::END_TARGET:
+                EmitEndTarget();
+                break;
+            case RenderCommandList::Type::DRAW_TARGET:
+                EmitTargetQuad(command.target, *list.GetQuads(command));
+                break;
+            case RenderCommandList::Type::DESTROY_TARGET:
+                EmitDestroyTarget(command.target);
+                break;
+        }
+    }
+    EndFrame();
+}
+
+void Renderer::BeginTarget(std::uint32_t target, int width, int height) {
+    Flush();   // Quads queued for the screen must not land in the target
+    if (m_recording) {
+        m_recording->AddTarget(RenderCommandList::Type::BEGIN_TARGET, m_layer, target, width, height);
+        return;
+    }
+    EmitBeginTarget(target, width, height);
+}
+
+void Renderer::EndTarget() {
+    Flush();
+    if (m_recording) {
+        m_recording->AddTarget(RenderCommandList::Type::END_TARGET, m_layer, 0);
+        return;
+    }
+    EmitEndTarget();
+}
+
+void Renderer::DrawTarget(std::uint32_t target, const Rectangle& dstRect) {
+    // Render textures come out upside down; swapping v flips them back
+    RenderQuad quad{ 0,
+                     dstRect.x - m_cameraX, dstRect.y - m_cameraY, dstRect.width, dstRect.height,
+                     0.0f, 1.0f, 1.0f, 0.0f, WHITE };
+    if (m_recording) {
+        Flush();   // The texture id is only known on replay, so this quad cannot join a run
+        m_recording->AddTargetQuad(m_layer, target, quad);
+        return;
+    }
+    auto it = m_targets.find(target);
+    if (it == m_targets.end()) return;
+    quad.textureId = it->second.texture.id;
+    m_quads.push_back(quad);
+}
+
+void Renderer::DestroyTarget(std::uint32_t target) {
+    m_destroyedTargets.push_back(target);
+}
+
+void Renderer::EmitBeginTarget(std::uint32_t target, int width, int height) {
+    m_batchOpen = false;
+    RenderTexture2D& texture = m_targets[target];
+    if (texture.id == 0) {
+        if (IsHeadless()) {
+            texture.id = s_nextHeadlessTexture++;
+            texture.texture.id = s_nextHeadlessTexture++;
+            texture.texture.width = width;
+            texture.texture.height = height;
+        } else {
+            texture = LoadRenderTexture(width, height);
+        }
+    }
+    if (texture.id == 0) {
+        m_targets.erase(target);
+        m_discarding = true;
+        return;
+    }
+    if (IsHeadless()) return;
+    BeginTextureMode(texture);
+    ClearBackground(BLANK);
+}
+
+void Renderer::EmitEndTarget() {
+    m_batchOpen = false;
+    if (m_discarding) {
+        m_discarding = false;
+        return;
+    }
+    if (IsHeadless()) return;
+    EndTextureMode();
+}
+
+void Renderer::EmitTargetQuad(std::uint32_t target, const RenderQuad& quad) {
+    auto it = m_targets.find(target);
+    if (it == m_targets.end()) return;
+    RenderQuad resolved = quad;
+    resolved.textureId = it->second.texture.id;
+    EmitQuads(&resolved, 1);
+}
+
+void Renderer::EmitDestroyTarget(std::uint32_t target) {
+    auto it = m_targets.find(target);
+    if (it == m_targets.end()) return;
+    if (!IsHeadless() && IsWindowReady()) UnloadRenderTexture(it->second);
+    m_targets.erase(it);
 }
@@ -1,18 +1,62 @@
 #ifndef RENDERER_H
 #define RENDERER_H
 
+#include "RenderCommandList.h"
 #include <raylib.h>
+#include <cstdint>
 #include <string>
+#include <unordered_map>
+#include <vector>
+
+// Where frames go. HEADLESS draws nothing and only counts, so the game loop
+// can run (and be profiled) on a machine without a display.
+enum class RenderBackend { RAYLIB, HEADLESS };
+
+// Running totals since Initialize
+struct RenderStats {
+    std::uint64_t frames = 0;
+    std::uint64_t quads = 0;
+    std::uint64_t batches = 0;      // One texture bind each
+    std::uint64_t textDraws = 0;
+};
 
 /**
  * Rendering system for 2D graphics
+ *
+ * Rect and texture draws are not sent to raylib one by one. They are queued
+ * as quads and flushed through rlgl, one batch per run of quads that share a
+ * texture (solid rects share raylib's default white texture), so a frame
+ * costs a draw call per texture switch rather than per quad. Quads keep
+ * their submission order. Text still goes straight to raylib, so it flushes
+ * the queue first; so must anyone who draws around the Renderer (e.g. before
+ * switching render targets).
+ *
+ * Between BeginRecording() and EndRecording() nothing reaches raylib: the
+ * same calls append to a RenderCommandList, tagged with the current layer,
+ * and Replay() later draws that list on the thread that owns the window.
+ * Frame statistics belong to whoever draws, so they move with Replay().
+ * Layers only matter to recorded frames; immediate drawing is in call order.
+ *
+ * Render targets (off-screen textures the caller draws into once and then
+ * draws from) are named by handles from CreateTarget(). Their textures
+ * belong to whoever draws: created by the first BeginTarget that reaches
+ * raylib, which when recording means during Replay on the window's thread.
+ * DestroyTarget takes effect at the next Clear, so it is safe to call
+ * between frames from the recording thread.
+ *
+ * The backend is process-wide, as there is at most one window. Textures are
+ * created and destroyed through the static helpers so that headless runs
+ * get placeholder ids of the right size without touching the GPU.
  */
 class Renderer {
 public:
     Renderer();
     ~Renderer();
 
-    bool Initialize(int width, int height);
+    bool Initialize(int width, int height, RenderBackend backend = RenderBackend::RAYLIB);
+    static bool IsHeadless() { return s_backend == RenderBackend::HEADLESS; }
+    static Texture2D CreateTexture(const Image& image);
+    static void DestroyTexture(Texture2D texture);
     void Clear(unsigned char r = 0, unsigned char g = 0, unsigned char b = 0);
     void Present();
 
@@ -23,12 +67,79 @@ public:
     void DrawTextureRect(Texture2D texture, const Rectangle* srcRect, const Rectangle* dstRect);
     void DrawGameText(const char* text, int x, int y, int fontSize, unsigned char r, unsigned char g, unsigned char b, unsigned char a = 255);
 
+    // Batching: queue a quad (world space, camera applied), and send the queue to raylib
+    void DrawQuad(const Texture2D& texture, const Rectangle& srcRect, const Rectangle& dstRect, Color tint);
+    void DrawSolidQuad(float x, float y, float w, float h, Color color);
+    void Flush();
+
+    // Recording: draws go into the list instead of raylib until EndRecording (which sorts it)
+    void BeginRecording(RenderCommandList* list);
+    void EndRecording();
+    bool IsRecording() const { return m_recording != nullptr; }
+    void SetLayer(RenderLayer layer);
+    // Draws a recorded frame from Clear to Present; call on the window's thread
+    void Replay(const RenderCommandList& list);
+
+    // Render targets: draws between BeginTarget and EndTarget fill the target (cleared first)
+    std::uint32_t CreateTarget() { return m_nextTarget++; }
+    void BeginTarget(std::uint32_t target, int width, int height);
+    void EndTarget();
+    void DrawTarget(std::uint32_t target, const Rectangle& dstRect);   // World space, right side up
+    void DestroyTarget(std::uint32_t target);
+    int GetTargetCount() const { return static_cast<int>(m_targets.size()); }
+
+    // Batch statistics for the current frame (reset by Clear)
+    int GetFrameQuadCount() const { return m_frameQuads; }
+    int GetFrameBatchCount() const { return m_frameBatches; }
+    int GetPendingQuadCount() const { return static_cast<int>(m_quads.size()); }
+    int GetFrameTextCount() const { return m_frameTexts; }
+    const RenderStats& GetTotals() const { return m_totals; }
+
+    // How far between the last two simulation ticks this frame shows (1 = latest state)
+    void SetInterpolation(float alpha) { m_interpolation = alpha; }
+    float GetInterpolation() const { return m_interpolation; }
+
     void SetCamera(int x, int y) { m_cameraX = x; m_cameraY = y; }
     void GetCamera(int& x, int& y) const { x = m_cameraX; y = m_cameraY; }
 
+    int GetWidth() const { return m_width; }
+    int GetHeight() const { return m_height; }
+
+    // True if the world-space rectangle overlaps the camera view
+    bool IsVisible(float x, float y, float w, float h) const {
+        return x < m_cameraX + m_width && x + w > m_cameraX &&
+               y < m_cameraY + m_height && y + h > m_cameraY;
+    }
+
 private:
     int m_cameraX, m_cameraY;
     int m_width, m_height;
+    float m_interpolation = 1.0f;
+    std::vector<RenderQuad> m_quads;    // Queued since the last flush, in submission order
+    RenderCommandList* m_recording = nullptr;
+    RenderLayer m_layer = RenderLayer::WORLD;
+    unsigned int m_lastTexture = 0;     // Texture of the open batch, if any
+    bool m_batchOpen = false;           // Closed by text and by a new frame
+    int m_frameQuads = 0;
+    int m_frameBatches = 0;
+    int m_frameTexts = 0;
+    RenderStats m_totals;
+    std::uint32_t m_nextTarget = 1;                                 // Handle 0 is never a target
+    std::vector<std::uint32_t> m_destroyedTargets;                  // Recording side, until the next Clear
+    std::unordered_map<std::uint32_t, RenderTexture2D> m_targets;   // Drawing side
+    bool m_discarding = false;          // Inside a target whose texture could not be created
+
+    void BeginFrame(Color clearColor);
+    void EndFrame();
+    void EmitQuads(const RenderQuad* quads, std::size_t count);
+    void EmitText(const char* text, int x, int y, int fontSize, Color color);
+    void EmitBeginTarget(std::uint32_t target, int width, int height);
+    void EmitEndTarget();
+    void EmitTargetQuad(std::uint32_t target, const RenderQuad& quad);
+    void EmitDestroyTarget(std::uint32_t target);
+
+    static RenderBackend s_backend;
+    static unsigned int s_nextHeadlessTexture;
 };
 
 #endif // RENDERER_H
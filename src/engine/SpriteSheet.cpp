@@ -16,6 +16,11 @@
 
 SpriteSheet::SpriteSheet()
     : m_texture{}
+    , m_image{}
+    , m_ownsTexture(true)
+    , m_generated(false)
+    , m_atlasX(0)
+    , m_atlasY(0)
     , m_tileWidth(0)
     , m_tileHeight(0)
     , m_columns(0)
@@ -26,9 +31,13 @@ SpriteSheet::SpriteSheet()
 }
 
 SpriteSheet::~SpriteSheet() {
-    if (m_texture.id != 0) {
-        UnloadTexture(m_texture);
-        m_texture.id = 0;
+    if (m_texture.id != 0 && m_ownsTexture) {
+        Renderer::DestroyTexture(m_texture);
+    }
+    m_texture.id = 0;
+    if (m_image.data) {
+        UnloadImage(m_image);
+        m_image.data = nullptr;
     }
 }
 
@@ -40,21 +49,11 @@ bool SpriteSheet::Load(Renderer* /*renderer*/, const std::string& filepath, int
         return false;
     }
 
-    m_sheetWidth = image.width;
-    m_sheetHeight = image.height;
-    m_tileWidth = tileWidth;
-    m_tileHeight = tileHeight;
-    m_columns = m_sheetWidth / m_tileWidth;
-    m_rows = m_sheetHeight / m_tileHeight;
-
-    // Create texture from image
-    m_texture = LoadTextureFromImage(image);
-    UnloadImage(image);
-
-    if (m_texture.id == 0) {
+    if (!LoadFromImage(image, tileWidth, tileHeight)) {
         Logger::Instance().Error("Failed to create texture from " + filepath);
         return false;
     }
+    m_generated = false;
 
     Logger::Instance().Info("Loaded sprite sheet: " + filepath);
     Logger::Instance().Info("  Size: " + std::to_string(m_sheetWidth) + "x" + std::to_string(m_sheetHeight));
@@ -64,6 +63,26 @@ bool SpriteSheet::Load(Renderer* /*renderer*/, const std::string& filepath, int
     return true;
 }
 
+bool SpriteSheet::LoadFromImage(Image image, int tileWidth, int tileHeight) {
+    if (image.data == nullptr || tileWidth <= 0 || tileHeight <= 0) {
+        if (image.data) UnloadImage(image);
+        return false;
+    }
+
+    m_sheetWidth = image.width;
+    m_sheetHeight = image.height;
+    m_tileWidth = tileWidth;
+    m_tileHeight = tileHeight;
+    m_columns = m_sheetWidth / m_tileWidth;
+    m_rows = m_sheetHeight / m_tileHeight;
+
+    // Create texture from image; the pixels stay around for atlas packing
+    m_texture = Renderer::CreateTexture(image);
+    m_image = image;
+    m_generated = true;
+    return m_texture.id != 0;
+}
+
 void SpriteSheet::RenderTile(Renderer* renderer, int tileId, int x, int y, bool flipH, bool flipV) {
     RenderTile(renderer, tileId, x, y, m_tileWidth, m_tileHeight, flipH, flipV);
 }
@@ -78,17 +97,28 @@ void SpriteSheet::RenderTile(Renderer* renderer, int tileId, int x, int y, int w
     if (flipH) srcRect.width = -srcRect.width;
     if (flipV) srcRect.height = -srcRect.height;
 
-    int camX, camY;
-    renderer->GetCamera(camX, camY);
-
     Rectangle dstRect = { 
-        static_cast<float>(x - camX), 
-        static_cast<float>(y - camY), 
+        static_cast<float>(x), 
+        static_cast<float>(y), 
         static_cast<float>(width), 
         static_cast<float>(height) 
     };
 
-    DrawTexturePro(m_texture, srcRect, dstRect, Vector2{0, 0}, 0.0f, WHITE);
+    renderer->DrawTextureRect(m_texture, &srcRect, &dstRect);
+}
+
+void SpriteSheet::UseAtlasPage(Texture2D page, int offsetX, int offsetY) {
+    if (m_texture.id != 0 && m_ownsTexture) {
+        Renderer::DestroyTexture(m_texture);
+    }
+    m_texture = page;
+    m_ownsTexture = false;
+    m_atlasX = offsetX;
+    m_atlasY = offsetY;
+    if (m_image.data) {
+        UnloadImage(m_image);
+        m_image.data = nullptr;
+    }
 }
 
 void SpriteSheet::CalculateSourceRect(int tileId, Rectangle& srcRect) {
@@ -99,8 +129,8 @@ void SpriteSheet::CalculateSourceRect(int tileId, Rectangle& srcRect) {
     int col = tileId % m_columns;
     int row = tileId / m_columns;
     
-    srcRect.x = static_cast<float>(col * m_tileWidth);
-    srcRect.y = static_cast<float>(row * m_tileHeight);
+    srcRect.x = static_cast<float>(m_atlasX + col * m_tileWidth);
+    srcRect.y = static_cast<float>(m_atlasY + row * m_tileHeight);
     srcRect.width = static_cast<float>(m_tileWidth);
     srcRect.height = static_cast<float>(m_tileHeight);
 }
@@ -137,6 +167,22 @@ SpriteSheet* SpriteSheetManager::LoadSpriteSheet(Renderer* renderer, const std::
     }
 }
 
+SpriteSheet* SpriteSheetManager::AddSpriteSheet(const std::string& name, Image image, int tileWidth, int tileHeight) {
+    if (GetSpriteSheet(name)) {
+        UnloadImage(image);
+        return GetSpriteSheet(name);
+    }
+
+    SpriteSheet* sheet = new SpriteSheet();
+    if (!sheet->LoadFromImage(image, tileWidth, tileHeight)) {
+        Logger::Instance().Error("Failed to create sprite sheet " + name);
+        delete sheet;
+        return nullptr;
+    }
+    m_sheets[name] = sheet;
+    return sheet;
+}
+
 SpriteSheet* SpriteSheetManager::GetSpriteSheet(const std::string& name) {
     auto it = m_sheets.find(name);
     return (it != m_sheets.end()) ? it->second : nullptr;
@@ -170,6 +216,35 @@ void SpriteSheetManager::LoadDefaultAssets(Renderer* renderer) {
     Logger::Instance().Info("=== Sprite Sheets Loaded ===");
 }
 
+int SpriteSheetManager::BuildAtlas() {
+    // Packed once; sheets loaded afterwards keep their own texture
+    if (m_atlas.GetPageCount() > 0) return m_atlas.GetPageCount();
+
+    // Sorted by name so the layout is the same every run
+    std::vector<std::string> names;
+    for (const auto& pair : m_sheets) {
+        if (!pair.second->IsOnAtlas() && pair.second->GetImage().data) names.push_back(pair.first);
+    }
+    std::sort(names.begin(), names.end());
+    if (names.empty()) return m_atlas.GetPageCount();
+
+    std::vector<Image> images;
+    for (const std::string& name : names) {
+        images.push_back(m_sheets[name]->GetImage());
+    }
+    if (!m_atlas.Build(images)) return 0;
+
+    for (size_t i = 0; i < names.size(); ++i) {
+        const AtlasEntry& entry = m_atlas.GetEntry(static_cast<int>(i));
+        if (entry.page < 0) {
+            Logger::Instance().Warn("Sprite sheet " + names[i] + " is too large for the atlas; drawn on its own");
+            continue;
+        }
+        m_sheets[names[i]]->UseAtlasPage(m_atlas.GetPage(entry.page), entry.x, entry.y);
+    }
+    return m_atlas.GetPageCount();
+}
+
 bool SpriteSheetManager::CheckAndLoadRootPngs(Renderer* renderer) {
     // Common tileset filenames to check in root directory
     std::vector<std::string> tilesetNames = {
@@ -251,4 +326,5 @@ void SpriteSheetManager::Clear() {
         delete pair.second;
     }
     m_sheets.clear();
+    m_atlas.Clear();
 }
\ No newline at end of file
@@ -1,6 +1,7 @@
 #ifndef SPRITESHEET_H
 #define SPRITESHEET_H
 
+#include "TextureAtlas.h"
 #include <raylib.h>
 #include <string>
 #include <unordered_map>
@@ -10,6 +11,9 @@ class Renderer;
 /**
  * SpriteSheet - Manages tileset/sprite sheet loading and rendering
  * Supports both world tilesets and character sprite sheets
+ *
+ * A sheet keeps its pixels after loading until it is moved onto an atlas
+ * page; from then on it draws from the shared page at its packed offset.
  */
 class SpriteSheet {
 public:
@@ -18,6 +22,8 @@ public:
 
     // Load a sprite sheet from file
     bool Load(Renderer* renderer, const std::string& filepath, int tileWidth, int tileHeight);
+    // Use pixels made in memory; the sheet takes ownership of the image
+    bool LoadFromImage(Image image, int tileWidth, int tileHeight);
     
     // Render a specific tile/sprite from the sheet
     void RenderTile(Renderer* renderer, int tileId, int x, int y, bool flipH = false, bool flipV = false);
@@ -32,9 +38,21 @@ public:
     
     // Check if loaded
     bool IsLoaded() const { return m_texture.id != 0; }
+    // True for sheets made in memory rather than loaded from a file
+    bool IsGenerated() const { return m_generated; }
+
+    // Atlas support: the CPU copy to pack, and switching over to a packed page
+    const Image& GetImage() const { return m_image; }
+    void UseAtlasPage(Texture2D page, int offsetX, int offsetY);
+    bool IsOnAtlas() const { return !m_ownsTexture && m_texture.id != 0; }
+    Texture2D GetTexture() const { return m_texture; }
 
 private:
     Texture2D m_texture;
+    Image m_image;              // Kept until the sheet is packed
+    bool m_ownsTexture;         // False once drawing from an atlas page
+    bool m_generated;
+    int m_atlasX, m_atlasY;
     int m_tileWidth, m_tileHeight;
     int m_columns, m_rows;
     int m_sheetWidth, m_sheetHeight;
@@ -54,11 +72,18 @@ public:
     SpriteSheet* LoadSpriteSheet(Renderer* renderer, const std::string& name, 
                                  const std::string& filepath, int tileWidth, int tileHeight);
     
+    // Cache a sheet made in memory (takes ownership of the image)
+    SpriteSheet* AddSpriteSheet(const std::string& name, Image image, int tileWidth, int tileHeight);
+    
     // Get a cached sprite sheet
     SpriteSheet* GetSpriteSheet(const std::string& name);
     
     // Preload common sprite sheets
     void LoadDefaultAssets(Renderer* renderer);
+
+    // Pack every loaded sheet onto shared atlas pages (once); returns the page count
+    int BuildAtlas();
+    const TextureAtlas& GetAtlas() const { return m_atlas; }
     
     // Cleanup
     void Clear();
@@ -71,6 +96,7 @@ private:
     bool CheckAndLoadRootPngs(Renderer* renderer);
     
     std::unordered_map<std::string, SpriteSheet*> m_sheets;
+    TextureAtlas m_atlas;
 };
 
 #endif // SPRITESHEET_H
\ No newline at end of file
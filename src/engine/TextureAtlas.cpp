@@ -0,0 +1,119 @@
+#include "TextureAtlas.h"
+#include "Logger.h"
+#include "Renderer.h"
+#include <algorithm>
+#include <string>
+
+namespace {
+
+// Shelf-packs the listed images onto a size x size page, in order.
+// Places what fits (writing entries) and returns the indices that did not.
+std::vector<int> PlaceOnPage(const std::vector<int>& order, const std::vector<AtlasEntry>& sizes, int size,
+                             int page, std::vector<AtlasEntry>& entries) {
+    std::vector<int> rest;
+    int shelfX = 0;
+    int shelfY = 0;
+    int shelfHeight = 0;
+    for (int index : order) {
+        int width = sizes[index].width + TextureAtlas::PADDING;
+        int height = sizes[index].height + TextureAtlas::PADDING;
+        if (shelfX + width > size) {
+            shelfY += shelfHeight;
+            shelfX = 0;
+            shelfHeight = 0;
+        }
+        if (width > size || shelfY + height > size) {
+            rest.push_back(index);
+            continue;
+        }
+        entries[index] = AtlasEntry{ page, shelfX, shelfY, sizes[index].width, sizes[index].height };
+        shelfX += width;
+        shelfHeight = std::max(shelfHeight, height);
+    }
+    return rest;
+}
+
+} // namespace
+
+TextureAtlas::~TextureAtlas() {
+    Clear();
+}
+
+int TextureAtlas::Pack(const std::vector<AtlasEntry>& sizes, int maxPageSize,
+                       std::vector<AtlasEntry>& entries, std::vector<int>& pageSizes) {
+    entries.assign(sizes.size(), AtlasEntry{});
+    pageSizes.clear();
+
+    // Tallest first keeps shelves tight; anything bigger than a page is left out
+    std::vector<int> order;
+    for (int i = 0; i < static_cast<int>(sizes.size()); ++i) {
+        if (sizes[i].width + PADDING <= maxPageSize && sizes[i].height + PADDING <= maxPageSize &&
+            sizes[i].width > 0 && sizes[i].height > 0) {
+            order.push_back(i);
+        }
+    }
+    std::stable_sort(order.begin(), order.end(), [&sizes](int a, int b) {
+        return sizes[a].height > sizes[b].height;
+    });
+
+    while (!order.empty()) {
+        int page = static_cast<int>(pageSizes.size());
+        // Smallest page that takes everything left, else a full page and carry on
+        int size = std::min(MIN_PAGE_SIZE, maxPageSize);
+        std::vector<int> rest;
+        for (;;) {
+            std::vector<AtlasEntry> trial = entries;
+            rest = PlaceOnPage(order, sizes, size, page, trial);
+            if (rest.empty() || size >= maxPageSize) {
+                entries.swap(trial);
+                break;
+            }
+            size = std::min(size * 2, maxPageSize);
+        }
+        pageSizes.push_back(size);
+        order.swap(rest);
+    }
+    return static_cast<int>(pageSizes.size());
+}
+
+bool TextureAtlas::Build(const std::vector<Image>& images, int maxPageSize) {
+    Clear();
+
+    std::vector<AtlasEntry> sizes(images.size());
+    for (size_t i = 0; i < images.size(); ++i) {
+        sizes[i].width = images[i].data ? images[i].width : 0;
+        sizes[i].height = images[i].data ? images[i].height : 0;
+    }
+    std::vector<int> pageSizes;
+    int pageCount = Pack(sizes, maxPageSize, m_entries, pageSizes);
+
+    for (int page = 0; page < pageCount; ++page) {
+        Image canvas = GenImageColor(pageSizes[page], pageSizes[page], BLANK);
+        for (size_t i = 0; i < images.size(); ++i) {
+            const AtlasEntry& entry = m_entries[i];
+            if (entry.page != page) continue;
+            Rectangle src = { 0.0f, 0.0f, static_cast<float>(entry.width), static_cast<float>(entry.height) };
+            Rectangle dst = { static_cast<float>(entry.x), static_cast<float>(entry.y), src.width, src.height };
+            ImageDraw(&canvas, images[i], src, dst, WHITE);
+        }
+        Texture2D texture = Renderer::CreateTexture(canvas);
+        UnloadImage(canvas);
+        if (texture.id == 0) {
+            Logger::Instance().Error("Failed to create atlas page " + std::to_string(page));
+            Clear();
+            return false;
+        }
+        m_pages.push_back(texture);
+        Logger::Instance().Info("Atlas page " + std::to_string(page) + ": " +
+                                std::to_string(pageSizes[page]) + "x" + std::to_string(pageSizes[page]));
+    }
+    return true;
+}
+
+void TextureAtlas::Clear() {
+    for (const Texture2D& page : m_pages) {
+        Renderer::DestroyTexture(page);
+    }
+    m_pages.clear();
+    m_entries.clear();
+}
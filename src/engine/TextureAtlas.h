@@ -0,0 +1,52 @@
+#ifndef TEXTUREATLAS_H
+#define TEXTUREATLAS_H
+
+#include <raylib.h>
+#include <vector>
+
+// Where one packed image landed. page is -1 if it was too big for any page.
+struct AtlasEntry {
+    int page = -1;
+    int x = 0, y = 0;
+    int width = 0, height = 0;
+};
+
+/**
+ * TextureAtlas - packs several images onto a few shared texture pages
+ *
+ * Images are placed whole with a shelf packer (tallest first), each page
+ * sized to the smallest power of two that holds what is put on it, up to
+ * MAX_PAGE_SIZE. Drawing everything from one page lets the Renderer batch
+ * across what used to be separate sheets.
+ */
+class TextureAtlas {
+public:
+    static constexpr int MIN_PAGE_SIZE = 256;
+    static constexpr int MAX_PAGE_SIZE = 2048;
+    static constexpr int PADDING = 2;       // Transparent gap between images
+
+    TextureAtlas() = default;
+    ~TextureAtlas();
+
+    TextureAtlas(const TextureAtlas&) = delete;
+    TextureAtlas& operator=(const TextureAtlas&) = delete;
+
+    // Layout only: one entry per (width, height) size and the size of each page.
+    // Returns the number of pages used.
+    static int Pack(const std::vector<AtlasEntry>& sizes, int maxPageSize,
+                    std::vector<AtlasEntry>& entries, std::vector<int>& pageSizes);
+
+    // Packs the images and uploads one texture per page (images are not freed)
+    bool Build(const std::vector<Image>& images, int maxPageSize = MAX_PAGE_SIZE);
+    void Clear();
+
+    int GetPageCount() const { return static_cast<int>(m_pages.size()); }
+    Texture2D GetPage(int page) const { return m_pages[page]; }
+    const AtlasEntry& GetEntry(int index) const { return m_entries[index]; }
+
+private:
+    std::vector<Texture2D> m_pages;
+    std::vector<AtlasEntry> m_entries;
+};
+
+#endif // TEXTUREATLAS_H
@@ -19,6 +19,7 @@ TilesetConfig::TilesetConfig()
     m_waterFrames[2] = 22;
     m_waterFrames[3] = 23;
     for (int i = 4; i < MAX_WATER_FRAMES; ++i) m_waterFrames[i] = 0;
+    Compile();
 }
 
 void TilesetConfig::LoadDefaults() {
@@ -54,6 +55,7 @@ void TilesetConfig::LoadDefaults() {
     m_tileSize = 32;
     m_sheetFile = "assets/tilesets/world_tileset.png";
     m_hasSeasonal = false;
+    Compile();
 }
 
 bool TilesetConfig::LoadFromFile(const std::string& filepath) {
@@ -129,6 +131,7 @@ bool TilesetConfig::LoadFromFile(const std::string& filepath) {
     }
 
     file.close();
+    Compile();
     std::cout << "TilesetConfig: Loaded from " << filepath
               << " (tile_size=" << m_tileSize
               << ", seasonal=" << (m_hasSeasonal ? "yes" : "no") << ")" << std::endl;
@@ -161,6 +164,35 @@ int TilesetConfig::GetSpriteId(TileType type) const {
     return 0; // Default
 }
 
+void TilesetConfig::Compile() {
+    m_spriteTable.resize(static_cast<size_t>(SEASON_COUNT) * TILE_TYPE_COUNT * VARIANT_COUNT);
+    int* entry = m_spriteTable.data();
+    for (int season = 0; season < SEASON_COUNT; ++season) {
+        for (int type = 0; type < TILE_TYPE_COUNT; ++type) {
+            for (int variant = 0; variant < VARIANT_COUNT; ++variant) {
+                *entry++ = ResolveSpriteId(static_cast<TileType>(type), static_cast<Season>(season), variant);
+            }
+        }
+    }
+}
+
+int TilesetConfig::ResolveSpriteId(TileType type, Season season, int variant) const {
+    switch (type) {
+        case TileType::WATER:
+            return GetWaterFrame(variant);
+        case TileType::WALL:
+            return m_wallAutoTileBase + variant;
+        case TileType::CROP:
+            return m_cropGrowthBase + variant;
+        case TileType::DECORATION:
+            return m_decorationBase + variant;
+        case TileType::TREE:
+            return m_treeBase;
+        default:
+            return GetSpriteId(type, season);
+    }
+}
+
 int TilesetConfig::GetWaterFrame(int frameIndex) const {
     if (frameIndex < 0 || frameIndex >= m_waterFrameCount) return m_waterFrames[0];
     return m_waterFrames[frameIndex];
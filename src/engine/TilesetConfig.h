@@ -1,11 +1,13 @@
 #ifndef TILESETCONFIG_H
 #define TILESETCONFIG_H
 
+#include "../world/Tile.h"
+#include <cstdint>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 // Forward declarations
-enum class TileType;
 enum class Season;
 
 /**
@@ -32,6 +34,9 @@ enum class Season;
  *   WALL.AUTOTILE_BASE 7
  *   CROP.GROWTH_BASE 30
  *   WATER.ANIM_FRAMES 3 21 22 23
+ *
+ * Every load compiles the mapping into a dense table covering all seasons,
+ * so the render loop resolves a sprite with GetTileSpriteId, one array read.
  */
 class TilesetConfig {
 public:
@@ -71,6 +76,17 @@ public:
     // Check if seasonal variants are configured
     bool HasSeasonalSupport() const { return m_hasSeasonal; }
 
+    // Compiled lookup. variant is the visual id for walls and decorations,
+    // the growth stage for crops and the animation frame for water (which
+    // has no visual variants); other types ignore it.
+    static constexpr int TILE_TYPE_COUNT = ::TILE_TYPE_COUNT;
+    static constexpr int SEASON_COUNT = 4;
+    static constexpr int VARIANT_COUNT = 256;
+    int GetTileSpriteId(TileType type, Season season, int variant) const {
+        return m_spriteTable[(static_cast<int>(season) * TILE_TYPE_COUNT + static_cast<int>(type)) * VARIANT_COUNT +
+                             (variant & (VARIANT_COUNT - 1))];
+    }
+
 private:
     // Key for the seasonal lookup: combines TileType + Season
     struct SeasonKey {
@@ -109,7 +125,12 @@ private:
     std::string m_sheetFile;
     bool m_hasSeasonal;
 
+    // Dense (season, type, variant) -> sprite ID table, rebuilt by Compile
+    std::vector<int> m_spriteTable;
+
     // Helpers
+    void Compile();
+    int ResolveSpriteId(TileType type, Season season, int variant) const;
     static int ParseTileType(const std::string& name);
     static int ParseSeason(const std::string& name);
 };
@@ -0,0 +1,155 @@
+#include "ActorRegistry.h"
+#include "../world/Map.h"
+
+namespace {
+
+// Applies f to every column of a table, so adding a component is one line here
+template <typename F>
+void ForEachColumn(ActorColumns& c, F f) {
+    f(c.x); f(c.y);
+    f(c.prevX); f(c.prevY);
+    f(c.width); f(c.height);
+    f(c.velX); f(c.velY);
+    f(c.active);
+    f(c.id);
+}
+
+template <typename F>
+void ForEachColumn(EnemyColumns& c, F f) {
+    f(c.health);
+    f(c.speed);
+    f(c.aiState);
+    f(c.targetX); f(c.targetY);
+    f(c.targetVisible);
+    f(c.outOfSightTimer);
+    f(c.patrolOriginX); f(c.patrolOriginY);
+    f(c.patrolTargetX); f(c.patrolTargetY);
+    f(c.patrolTimer);
+}
+
+// Moves the last row into `row` and drops the last row
+struct SwapRemove {
+    std::size_t row;
+    template <typename Column>
+    void operator()(Column& column) const {
+        column[row] = column.back();
+        column.pop_back();
+    }
+};
+
+} // namespace
+
+ActorId ActorRegistry::Create(ActorKind kind) {
+    std::uint32_t slotIndex;
+    if (!m_freeSlots.empty()) {
+        slotIndex = m_freeSlots.back();
+        m_freeSlots.pop_back();
+    } else {
+        slotIndex = static_cast<std::uint32_t>(m_slots.size());
+        m_slots.emplace_back();
+    }
+
+    ActorColumns& table = Table(kind);
+    Slot& slot = m_slots[slotIndex];
+    slot.kind = kind;
+    slot.row = static_cast<int>(table.id.size());
+    ActorId id = (static_cast<ActorId>(slot.generation) << SLOT_BITS) | slotIndex;
+
+    table.x.push_back(0.0f);
+    table.y.push_back(0.0f);
+    table.prevX.push_back(0.0f);
+    table.prevY.push_back(0.0f);
+    table.width.push_back(32.0f);
+    table.height.push_back(32.0f);
+    table.velX.push_back(0.0f);
+    table.velY.push_back(0.0f);
+    table.active.push_back(1);
+    table.id.push_back(id);
+
+    if (kind == ActorKind::ENEMY) {
+        m_enemy.health.push_back(3);
+        m_enemy.speed.push_back(50.0f);
+        m_enemy.aiState.push_back(EnemyAIState::PATROL);
+        m_enemy.targetX.push_back(0.0f);
+        m_enemy.targetY.push_back(0.0f);
+        m_enemy.targetVisible.push_back(1);   // Nobody feeds sight: go by distance alone
+        m_enemy.outOfSightTimer.push_back(0.0f);
+        m_enemy.patrolOriginX.push_back(0.0f);
+        m_enemy.patrolOriginY.push_back(0.0f);
+        m_enemy.patrolTargetX.push_back(0.0f);
+        m_enemy.patrolTargetY.push_back(0.0f);
+        m_enemy.patrolTimer.push_back(0.0f);
+    }
+    return id;
+}
+
+void ActorRegistry::Destroy(ActorId id) {
+    const Slot* found = Find(id);
+    if (!found) return;
+
+    std::uint32_t slotIndex = static_cast<std::uint32_t>(id & SLOT_MASK);
+    Slot& slot = m_slots[slotIndex];
+    ActorColumns& table = Table(slot.kind);
+    std::size_t row = static_cast<std::size_t>(slot.row);
+    std::size_t last = table.id.size() - 1;
+    if (row != last) {
+        // The last row's owner is about to live at `row`
+        m_slots[table.id[last] & SLOT_MASK].row = slot.row;
+    }
+    ForEachColumn(table, SwapRemove{row});
+    if (slot.kind == ActorKind::ENEMY) ForEachColumn(m_enemy, SwapRemove{row});
+
+    slot.row = -1;
+    if (++slot.generation == 0) slot.generation = 1;   // Keeps every id non-zero
+    m_freeSlots.push_back(slotIndex);
+}
+
+void ActorRegistry::Clear() {
+    auto clear = [](auto& column) { column.clear(); };
+    ForEachColumn(m_enemyCommon, clear);
+    ForEachColumn(m_enemy, clear);
+    ForEachColumn(m_npcCommon, clear);
+    m_freeSlots.clear();
+    for (std::uint32_t i = 0; i < m_slots.size(); ++i) {
+        Slot& slot = m_slots[i];
+        if (slot.row >= 0) {
+            slot.row = -1;
+            if (++slot.generation == 0) slot.generation = 1;
+        }
+        m_freeSlots.push_back(i);
+    }
+}
+
+const ActorRegistry::Slot* ActorRegistry::Find(ActorId id) const {
+    std::uint32_t slotIndex = static_cast<std::uint32_t>(id & SLOT_MASK);
+    if (id == 0 || slotIndex >= m_slots.size()) return nullptr;
+    const Slot& slot = m_slots[slotIndex];
+    if (slot.row < 0 || slot.generation != (id >> SLOT_BITS)) return nullptr;
+    return &slot;
+}
+
+bool ActorRegistry::IsAlive(ActorId id) const {
+    return Find(id) != nullptr;
+}
+
+int ActorRegistry::GetRow(ActorId id) const {
+    const Slot* slot = Find(id);
+    return slot ? slot->row : -1;
+}
+
+ActorKind ActorRegistry::GetKind(ActorId id) const {
+    const Slot* slot = Find(id);
+    return slot ? slot->kind : ActorKind::ENEMY;
+}
+
+bool ActorRegistry::Move(ActorKind kind, int row, float dx, float dy) {
+    ActorColumns& table = Table(kind);
+    if (!m_map) {
+        table.x[row] += dx;
+        table.y[row] += dy;
+        return true;
+    }
+    CollisionResult result = m_map->MoveAndCollide(table.x[row], table.y[row],
+                                                   table.width[row], table.height[row], dx, dy);
+    return !result.hitX && !result.hitY;
+}
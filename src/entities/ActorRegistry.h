@@ -0,0 +1,112 @@
+#ifndef ACTORREGISTRY_H
+#define ACTORREGISTRY_H
+
+#include <cstdint>
+#include <vector>
+
+class Map;
+class FlowField;
+
+using ActorId = std::uint64_t;   // 0 never names an actor
+
+enum class ActorKind : std::uint8_t { ENEMY, NPC };
+
+enum class EnemyAIState : std::uint8_t { IDLE, PATROL, CHASE };
+
+// Components every actor has, one element per row
+struct ActorColumns {
+    std::vector<float> x, y;
+    std::vector<float> prevX, prevY;        // Position at the start of the current tick
+    std::vector<float> width, height;
+    std::vector<float> velX, velY;          // World units per second, applied by ActorSystems::Integrate
+    std::vector<std::uint8_t> active;
+    std::vector<ActorId> id;                // Owner of each row
+};
+
+// Components only enemies have (rows line up with the enemy ActorColumns)
+struct EnemyColumns {
+    std::vector<int> health;
+    std::vector<float> speed;
+    std::vector<EnemyAIState> aiState;
+    std::vector<float> targetX, targetY;
+    std::vector<std::uint8_t> targetVisible;
+    std::vector<float> outOfSightTimer;
+    std::vector<float> patrolOriginX, patrolOriginY;
+    std::vector<float> patrolTargetX, patrolTargetY;
+    std::vector<float> patrolTimer;
+};
+
+/**
+ * ActorRegistry - enemies and NPCs as rows of contiguous component arrays
+ *
+ * Each kind of actor is an archetype with its own table: every component is
+ * a separate array (structure of arrays) and row i of each array belongs to
+ * the same actor. Systems (see ActorSystems) walk the arrays front to back,
+ * so updating thousands of actors touches memory linearly with no virtual
+ * calls. Destroying an actor moves the last row of its table into the hole,
+ * keeping tables dense.
+ *
+ * Actors are named by ActorId, which stays valid while rows move around.
+ * An id carries a generation, so an id of a destroyed actor never finds the
+ * actor that later reuses its slot. Ids are 32 bits of slot and 32 bits of
+ * generation; a slot would have to be reused four billion times before an
+ * old id could match again. Enemy and NPC are thin handles over one
+ * row each.
+ *
+ * The map and flow field are the world the registry's actors move in.
+ */
+class ActorRegistry {
+public:
+    ActorRegistry() = default;
+
+    ActorRegistry(const ActorRegistry&) = delete;
+    ActorRegistry& operator=(const ActorRegistry&) = delete;
+
+    ActorId Create(ActorKind kind);
+    void Destroy(ActorId id);
+    void Clear();
+
+    bool IsAlive(ActorId id) const;
+    // Current row of a live actor, or -1. Rows change when actors are destroyed.
+    int GetRow(ActorId id) const;
+    ActorKind GetKind(ActorId id) const;
+    int GetCount(ActorKind kind) const { return static_cast<int>(Table(kind).id.size()); }
+
+    ActorColumns& GetColumns(ActorKind kind) { return Table(kind); }
+    const ActorColumns& GetColumns(ActorKind kind) const { return Table(kind); }
+    EnemyColumns& GetEnemyColumns() { return m_enemy; }
+    const EnemyColumns& GetEnemyColumns() const { return m_enemy; }
+
+    // Moves a row by (dx, dy), stopping against solid tiles when a map is set.
+    // Returns false if the move was blocked on either axis.
+    bool Move(ActorKind kind, int row, float dx, float dy);
+
+    void SetMap(const Map* map) { m_map = map; }
+    const Map* GetMap() const { return m_map; }
+    void SetFlowField(const FlowField* field) { m_flowField = field; }
+    const FlowField* GetFlowField() const { return m_flowField; }
+
+private:
+    struct Slot {
+        std::uint32_t generation = 1;
+        ActorKind kind = ActorKind::ENEMY;
+        int row = -1;                       // -1 while free
+    };
+
+    static constexpr int SLOT_BITS = 32;
+    static constexpr ActorId SLOT_MASK = (ActorId{1} << SLOT_BITS) - 1;
+
+    ActorColumns m_enemyCommon;
+    EnemyColumns m_enemy;
+    ActorColumns m_npcCommon;
+    std::vector<Slot> m_slots;
+    std::vector<std::uint32_t> m_freeSlots;
+    const Map* m_map = nullptr;
+    const FlowField* m_flowField = nullptr;
+
+    ActorColumns& Table(ActorKind kind) { return kind == ActorKind::ENEMY ? m_enemyCommon : m_npcCommon; }
+    const ActorColumns& Table(ActorKind kind) const { return kind == ActorKind::ENEMY ? m_enemyCommon : m_npcCommon; }
+    const Slot* Find(ActorId id) const;
+};
+
+#endif // ACTORREGISTRY_H
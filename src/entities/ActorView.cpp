@@ -0,0 +1,86 @@
+#include "ActorView.h"
+#include <utility>
+
+ActorView::ActorView(ActorRegistry* registry, ActorKind kind)
+    : m_owned(registry ? nullptr : std::make_unique<ActorRegistry>())
+    , m_registry(registry ? registry : m_owned.get())
+    , m_id(m_registry->Create(kind))
+    , m_kind(kind)
+{
+}
+
+ActorView::~ActorView() {
+    if (m_registry) m_registry->Destroy(m_id);
+}
+
+ActorView::ActorView(ActorView&& other) noexcept
+    : m_owned(std::move(other.m_owned))
+    , m_registry(other.m_registry)
+    , m_id(other.m_id)
+    , m_kind(other.m_kind)
+{
+    other.m_registry = nullptr;
+    other.m_id = 0;
+}
+
+ActorView& ActorView::operator=(ActorView&& other) noexcept {
+    if (this == &other) return *this;
+    if (m_registry) m_registry->Destroy(m_id);
+    m_owned = std::move(other.m_owned);
+    m_registry = other.m_registry;
+    m_id = other.m_id;
+    m_kind = other.m_kind;
+    other.m_registry = nullptr;
+    other.m_id = 0;
+    return *this;
+}
+
+void ActorView::SetPosition(float x, float y) {
+    ActorColumns& c = Columns();
+    int row = Row();
+    c.x[row] = c.prevX[row] = x;
+    c.y[row] = c.prevY[row] = y;
+}
+
+void ActorView::GetPosition(float& x, float& y) const {
+    const ActorColumns& c = Columns();
+    int row = Row();
+    x = c.x[row];
+    y = c.y[row];
+}
+
+void ActorView::SetSize(float w, float h) {
+    ActorColumns& c = Columns();
+    int row = Row();
+    c.width[row] = w;
+    c.height[row] = h;
+}
+
+void ActorView::GetSize(float& w, float& h) const {
+    const ActorColumns& c = Columns();
+    int row = Row();
+    w = c.width[row];
+    h = c.height[row];
+}
+
+void ActorView::StorePreviousPosition() {
+    ActorColumns& c = Columns();
+    int row = Row();
+    c.prevX[row] = c.x[row];
+    c.prevY[row] = c.y[row];
+}
+
+void ActorView::GetRenderPosition(float alpha, float& x, float& y) const {
+    const ActorColumns& c = Columns();
+    int row = Row();
+    x = c.prevX[row] + (c.x[row] - c.prevX[row]) * alpha;
+    y = c.prevY[row] + (c.y[row] - c.prevY[row]) * alpha;
+}
+
+bool ActorView::IsActive() const {
+    return Columns().active[Row()] != 0;
+}
+
+void ActorView::SetActive(bool active) {
+    Columns().active[Row()] = active ? 1 : 0;
+}
@@ -0,0 +1,57 @@
+#ifndef ACTORVIEW_H
+#define ACTORVIEW_H
+
+#include "ActorRegistry.h"
+#include <memory>
+
+/**
+ * ActorView - handle to one actor's row in an ActorRegistry
+ *
+ * Gives the accessors every actor has (position, size, active flag) on top
+ * of the registry's arrays. A view owns its actor: the row is created with
+ * the view and destroyed with it. A view given no registry (tests, tools)
+ * gets a private registry holding just its own actor.
+ */
+class ActorView {
+public:
+    ActorView(const ActorView&) = delete;
+    ActorView& operator=(const ActorView&) = delete;
+
+    ActorRegistry* GetRegistry() const { return m_registry; }
+    ActorId GetId() const { return m_id; }
+
+    // Placing an actor is a jump, not a move: nothing to interpolate from
+    void SetPosition(float x, float y);
+    void GetPosition(float& x, float& y) const;
+    void SetSize(float w, float h);
+    void GetSize(float& w, float& h) const;
+
+    // Called before each simulation tick; rendering blends from here to the
+    // current position by alpha (0 = previous tick, 1 = latest)
+    void StorePreviousPosition();
+    void GetRenderPosition(float alpha, float& x, float& y) const;
+
+    bool IsActive() const;
+    void SetActive(bool active);
+
+    // The map actors collide with, shared by everything in the registry
+    void SetMap(const Map* map) { m_registry->SetMap(map); }
+    const Map* GetMap() const { return m_registry->GetMap(); }
+
+protected:
+    ActorView(ActorRegistry* registry, ActorKind kind);
+    ~ActorView();
+    ActorView(ActorView&& other) noexcept;
+    ActorView& operator=(ActorView&& other) noexcept;
+
+    int Row() const { return m_registry->GetRow(m_id); }
+    ActorColumns& Columns() const { return m_registry->GetColumns(m_kind); }
+    bool Move(float dx, float dy) { return m_registry->Move(m_kind, Row(), dx, dy); }
+
+    std::unique_ptr<ActorRegistry> m_owned;     // Only for views given no registry
+    ActorRegistry* m_registry;
+    ActorId m_id;
+    ActorKind m_kind;
+};
+
+#endif // ACTORVIEW_H
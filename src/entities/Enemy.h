@@ -1,41 +1,46 @@
 #ifndef ENEMY_H
 #define ENEMY_H
 
-#include "Entity.h"
-
-class Enemy : public Entity {
+#include "ActorView.h"
+
+class FlowField;
+class Renderer;
+
+/**
+ * Enemy - handle to one row of the registry's enemy table
+ *
+ * All state lives in ActorRegistry's component arrays, and the game updates
+ * every enemy at once through ActorSystems. Update() runs the same systems
+ * for this enemy alone.
+ */
+class Enemy : public ActorView {
 public:
-    Enemy();
-    ~Enemy() override = default;
-
-    void Update(float deltaTime) override;
-    void Render(Renderer* renderer) override;
-
-    void SetHealth(int health) { m_health = health; }
-    int GetHealth() const { return m_health; }
-
-    void SetTarget(float x, float y) { m_targetX = x; m_targetY = y; }
-    void SetPatrolOrigin(float x, float y) { m_patrolOriginX = x; m_patrolOriginY = y; }
-
-    enum class AIState { IDLE, PATROL, CHASE };
-    void SetAIState(AIState state) { m_aiState = state; }
-    AIState GetAIState() const { return m_aiState; }
-
-private:
-    int m_health;
-    float m_speed;
-    AIState m_aiState;
-
-    // Patrol state
-    float m_patrolOriginX, m_patrolOriginY;
-    float m_patrolTargetX, m_patrolTargetY;
-    float m_patrolTimer;
+    explicit Enemy(ActorRegistry* registry = nullptr);
+
+    void Update(float deltaTime);
+    void Render(Renderer* renderer) const;
+
+    void SetHealth(int health);
+    int GetHealth() const;
+
+    void SetTarget(float x, float y);
+    // Whether the target is in line of sight this frame (see Map::HasLineOfSight).
+    // Defaults to visible, so an enemy nobody feeds sight to goes by distance alone.
+    void SetTargetVisible(bool visible);
+    bool IsTargetVisible() const;
+    // Shared field toward the player; chasing follows it around walls (shared by the registry)
+    void SetFlowField(const FlowField* field) { m_registry->SetFlowField(field); }
+    void SetPatrolOrigin(float x, float y);
+
+    using AIState = EnemyAIState;
+    void SetAIState(AIState state);
+    AIState GetAIState() const;
+
+    static constexpr float CHASE_RANGE = 150.0f;              // Starts chasing a visible target
+    static constexpr float LOSE_RANGE = CHASE_RANGE * 1.5f;    // Gives up beyond this
+    static constexpr float LOSE_SIGHT_TIME = 3.0f;            // Or after this long out of sight
     static constexpr float PATROL_RADIUS = 64.0f;
     static constexpr float PATROL_INTERVAL = 3.0f;
-
-    // Chase state
-    float m_targetX, m_targetY;
-    static constexpr float CHASE_RANGE = 150.0f;
 };
 
 #endif // ENEMY_H
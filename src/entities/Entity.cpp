@@ -1,10 +1,24 @@
 #include "Entity.h"
+#include "../world/Map.h"
 
 Entity::Entity()
     : m_x(0.0f)
     , m_y(0.0f)
+    , m_prevX(0.0f)
+    , m_prevY(0.0f)
     , m_width(32.0f)
     , m_height(32.0f)
     , m_active(true)
+    , m_map(nullptr)
 {
 }
+
+bool Entity::Move(float dx, float dy) {
+    if (!m_map) {
+        m_x += dx;
+        m_y += dy;
+        return true;
+    }
+    CollisionResult result = m_map->MoveAndCollide(m_x, m_y, m_width, m_height, dx, dy);
+    return !result.hitX && !result.hitY;
+}
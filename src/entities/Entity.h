@@ -2,6 +2,7 @@
 #define ENTITY_H
 
 class Renderer;
+class Map;
 
 class Entity {
 public:
@@ -11,8 +12,17 @@ public:
     virtual void Update(float deltaTime) = 0;
     virtual void Render(Renderer* renderer) = 0;
 
-    void SetPosition(float x, float y) { m_x = x; m_y = y; }
+    // Placing an entity is a jump, not a move: nothing to interpolate from
+    void SetPosition(float x, float y) { m_x = m_prevX = x; m_y = m_prevY = y; }
     void GetPosition(float& x, float& y) const { x = m_x; y = m_y; }
+
+    // Called before each simulation tick; rendering blends from here to the
+    // current position by alpha (0 = previous tick, 1 = latest)
+    void StorePreviousPosition() { m_prevX = m_x; m_prevY = m_y; }
+    void GetRenderPosition(float alpha, float& x, float& y) const {
+        x = m_prevX + (m_x - m_prevX) * alpha;
+        y = m_prevY + (m_y - m_prevY) * alpha;
+    }
     
     void SetSize(float w, float h) { m_width = w; m_height = h; }
     void GetSize(float& w, float& h) const { w = m_width; h = m_height; }
@@ -20,10 +30,20 @@ public:
     bool IsActive() const { return m_active; }
     void SetActive(bool active) { m_active = active; }
 
+    // The map whose solid tiles this entity collides with (none by default)
+    void SetMap(const Map* map) { m_map = map; }
+    const Map* GetMap() const { return m_map; }
+
 protected:
+    // Move by (dx, dy), stopping against solid tiles when a map is set.
+    // Returns false if the move was blocked on either axis.
+    bool Move(float dx, float dy);
+
     float m_x, m_y;
+    float m_prevX, m_prevY;     // Position at the start of the current tick
     float m_width, m_height;
     bool m_active;
+    const Map* m_map;
 };
 
 #endif // ENTITY_H
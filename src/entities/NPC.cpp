@@ -1,18 +1,26 @@
 #include "NPC.h"
 #include "../engine/Renderer.h"
+#include "../world/Map.h"
+#include <algorithm>
 #include <cmath>
 
-NPC::NPC()
-    : Entity()
+NPC::NPC(ActorRegistry* registry)
+    : ActorView(registry, ActorKind::NPC)
     , m_name("NPC")
     , m_friendshipLevel(0)
     , m_moveSpeed(60.0f)
     , m_destX(0.0f)
     , m_destY(0.0f)
     , m_moving(false)
+    , m_pathService(nullptr)
+    , m_pathRequest(0)
+    , m_pathGraph(nullptr)
+    , m_pathIndex(0)
 {
-    m_width = 32.0f;
-    m_height = 32.0f;
+}
+
+NPC::~NPC() {
+    if (m_pathService && m_pathRequest) m_pathService->Release(m_pathRequest);
 }
 
 void NPC::AddFriendship(int amount) {
@@ -39,52 +47,109 @@ void NPC::SetCurrentHour(int hour) {
         m_destX = best->destX;
         m_destY = best->destY;
         // Only set moving if we're not already there
-        float dx = m_destX - m_x;
-        float dy = m_destY - m_y;
+        float x, y;
+        GetPosition(x, y);
+        float dx = m_destX - x;
+        float dy = m_destY - y;
         float dist = std::sqrt(dx * dx + dy * dy);
         m_moving = (dist > ARRIVAL_THRESHOLD);
+        PlanPath();
+    }
+}
+
+void NPC::PlanPath() {
+    m_path.clear();
+    m_pathIndex = 0;
+    if (m_pathService && m_pathRequest) {
+        m_pathService->Release(m_pathRequest);
+        m_pathRequest = 0;
+    }
+    const Map* map = GetMap();
+    if (!m_moving || !map || (!m_pathService && !m_pathGraph)) return;
+
+    float x, y, width, height;
+    GetPosition(x, y);
+    GetSize(width, height);
+    int startX, startY, goalX, goalY;
+    map->WorldToTile(x + width * 0.5f, y + height * 0.5f, startX, startY);
+    map->WorldToTile(m_destX + width * 0.5f, m_destY + height * 0.5f, goalX, goalY);
+    if (m_pathService) {
+        m_pathRequest = m_pathService->Request(startX, startY, goalX, goalY);
+        return;
+    }
+    // No route (or a blocked destination): fall back to walking straight there
+    if (!m_pathGraph->FindPath(startX, startY, goalX, goalY, m_path)) {
+        m_path.clear();
     }
 }
 
 void NPC::Update(float deltaTime) {
-    if (!m_active) return;
+    if (!IsActive()) return;
+
+    if (m_moving && m_pathRequest) {
+        if (m_pathService->GetStatus(m_pathRequest) == PathStatus::PENDING) return;
+        // No route: walk straight, as without a service
+        if (!m_pathService->TakePath(m_pathRequest, m_path)) m_path.clear();
+        m_pathRequest = 0;
+        m_pathIndex = 0;
+    }
 
     if (m_moving) {
-        float dx = m_destX - m_x;
-        float dy = m_destY - m_y;
+        // Head for the next tile on the path; the last one is the destination itself
+        float x, y, width, height;
+        GetPosition(x, y);
+        GetSize(width, height);
+        float goalX = m_destX;
+        float goalY = m_destY;
+        bool waypoint = m_pathIndex + 1 < m_path.size();
+        if (waypoint) {
+            float tileX, tileY;
+            GetMap()->TileToWorld(m_path[m_pathIndex].x, m_path[m_pathIndex].y, tileX, tileY);
+            goalX = tileX + (Map::TILE_SIZE - width) * 0.5f;
+            goalY = tileY + (Map::TILE_SIZE - height) * 0.5f;
+        }
+
+        float dx = goalX - x;
+        float dy = goalY - y;
         float dist = std::sqrt(dx * dx + dy * dy);
 
         if (dist <= ARRIVAL_THRESHOLD) {
-            m_moving = false;
-            m_x = m_destX;
-            m_y = m_destY;
+            Move(dx, dy);
+            if (waypoint) {
+                m_pathIndex++;
+            } else {
+                m_moving = false;
+                m_path.clear();
+            }
         } else {
-            // Normalize and move
-            float nx = dx / dist;
-            float ny = dy / dist;
-            m_x += nx * m_moveSpeed * deltaTime;
-            m_y += ny * m_moveSpeed * deltaTime;
+            // Normalize and move, without overshooting the goal
+            float step = std::min(m_moveSpeed * deltaTime, dist);
+            Move(dx / dist * step, dy / dist * step);
         }
     }
 }
 
-void NPC::Render(Renderer* renderer) {
-    if (!m_active) return;
+void NPC::Render(Renderer* renderer) const {
+    if (!IsActive()) return;
     // Color based on friendship level (greener = friendlier)
     int g = 100 + (m_friendshipLevel * 15);
     if (g > 255) g = 255;
+    float drawX, drawY, width, height;
+    GetRenderPosition(renderer->GetInterpolation(), drawX, drawY);
+    GetSize(width, height);
     renderer->FillRect(
-        static_cast<int>(m_x),
-        static_cast<int>(m_y),
-        static_cast<int>(m_width),
-        static_cast<int>(m_height),
+        static_cast<int>(drawX),
+        static_cast<int>(drawY),
+        static_cast<int>(width),
+        static_cast<int>(height),
         100, g, 100
     );
 }
 
 bool NPC::IsPlayerNearby(float playerX, float playerY) const {
-    float dx = playerX - m_x;
-    float dy = playerY - m_y;
-    float dist = std::sqrt(dx * dx + dy * dy);
-    return dist <= INTERACT_RANGE;
+    float x, y;
+    GetPosition(x, y);
+    float dx = playerX - x;
+    float dy = playerY - y;
+    return dx * dx + dy * dy <= INTERACT_RANGE * INTERACT_RANGE;
 }
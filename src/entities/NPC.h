@@ -1,8 +1,9 @@
 #ifndef NPC_H
 #define NPC_H
 
-#include "Entity.h"
+#include "ActorView.h"
 #include "../systems/Dialogue.h"
+#include "../world/PathService.h"
 #include <string>
 #include <vector>
 
@@ -12,13 +13,22 @@ struct ScheduleEntry {
     float destY;      // Destination Y
 };
 
-class NPC : public Entity {
+class Renderer;
+
+/**
+ * NPC - handle to one row of the registry's NPC table
+ *
+ * Position, size and the active flag live in ActorRegistry's arrays like
+ * every actor's. What only an NPC has (name, schedule, path, dialogue) is
+ * rarely touched and few NPCs exist, so it stays here.
+ */
+class NPC : public ActorView {
 public:
-    NPC();
-    ~NPC() override = default;
+    explicit NPC(ActorRegistry* registry = nullptr);
+    ~NPC();
 
-    void Update(float deltaTime) override;
-    void Render(Renderer* renderer) override;
+    void Update(float deltaTime);
+    void Render(Renderer* renderer) const;
 
     void SetName(const std::string& name) { m_name = name; }
     const std::string& GetName() const { return m_name; }
@@ -30,6 +40,15 @@ public:
     // Schedule
     void AddScheduleEntry(int hour, float x, float y);
     void SetCurrentHour(int hour);
+    bool IsMoving() const { return m_moving; }
+
+    // Schedule walks follow paths when a map and one of these is set. A path
+    // service is asked asynchronously (the NPC waits in place for the answer);
+    // a path graph is searched on the spot.
+    void SetPathService(PathService* service) { m_pathService = service; }
+    void SetPathGraph(PathGraph* graph) { m_pathGraph = graph; }
+    bool IsWaitingForPath() const { return m_pathRequest != 0; }
+    const std::vector<PathTile>& GetPath() const { return m_path; }
 
     // Dialogue
     Dialogue& GetDialogue() { return m_dialogue; }
@@ -37,6 +56,7 @@ public:
 
     // Interaction
     bool IsPlayerNearby(float playerX, float playerY) const;
+    static constexpr float INTERACT_RANGE = 48.0f;
 
 private:
     std::string m_name;
@@ -47,12 +67,18 @@ private:
     float m_moveSpeed;
     float m_destX, m_destY;
     bool m_moving;
+    PathService* m_pathService;
+    PathHandle m_pathRequest;          // Outstanding service request, 0 if none
+    PathGraph* m_pathGraph;
+    std::vector<PathTile> m_path;      // Tiles still to cross; empty walks straight
+    size_t m_pathIndex;
 
     // Dialogue
     Dialogue m_dialogue;
 
-    static constexpr float INTERACT_RANGE = 48.0f;
     static constexpr float ARRIVAL_THRESHOLD = 2.0f;
+
+    void PlanPath();
     static constexpr int MAX_FRIENDSHIP = 10;
 };
 
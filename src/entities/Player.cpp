@@ -10,6 +10,8 @@ Player::Player()
     , m_maxHealth(3)
     , m_velocityX(0.0f)
     , m_velocityY(0.0f)
+    , m_boundsWidth(800.0f)
+    , m_boundsHeight(600.0f)
     , m_facing(Direction::DOWN)
 {
     m_width = 32.0f;
@@ -49,15 +51,14 @@ void Player::Update(float deltaTime, Input* input) {
         m_velocityY *= 0.707f;
     }
 
-    // Update position
-    m_x += m_velocityX * deltaTime;
-    m_y += m_velocityY * deltaTime;
+    // Update position, sliding along any walls
+    Move(m_velocityX * deltaTime, m_velocityY * deltaTime);
 
-    // Keep player on screen (temporary bounds)
+    // Keep player inside the world
     if (m_x < 0) m_x = 0;
     if (m_y < 0) m_y = 0;
-    if (m_x > 800 - m_width) m_x = 800 - m_width;
-    if (m_y > 600 - m_height) m_y = 600 - m_height;
+    if (m_x > m_boundsWidth - m_width) m_x = m_boundsWidth - m_width;
+    if (m_y > m_boundsHeight - m_height) m_y = m_boundsHeight - m_height;
 }
 
 void Player::Render(Renderer* renderer) {
@@ -65,13 +66,15 @@ void Player::Render(Renderer* renderer) {
 
     // Try to use character sprite sheet if available
     SpriteSheet* charSheet = SpriteSheetManager::Instance().GetSpriteSheet("characters");
-    
+    float drawX, drawY;
+    GetRenderPosition(renderer->GetInterpolation(), drawX, drawY);
+
     if (charSheet && charSheet->IsLoaded()) {
         // Use sprite sheet - get tile based on direction
         int spriteId = GetCharacterSpriteId();
         charSheet->RenderTile(renderer, spriteId, 
-                             static_cast<int>(m_x), 
-                             static_cast<int>(m_y),
+                             static_cast<int>(drawX),
+                             static_cast<int>(drawY),
                              static_cast<int>(m_width),
                              static_cast<int>(m_height));
     } else {
@@ -91,9 +94,11 @@ void Player::RenderFallback(Renderer* renderer) {
         case Direction::RIGHT: r = 200; g = 200; b = 50;  break;
     }
 
+    float drawX, drawY;
+    GetRenderPosition(renderer->GetInterpolation(), drawX, drawY);
     renderer->FillRect(
-        static_cast<int>(m_x),
-        static_cast<int>(m_y),
+        static_cast<int>(drawX),
+        static_cast<int>(drawY),
         static_cast<int>(m_width),
         static_cast<int>(m_height),
         r, g, b
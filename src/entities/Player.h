@@ -20,12 +20,16 @@ public:
     void SetMaxHealth(int maxHealth) { m_maxHealth = maxHealth; }
     int GetMaxHealth() const { return m_maxHealth; }
 
+    // Area the player is kept inside, in world pixels
+    void SetWorldBounds(float width, float height) { m_boundsWidth = width; m_boundsHeight = height; }
+
 private:
     static constexpr float MOVE_SPEED = 150.0f;
     
     int m_health;
     int m_maxHealth;
     float m_velocityX, m_velocityY;
+    float m_boundsWidth, m_boundsHeight;
     
     enum class Direction { DOWN, UP, LEFT, RIGHT };
     Direction m_facing;
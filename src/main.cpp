@@ -1,9 +1,43 @@
 #include "engine/Game.h"
+#include "engine/FixedTimestep.h"
 #include "engine/Logger.h"
+#include "engine/Renderer.h"
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
 #include <iostream>
 #include <memory>
+#include <string>
 
 int main(int argc, char* argv[]) {
+    // --headless [--frames N]: run the full game loop without a display and report render stats
+    // --single-thread: simulate and draw on the main thread instead of handing frames over
+    // --tick-rate N / --max-catch-up N: simulation steps per second / per frame at most
+    // --fps N: frame cap for drawing (0 = uncapped)
+    bool headless = false;
+    bool singleThread = false;
+    int tickRate = Game::TICK_RATE;
+    int maxCatchUp = Game::MAX_CATCH_UP_STEPS;
+    int fps = -1;
+    int frames = 0;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--headless") == 0) {
+            headless = true;
+        } else if (std::strcmp(argv[i], "--single-thread") == 0) {
+            singleThread = true;
+        } else if (std::strcmp(argv[i], "--frames") == 0 && i + 1 < argc) {
+            frames = std::atoi(argv[++i]);
+        } else if (std::strcmp(argv[i], "--tick-rate") == 0 && i + 1 < argc) {
+            tickRate = std::atoi(argv[++i]);
+        } else if (std::strcmp(argv[i], "--max-catch-up") == 0 && i + 1 < argc) {
+            maxCatchUp = std::atoi(argv[++i]);
+        } else if (std::strcmp(argv[i], "--fps") == 0 && i + 1 < argc) {
+            fps = std::atoi(argv[++i]);
+        }
+    }
+    if (headless && frames <= 0) frames = 600;   // Nothing can press ESC
+
+
     // Initialize logging before anything else
     Logger::Instance().Initialize("harvest_quest.log");
 
@@ -27,13 +61,31 @@ int main(int argc, char* argv[]) {
 
     auto game = std::make_unique<Game>();
 
-    if (!game->Initialize("Harvest Quest - Zelda meets Stardew Valley", 800, 600)) {
+    if (!game->Initialize("Harvest Quest - Zelda meets Stardew Valley", 800, 600, headless)) {
         Logger::Instance().Error("Failed to initialize game!");
         Logger::Instance().Shutdown();
         return 1;
     }
 
-    game->Run();
+    game->SetRenderThread(!singleThread);
+    game->SetSimulationRate(tickRate, maxCatchUp);
+    if (fps >= 0) game->SetTargetFrameRate(fps);
+    auto start = std::chrono::steady_clock::now();
+    game->Run(frames);
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    if (headless) {
+        const RenderStats& stats = game->GetRenderer()->GetTotals();
+        double perFrame = stats.frames > 0 ? 1.0 / static_cast<double>(stats.frames) : 0.0;
+        Logger::Instance().Info("Headless run: " + std::to_string(stats.frames) + " frames in " +
+                                std::to_string(seconds * 1000.0) + " ms (" +
+                                std::to_string(seconds * 1000.0 * perFrame) + " ms/frame)");
+        Logger::Instance().Info("  per frame: " + std::to_string(stats.quads * perFrame) + " quads, " +
+                                std::to_string(stats.batches * perFrame) + " texture binds, " +
+                                std::to_string(stats.textDraws * perFrame) + " text draws");
+        Logger::Instance().Info("  simulation: " + std::to_string(game->GetTimestep().GetTickCount()) + " ticks at " +
+                                std::to_string(game->GetTimestep().GetTickRate()) + " Hz");
+    }
     game->Shutdown();
 
     Logger::Instance().Info("Thanks for playing!");
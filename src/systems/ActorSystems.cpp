@@ -0,0 +1,142 @@
+#include "ActorSystems.h"
+#include "../entities/Enemy.h"
+#include "../world/FlowField.h"
+#include "../world/Map.h"
+#include <algorithm>
+#include <cmath>
+#include <random>
+
+namespace {
+
+constexpr float CHASE_SPEED_SCALE = 1.3f;
+
+// Clamps [firstRow, firstRow + rowCount) to the table; rowCount < 0 means "to the end"
+int EndRow(int count, int firstRow, int rowCount) {
+    return rowCount < 0 ? count : std::min(count, firstRow + rowCount);
+}
+
+// Points the velocity at (goalX, goalY) at the given speed, or stops
+void SteerToward(ActorColumns& c, int row, float goalX, float goalY, float speed) {
+    float dx = goalX - c.x[row];
+    float dy = goalY - c.y[row];
+    float dist = std::sqrt(dx * dx + dy * dy);
+    if (dist > 0.0f) {
+        c.velX[row] = dx / dist * speed;
+        c.velY[row] = dy / dist * speed;
+    } else {
+        c.velX[row] = 0.0f;
+        c.velY[row] = 0.0f;
+    }
+}
+
+// Replaces the chase goal with the centre of the next flow field tile
+void SteerByFlowField(const ActorRegistry& registry, const ActorColumns& c, int row, float& goalX, float& goalY) {
+    const Map* map = registry.GetMap();
+    const FlowField* field = registry.GetFlowField();
+    if (!field || !map || !field->IsBuilt()) return;
+
+    int tileX, tileY;
+    map->WorldToTile(c.x[row] + c.width[row] * 0.5f, c.y[row] + c.height[row] * 0.5f, tileX, tileY);
+    int nextX, nextY;
+    // Off the field (too far, or already on the target's tile): head straight at the target
+    if (!field->GetNextTile(tileX, tileY, nextX, nextY)) return;
+
+    float worldX, worldY;
+    map->TileToWorld(nextX, nextY, worldX, worldY);
+    goalX = worldX + (Map::TILE_SIZE - c.width[row]) * 0.5f;
+    goalY = worldY + (Map::TILE_SIZE - c.height[row]) * 0.5f;
+}
+
+} // namespace
+
+void ActorSystems::StorePreviousPositions(ActorRegistry& registry, ActorKind kind) {
+    ActorColumns& c = registry.GetColumns(kind);
+    std::copy(c.x.begin(), c.x.end(), c.prevX.begin());
+    std::copy(c.y.begin(), c.y.end(), c.prevY.begin());
+}
+
+void ActorSystems::SetEnemyTargets(ActorRegistry& registry, float targetX, float targetY) {
+    EnemyColumns& e = registry.GetEnemyColumns();
+    std::fill(e.targetX.begin(), e.targetX.end(), targetX);
+    std::fill(e.targetY.begin(), e.targetY.end(), targetY);
+}
+
+void ActorSystems::UpdateEnemyAI(ActorRegistry& registry, float deltaTime, int firstRow, int rowCount) {
+    static std::mt19937 rng(std::random_device{}());
+    static constexpr float TWO_PI = 6.2831853f;
+
+    ActorColumns& c = registry.GetColumns(ActorKind::ENEMY);
+    EnemyColumns& e = registry.GetEnemyColumns();
+    int end = EndRow(registry.GetCount(ActorKind::ENEMY), firstRow, rowCount);
+    for (int i = firstRow; i < end; ++i) {
+        c.velX[i] = 0.0f;
+        c.velY[i] = 0.0f;
+        if (!c.active[i]) continue;
+
+        switch (e.aiState[i]) {
+            case EnemyAIState::IDLE:
+                break;
+
+            case EnemyAIState::PATROL: {
+                e.patrolTimer[i] += deltaTime;
+                if (e.patrolTimer[i] >= Enemy::PATROL_INTERVAL) {
+                    e.patrolTimer[i] = 0.0f;
+                    // Pick a new random patrol target near origin
+                    std::uniform_real_distribution<float> dist(0.0f, TWO_PI);
+                    float angle = dist(rng);
+                    e.patrolTargetX[i] = e.patrolOriginX[i] + std::cos(angle) * Enemy::PATROL_RADIUS;
+                    e.patrolTargetY[i] = e.patrolOriginY[i] + std::sin(angle) * Enemy::PATROL_RADIUS;
+                }
+
+                float dx = e.patrolTargetX[i] - c.x[i];
+                float dy = e.patrolTargetY[i] - c.y[i];
+                if (dx * dx + dy * dy > 2.0f * 2.0f) {
+                    SteerToward(c, i, e.patrolTargetX[i], e.patrolTargetY[i], e.speed[i]);
+                }
+
+                // Check if the target is within chase range
+                float pdx = e.targetX[i] - c.x[i];
+                float pdy = e.targetY[i] - c.y[i];
+                if (pdx * pdx + pdy * pdy < Enemy::CHASE_RANGE * Enemy::CHASE_RANGE && e.targetVisible[i]) {
+                    e.aiState[i] = EnemyAIState::CHASE;
+                    e.outOfSightTimer[i] = 0.0f;
+                }
+                break;
+            }
+
+            case EnemyAIState::CHASE: {
+                float dx = e.targetX[i] - c.x[i];
+                float dy = e.targetY[i] - c.y[i];
+                float dist = std::sqrt(dx * dx + dy * dy);
+
+                // Keeps chasing around corners for a while after losing sight
+                e.outOfSightTimer[i] = e.targetVisible[i] ? 0.0f : e.outOfSightTimer[i] + deltaTime;
+                if (dist > Enemy::LOSE_RANGE || e.outOfSightTimer[i] > Enemy::LOSE_SIGHT_TIME) {
+                    // Lost the target, return to patrol
+                    e.aiState[i] = EnemyAIState::PATROL;
+                    e.patrolTimer[i] = 0.0f;
+                } else if (dist > 2.0f) {
+                    float goalX = e.targetX[i];
+                    float goalY = e.targetY[i];
+                    SteerByFlowField(registry, c, i, goalX, goalY);
+                    SteerToward(c, i, goalX, goalY, e.speed[i] * CHASE_SPEED_SCALE);
+                }
+                break;
+            }
+        }
+    }
+}
+
+void ActorSystems::Integrate(ActorRegistry& registry, ActorKind kind, float deltaTime, int firstRow, int rowCount) {
+    ActorColumns& c = registry.GetColumns(kind);
+    int end = EndRow(registry.GetCount(kind), firstRow, rowCount);
+    for (int i = firstRow; i < end; ++i) {
+        if (!c.active[i] || (c.velX[i] == 0.0f && c.velY[i] == 0.0f)) continue;
+        registry.Move(kind, i, c.velX[i] * deltaTime, c.velY[i] * deltaTime);
+    }
+}
+
+void ActorSystems::UpdateEnemies(ActorRegistry& registry, float deltaTime) {
+    UpdateEnemyAI(registry, deltaTime);
+    Integrate(registry, ActorKind::ENEMY, deltaTime);
+}
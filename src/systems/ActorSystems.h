@@ -0,0 +1,27 @@
+#ifndef ACTORSYSTEMS_H
+#define ACTORSYSTEMS_H
+
+#include "../entities/ActorRegistry.h"
+
+/**
+ * ActorSystems - per-tick updates over an ActorRegistry's component arrays
+ *
+ * Each system is one loop over a range of rows (all of them by default)
+ * that reads and writes only the arrays it needs. Enemy AI only decides a
+ * velocity; Integrate then moves every row by its velocity, against the
+ * registry's map. Enemy::Update runs the same code for a single row.
+ */
+class ActorSystems {
+public:
+    static void StorePreviousPositions(ActorRegistry& registry, ActorKind kind);
+    static void SetEnemyTargets(ActorRegistry& registry, float targetX, float targetY);
+
+    // Patrol / chase decisions: AI state, timers and velocity
+    static void UpdateEnemyAI(ActorRegistry& registry, float deltaTime, int firstRow = 0, int rowCount = -1);
+    // Applies velocity for deltaTime, colliding with the registry's map
+    static void Integrate(ActorRegistry& registry, ActorKind kind, float deltaTime, int firstRow = 0, int rowCount = -1);
+    // AI then movement for every enemy
+    static void UpdateEnemies(ActorRegistry& registry, float deltaTime);
+};
+
+#endif // ACTORSYSTEMS_H
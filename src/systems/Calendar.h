@@ -1,10 +1,9 @@
 #ifndef CALENDAR_H
 #define CALENDAR_H
 
+#include "Season.h"
 #include <string>
 
-enum class Season { SPRING, SUMMER, FALL, WINTER };
-
 class Calendar {
 public:
     Calendar();
@@ -1,6 +1,7 @@
 #include "Combat.h"
 #include "../entities/Player.h"
 #include "../entities/Enemy.h"
+#include "../world/SpatialHash.h"
 
 int Combat::CalculateDamage(int attackPower, int defense) {
     int damage = attackPower - defense;
@@ -61,3 +62,39 @@ bool Combat::EnemyContact(Enemy* enemy, Player* player, int attackPower) {
     }
     return false;
 }
+
+bool Combat::PlayerAttack(Player* player, const SpatialHash<Enemy>& enemies, int attackPower,
+                          std::vector<Enemy*>& hitEnemies) {
+    if (!player) return false;
+
+    float px, py, pw, ph;
+    player->GetPosition(px, py);
+    player->GetSize(pw, ph);
+
+    std::vector<Enemy*> nearby;
+    enemies.QueryAABB(px - ATTACK_RANGE / 2, py - ATTACK_RANGE / 2, pw + ATTACK_RANGE, ph + ATTACK_RANGE, nearby);
+
+    bool hitAny = false;
+    for (Enemy* enemy : nearby) {
+        if (PlayerAttack(player, enemy, attackPower)) {
+            hitEnemies.push_back(enemy);
+            hitAny = true;
+        }
+    }
+    return hitAny;
+}
+
+Enemy* Combat::EnemyContact(const SpatialHash<Enemy>& enemies, Player* player, int attackPower) {
+    if (!player) return nullptr;
+
+    float px, py, pw, ph;
+    player->GetPosition(px, py);
+    player->GetSize(pw, ph);
+
+    std::vector<Enemy*> nearby;
+    enemies.QueryAABB(px, py, pw, ph, nearby);
+    for (Enemy* enemy : nearby) {
+        if (EnemyContact(enemy, player, attackPower)) return enemy;
+    }
+    return nullptr;
+}
@@ -1,8 +1,11 @@
 #ifndef COMBAT_H
 #define COMBAT_H
 
+#include <vector>
+
 class Player;
 class Enemy;
+template <typename T> class SpatialHash;
 
 class Combat {
 public:
@@ -18,6 +21,13 @@ public:
     // Enemy damages player on contact
     static bool EnemyContact(Enemy* enemy, Player* player, int attackPower);
 
+    // Grid versions: only enemies filed near the player are tested.
+    // PlayerAttack appends every enemy it hit to hitEnemies.
+    static bool PlayerAttack(Player* player, const SpatialHash<Enemy>& enemies, int attackPower,
+                             std::vector<Enemy*>& hitEnemies);
+    // Returns the enemy that touched the player, or nullptr
+    static Enemy* EnemyContact(const SpatialHash<Enemy>& enemies, Player* player, int attackPower);
+
     // Combat tuning constants
     static constexpr float ATTACK_RANGE = 40.0f;
     static constexpr float DAMAGE_COOLDOWN = 1.0f; // Seconds of invincibility after hit
@@ -1,12 +1,8 @@
 #include "Farming.h"
 
 int FarmingSystem::GetGrowthDays(CropType type) {
-    switch (type) {
-        case CropType::PARSNIP: return 4;
-        case CropType::POTATO:  return 6;
-        case CropType::TOMATO:  return 8;
-        default: return 5;
-    }
+    auto index = static_cast<unsigned int>(type);
+    return index < CROP_TYPE_COUNT ? GROWTH_DAYS[index] : DEFAULT_GROWTH_DAYS;
 }
 
 std::string FarmingSystem::GetCropName(CropType type) {
@@ -1,6 +1,7 @@
 #ifndef FARMING_H
 #define FARMING_H
 
+#include <cstdint>
 #include <string>
 
 enum class CropType { PARSNIP, POTATO, TOMATO };
@@ -16,6 +17,12 @@ public:
 
 class FarmingSystem {
 public:
+    // Growth days per crop type, indexed by CropType. Batch code reads this
+    // table directly instead of calling GetGrowthDays per crop.
+    static constexpr int CROP_TYPE_COUNT = 3;
+    static constexpr std::uint8_t GROWTH_DAYS[CROP_TYPE_COUNT] = { 4, 6, 8 };
+    static constexpr std::uint8_t DEFAULT_GROWTH_DAYS = 5;
+
     // Get days required for a crop type to reach harvest
     static int GetGrowthDays(CropType type);
     // Get the name of a crop type
@@ -47,6 +47,8 @@ public:
                      QuestSystem* quests);
 
     static constexpr const char* DEFAULT_SAVE_PATH = "saves/save.dat";
+    // Generated maps are saved next to it as a delta (see MapFile::SaveDelta)
+    static constexpr const char* DEFAULT_MAP_SAVE_PATH = "saves/world.hqdelta";
 };
 
 #endif // SAVESYSTEM_H
@@ -0,0 +1,7 @@
+#ifndef SEASON_H
+#define SEASON_H
+
+// The four seasons of the farming year, in calendar order
+enum class Season { SPRING, SUMMER, FALL, WINTER };
+
+#endif // SEASON_H
@@ -0,0 +1,308 @@
+#include "ChunkStreamer.h"
+#include "Map.h"
+#include "../engine/Renderer.h"
+#include <algorithm>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <type_traits>
+
+static_assert(std::is_trivially_copyable_v<Tile>, "Chunks are written to disk as raw tile bytes");
+
+ChunkStreamer::ChunkStreamer(Map* map, const ChunkStreamerConfig& config)
+    : m_map(map)
+    , m_config(config)
+    , m_generation(map->GetChunkGeneration())
+    , m_loads(0)
+    , m_evictions(0)
+    , m_stalls(0)
+    , m_swapAvailable(true)
+    , m_stopping(false)
+{
+    std::error_code ec;
+    std::filesystem::create_directories(m_config.swapDirectory, ec);
+    if (ec) {
+        std::cout << "ChunkStreamer: Cannot create swap directory: " << m_config.swapDirectory
+                  << " (chunks stay resident)" << std::endl;
+        m_swapAvailable = false;
+    }
+
+    m_map->SetChunkFaultHandler([this](int chunkX, int chunkY) {
+        m_stalls++;
+        LoadNow(chunkX, chunkY);
+    });
+    m_worker = std::thread(&ChunkStreamer::WorkerLoop, this);
+}
+
+ChunkStreamer::~ChunkStreamer() {
+    // Leave the map whole for whoever uses it next
+    RestoreAll();
+    m_map->SetChunkFaultHandler(nullptr);
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopping = true;
+    }
+    m_wake.notify_all();
+    m_worker.join();
+}
+
+void ChunkStreamer::Update(const Renderer& renderer) {
+    int cameraX, cameraY;
+    renderer.GetCamera(cameraX, cameraY);
+    Update(static_cast<float>(cameraX + renderer.GetWidth() / 2),
+           static_cast<float>(cameraY + renderer.GetHeight() / 2));
+}
+
+void ChunkStreamer::Update(float focusWorldX, float focusWorldY) {
+    if (m_map->GetChunkGeneration() != m_generation) {
+        ResetForGeneration();
+    }
+    ApplyCompletedLoads();
+
+    int tileX, tileY;
+    m_map->WorldToTile(focusWorldX, focusWorldY, tileX, tileY);
+    int focusX = tileX / Map::CHUNK_SIZE;
+    int focusY = tileY / Map::CHUNK_SIZE;
+    int radius = m_config.residencyRadius;
+
+    // Coming into range: ask the worker for it
+    int chunksX = m_map->GetChunksX();
+    int x0 = std::max(focusX - radius, 0), x1 = std::min(focusX + radius, chunksX - 1);
+    int y0 = std::max(focusY - radius, 0), y1 = std::min(focusY + radius, m_map->GetChunksY() - 1);
+    for (int cy = y0; cy <= y1; ++cy) {
+        for (int cx = x0; cx <= x1; ++cx) {
+            int index = cy * chunksX + cx;
+            if (m_map->IsChunkEvicted(cx, cy) && m_loadsRequested.count(index) == 0) {
+                std::uint32_t serial = m_evictSerial[index];
+                m_loadsRequested[index] = serial;
+                {
+                    std::lock_guard<std::mutex> lock(m_mutex);
+                    m_jobs.push_back(Job{JobType::LOAD, index, m_generation, serial, nullptr});
+                }
+                m_wake.notify_one();
+            }
+        }
+    }
+    if (!m_swapAvailable) return;
+
+    // Only allocated chunks can be evicted; copied because Evict shrinks the list
+    std::vector<std::pair<int, int>> ring;   // (distance, chunk index) just outside the radius
+    m_candidates = m_map->GetAllocatedChunkIndices();
+    for (int index : m_candidates) {
+        int cx = index % chunksX;
+        int cy = index / chunksX;
+        int distance = std::max(std::abs(cx - focusX), std::abs(cy - focusY));
+        if (distance <= radius) continue;
+        if (distance > radius + EVICT_HYSTERESIS) {
+            Evict(cx, cy);
+        } else {
+            ring.emplace_back(distance, index);
+        }
+    }
+
+    // Over budget: give up the farthest chunks in the hysteresis ring too
+    int excess = GetResidentChunkCount() - ResidencyBudget();
+    if (excess > 0 && !ring.empty()) {
+        std::sort(ring.begin(), ring.end(), [](const auto& a, const auto& b) { return a.first > b.first; });
+        for (int i = 0; i < excess && i < static_cast<int>(ring.size()); ++i) {
+            int index = ring[i].second;
+            Evict(index % chunksX, index / chunksX);
+        }
+    }
+}
+
+void ChunkStreamer::RestoreAll() {
+    if (m_map->GetChunkGeneration() != m_generation) {
+        ResetForGeneration();
+    }
+    for (int cy = 0; cy < m_map->GetChunksY(); ++cy) {
+        for (int cx = 0; cx < m_map->GetChunksX(); ++cx) {
+            if (m_map->IsChunkEvicted(cx, cy)) {
+                LoadNow(cx, cy);
+            }
+        }
+    }
+}
+
+int ChunkStreamer::GetResidentChunkCount() const {
+    return m_map->GetAllocatedChunkCount();
+}
+
+int ChunkStreamer::GetPendingJobCount() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return static_cast<int>(m_jobs.size());
+}
+
+void ChunkStreamer::WorkerLoop() {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (true) {
+        m_wake.wait(lock, [this] { return m_stopping || !m_jobs.empty(); });
+        if (m_stopping) return;
+
+        Job job = std::move(m_jobs.front());
+        m_jobs.pop_front();
+        lock.unlock();
+
+        if (job.type == JobType::SAVE) {
+            bool written = WriteChunk(job.chunkIndex, *job.chunk);
+            lock.lock();
+            auto it = m_savesInFlight.find(SaveKey(job.generation, job.chunkIndex));
+            if (it != m_savesInFlight.end() && --it->second == 0) {
+                m_savesInFlight.erase(it);
+            }
+            if (!written) {
+                // Hand the chunk back rather than lose it
+                m_completed.push_back(std::move(job));
+            }
+            m_saveDone.notify_all();
+        } else {
+            job.chunk = ReadChunk(job.chunkIndex);
+            lock.lock();
+            m_completed.push_back(std::move(job));
+        }
+    }
+}
+
+void ChunkStreamer::ResetForGeneration() {
+    // The map was rebuilt; nothing queued for the old layout applies any more
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_jobs.clear();
+        m_completed.clear();
+        m_savesInFlight.clear();   // A write still running finds nothing to settle
+    }
+    m_evictSerial.clear();
+    m_pinned.clear();
+    m_loadsRequested.clear();
+    m_generation = m_map->GetChunkGeneration();
+}
+
+void ChunkStreamer::ApplyCompletedLoads() {
+    std::vector<Job> completed;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        completed.swap(m_completed);
+    }
+
+    for (auto& job : completed) {
+        if (job.generation != m_generation) continue;
+        // A SAVE coming back means its write failed: keep that chunk from now on
+        if (job.type == JobType::SAVE) m_pinned.insert(job.chunkIndex);
+        // A chunk evicted again since this load was requested waits for a fresh one
+        if (m_evictSerial[job.chunkIndex] != job.evictSerial) continue;
+
+        int cx = job.chunkIndex % m_map->GetChunksX();
+        int cy = job.chunkIndex / m_map->GetChunksX();
+        if (m_map->IsChunkEvicted(cx, cy)) {
+            // A failed read restores fill tiles rather than retrying forever
+            m_map->RestoreChunk(cx, cy, std::move(job.chunk));
+            m_loads++;
+        }
+        m_loadsRequested.erase(job.chunkIndex);
+    }
+}
+
+void ChunkStreamer::Evict(int chunkX, int chunkY) {
+    int index = chunkY * m_map->GetChunksX() + chunkX;
+    if (m_pinned.count(index) != 0) return;
+    std::unique_ptr<TileChunk> chunk = m_map->EvictChunk(chunkX, chunkY);
+    if (!chunk) return;
+
+    std::uint32_t serial = ++m_evictSerial[index];
+    m_loadsRequested.erase(index);
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_savesInFlight[SaveKey(m_generation, index)]++;
+        m_jobs.push_back(Job{JobType::SAVE, index, m_generation, serial, std::move(chunk)});
+    }
+    m_wake.notify_one();
+    m_evictions++;
+}
+
+void ChunkStreamer::LoadNow(int chunkX, int chunkY) {
+    int index = chunkY * m_map->GetChunksX() + chunkX;
+    std::uint32_t serial = m_evictSerial[index];
+    std::unique_ptr<TileChunk> chunk;
+    bool found = false;
+
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+
+        // Not written yet: take it straight out of the queue
+        for (auto it = m_jobs.begin(); it != m_jobs.end(); ++it) {
+            if (it->type == JobType::SAVE && it->chunkIndex == index && it->generation == m_generation) {
+                chunk = std::move(it->chunk);
+                m_jobs.erase(it);
+                auto inFlight = m_savesInFlight.find(SaveKey(m_generation, index));
+                if (inFlight != m_savesInFlight.end() && --inFlight->second == 0) {
+                    m_savesInFlight.erase(inFlight);
+                }
+                found = true;
+                break;
+            }
+        }
+
+        // Already read back (or handed back after a failed write)
+        if (!found) {
+            for (auto it = m_completed.begin(); it != m_completed.end(); ++it) {
+                if (it->chunkIndex == index && it->generation == m_generation &&
+                    it->evictSerial == serial && it->chunk) {
+                    if (it->type == JobType::SAVE) m_pinned.insert(index);
+                    chunk = std::move(it->chunk);
+                    m_completed.erase(it);
+                    found = true;
+                    break;
+                }
+            }
+        }
+
+        // Mid-write: wait for the file to be complete
+        if (!found) {
+            std::uint64_t key = SaveKey(m_generation, index);
+            m_saveDone.wait(lock, [this, key] { return m_savesInFlight.count(key) == 0; });
+        }
+    }
+
+    if (!found) {
+        chunk = ReadChunk(index);
+    }
+    m_map->RestoreChunk(chunkX, chunkY, std::move(chunk));
+    m_loadsRequested.erase(index);
+}
+
+int ChunkStreamer::ResidencyBudget() const {
+    int diameter = m_config.residencyRadius * 2 + 1;
+    int byMemory = static_cast<int>(m_config.memoryBudgetBytes / sizeof(TileChunk));
+    return std::max(byMemory, diameter * diameter);
+}
+
+std::string ChunkStreamer::ChunkPath(int chunkIndex) const {
+    return m_config.swapDirectory + "/chunk_" + std::to_string(chunkIndex) + ".bin";
+}
+
+bool ChunkStreamer::WriteChunk(int chunkIndex, const TileChunk& chunk) const {
+    std::ofstream file(ChunkPath(chunkIndex), std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) {
+        std::cout << "ChunkStreamer: Cannot write chunk file: " << ChunkPath(chunkIndex) << std::endl;
+        return false;
+    }
+    file.write(reinterpret_cast<const char*>(chunk.tiles), sizeof(chunk.tiles));
+    return file.good();
+}
+
+std::unique_ptr<TileChunk> ChunkStreamer::ReadChunk(int chunkIndex) const {
+    std::ifstream file(ChunkPath(chunkIndex), std::ios::binary);
+    if (!file.is_open()) {
+        std::cout << "ChunkStreamer: Cannot read chunk file: " << ChunkPath(chunkIndex) << std::endl;
+        return nullptr;
+    }
+    auto chunk = std::make_unique<TileChunk>();
+    file.read(reinterpret_cast<char*>(chunk->tiles), sizeof(chunk->tiles));
+    if (!file) {
+        std::cout << "ChunkStreamer: Truncated chunk file: " << ChunkPath(chunkIndex) << std::endl;
+        return nullptr;
+    }
+    return chunk;
+}
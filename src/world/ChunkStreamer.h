@@ -0,0 +1,123 @@
+#ifndef CHUNKSTREAMER_H
+#define CHUNKSTREAMER_H
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+class Map;
+class Renderer;
+struct TileChunk;
+
+struct ChunkStreamerConfig {
+    int residencyRadius = 2;                            // Chunks kept resident around the focus
+    std::size_t memoryBudgetBytes = 4 * 1024 * 1024;    // Soft cap on resident chunk memory
+    std::string swapDirectory = "saves/chunks";         // Where evicted chunks are written
+};
+
+/**
+ * ChunkStreamer - keeps only the chunks around the camera resident
+ *
+ * Each Update() looks at the chunks around the focus point. Chunks that
+ * drift outside the residency radius (or push resident memory over budget)
+ * are detached from the Map and written to the swap directory by a worker
+ * thread. Evicted chunks that come back into range are read back on the
+ * same thread and reattached on a later Update(), so the game loop never
+ * waits on disk.
+ *
+ * If game code touches an evicted chunk before it has come back, the Map
+ * calls into the streamer, which loads that chunk on the spot. Each such
+ * load is counted as a stall.
+ *
+ * A chunk whose write fails is handed back and kept resident until the map
+ * is rebuilt; if the swap directory cannot be created, nothing is evicted.
+ */
+class ChunkStreamer {
+public:
+    ChunkStreamer(Map* map, const ChunkStreamerConfig& config = ChunkStreamerConfig());
+    ~ChunkStreamer();
+
+    ChunkStreamer(const ChunkStreamer&) = delete;
+    ChunkStreamer& operator=(const ChunkStreamer&) = delete;
+
+    // Stream around the centre of the renderer's current camera view
+    void Update(const Renderer& renderer);
+    // Stream around an explicit world position
+    void Update(float focusWorldX, float focusWorldY);
+
+    // Bring every evicted chunk back synchronously (e.g. before a full save)
+    void RestoreAll();
+
+    const ChunkStreamerConfig& GetConfig() const { return m_config; }
+
+    // Counters
+    int GetLoadCount() const { return m_loads; }
+    int GetEvictionCount() const { return m_evictions; }
+    int GetStallCount() const { return m_stalls; }
+    bool IsSwapAvailable() const { return m_swapAvailable; }
+    int GetResidentChunkCount() const;
+    int GetPendingJobCount() const;
+
+private:
+    enum class JobType { SAVE, LOAD };
+
+    struct Job {
+        JobType type;
+        int chunkIndex;
+        std::uint32_t generation;
+        std::uint32_t evictSerial;       // Which eviction a LOAD is answering
+        std::unique_ptr<TileChunk> chunk;
+    };
+
+    void WorkerLoop();
+    void ResetForGeneration();
+    void ApplyCompletedLoads();
+    void Evict(int chunkX, int chunkY);
+    void LoadNow(int chunkX, int chunkY);        // Synchronous; the caller counts stalls
+    int ResidencyBudget() const;
+
+    std::string ChunkPath(int chunkIndex) const;
+    // Saves are counted per generation, so a write still running for an old
+    // map never settles the count of the same index in the new one
+    static std::uint64_t SaveKey(std::uint32_t generation, int chunkIndex) {
+        return (static_cast<std::uint64_t>(generation) << 32) | static_cast<std::uint32_t>(chunkIndex);
+    }
+    bool WriteChunk(int chunkIndex, const TileChunk& chunk) const;
+    std::unique_ptr<TileChunk> ReadChunk(int chunkIndex) const;
+
+    Map* m_map;
+    ChunkStreamerConfig m_config;
+    std::uint32_t m_generation;
+
+    // Main-thread bookkeeping
+    std::unordered_map<int, std::uint32_t> m_evictSerial;   // Chunk index -> eviction count
+    std::unordered_map<int, std::uint32_t> m_loadsRequested; // Chunk index -> serial the load answers
+    std::unordered_set<int> m_pinned;                        // Chunks whose write failed; not evicted again this map
+    std::vector<int> m_candidates;                           // Update scratch: allocated chunks this frame
+    int m_loads;
+    int m_evictions;
+    int m_stalls;
+    bool m_swapAvailable;
+
+    // Shared with the worker (guarded by m_mutex)
+    mutable std::mutex m_mutex;
+    std::condition_variable m_wake;
+    std::condition_variable m_saveDone;
+    std::deque<Job> m_jobs;
+    std::vector<Job> m_completed;
+    std::unordered_map<std::uint64_t, int> m_savesInFlight; // SaveKey -> unwritten saves
+    bool m_stopping;
+    std::thread m_worker;
+
+    static constexpr int EVICT_HYSTERESIS = 1;   // Extra ring kept before evicting
+};
+
+#endif // CHUNKSTREAMER_H
@@ -53,9 +53,9 @@ void Dungeon::LockDoors() {
     m_doorsLocked = true;
     if (!m_map) return;
     for (const auto& pos : m_doorPositions) {
-        Tile* tile = m_map->GetTileAt(pos.first, pos.second);
+        const Tile* tile = m_map->GetTileAt(pos.first, pos.second);
         if (tile) {
-            tile->SetType(TileType::WALL);
+            m_map->SetTile(pos.first, pos.second, Tile(TileType::WALL, tile->GetVisualId()));
         }
     }
 }
@@ -64,9 +64,9 @@ void Dungeon::UnlockDoors() {
     m_doorsLocked = false;
     if (!m_map) return;
     for (const auto& pos : m_doorPositions) {
-        Tile* tile = m_map->GetTileAt(pos.first, pos.second);
+        const Tile* tile = m_map->GetTileAt(pos.first, pos.second);
         if (tile) {
-            tile->SetType(TileType::DOOR);
+            m_map->SetTile(pos.first, pos.second, Tile(TileType::DOOR, tile->GetVisualId()));
         }
     }
 }
@@ -0,0 +1,101 @@
+#include "FlowField.h"
+#include "Map.h"
+#include <algorithm>
+#include <limits>
+
+FlowField::FlowField()
+    : m_width(0)
+    , m_height(0)
+    , m_targetX(-1)
+    , m_targetY(-1)
+    , m_built(false)
+    , m_stamp(0)
+{
+}
+
+void FlowField::Clear() {
+    m_built = false;
+    m_targetX = -1;
+    m_targetY = -1;
+    m_queue.clear();
+}
+
+void FlowField::Build(const Map& map, int targetX, int targetY, int maxSteps) {
+    const SolidityGrid& solidity = map.GetSolidityGrid();
+    int width = solidity.GetWidth();
+    int height = solidity.GetHeight();
+    if (width != m_width || height != m_height) {
+        m_width = width;
+        m_height = height;
+        m_stamps.assign(static_cast<std::size_t>(width) * height, 0);
+        m_distance.assign(static_cast<std::size_t>(width) * height, 0);
+        m_stamp = 0;
+    }
+
+    // Fresh stamp so the previous build's entries read as unset
+    if (++m_stamp == 0) {
+        std::fill(m_stamps.begin(), m_stamps.end(), 0);
+        m_stamp = 1;
+    }
+    m_targetX = targetX;
+    m_targetY = targetY;
+    m_built = true;
+    m_queue.clear();
+
+    // The target itself may be solid (the player's box can overlap a wall tile),
+    // but the search only spreads across open tiles
+    if (targetX < 0 || targetY < 0 || targetX >= width || targetY >= height) return;
+    maxSteps = std::clamp(maxSteps, 0, static_cast<int>(std::numeric_limits<std::uint16_t>::max()));
+
+    int start = Index(targetX, targetY);
+    m_stamps[start] = m_stamp;
+    m_distance[start] = 0;
+    m_queue.push_back(start);
+
+    static constexpr int DX[4] = { 1, -1, 0, 0 };
+    static constexpr int DY[4] = { 0, 0, 1, -1 };
+    for (std::size_t head = 0; head < m_queue.size(); ++head) {
+        int index = m_queue[head];
+        int steps = m_distance[index];
+        if (steps >= maxSteps) continue;
+        int x = index % width;
+        int y = index / width;
+        for (int dir = 0; dir < 4; ++dir) {
+            int nx = x + DX[dir];
+            int ny = y + DY[dir];
+            if (solidity.IsSolid(nx, ny)) continue;   // Also rejects off-grid tiles
+            int next = Index(nx, ny);
+            if (m_stamps[next] == m_stamp) continue;
+            m_stamps[next] = m_stamp;
+            m_distance[next] = static_cast<std::uint16_t>(steps + 1);
+            m_queue.push_back(next);
+        }
+    }
+}
+
+int FlowField::GetDistance(int x, int y) const {
+    if (!m_built || x < 0 || y < 0 || x >= m_width || y >= m_height) return -1;
+    int index = Index(x, y);
+    return m_stamps[index] == m_stamp ? m_distance[index] : -1;
+}
+
+bool FlowField::GetNextTile(int x, int y, int& nextX, int& nextY) const {
+    int here = GetDistance(x, y);
+    if (here <= 0) return false;
+
+    // Orthogonal neighbours first, so ties prefer straight steps
+    static constexpr int DX[8] = { 1, -1, 0, 0, 1, 1, -1, -1 };
+    static constexpr int DY[8] = { 0, 0, 1, -1, 1, -1, 1, -1 };
+    int best = here;
+    for (int dir = 0; dir < 8; ++dir) {
+        int nx = x + DX[dir];
+        int ny = y + DY[dir];
+        int distance = GetDistance(nx, ny);
+        if (distance < 0 || distance >= best) continue;
+        if (dir >= 4 && (GetDistance(nx, y) < 0 || GetDistance(x, ny) < 0)) continue;
+        best = distance;
+        nextX = nx;
+        nextY = ny;
+    }
+    return best < here;
+}
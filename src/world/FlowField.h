@@ -0,0 +1,56 @@
+#ifndef FLOWFIELD_H
+#define FLOWFIELD_H
+
+#include <cstdint>
+#include <vector>
+
+class Map;
+
+/**
+ * FlowField - step distances from every reachable tile to one target tile
+ *
+ * Built with a single breadth-first search outward from the target over the
+ * map's SolidityGrid, so any number of chasers can share it: each one just
+ * steps to its lowest-distance neighbour. Rebuilding is only needed when the
+ * target moves to another tile.
+ *
+ * The search stops maxSteps tiles out. Tiles past that, behind walls, or
+ * outside the map have no distance. Per-tile stamps mark which entries belong
+ * to the current build, so a rebuild only costs the tiles it reaches.
+ */
+class FlowField {
+public:
+    static constexpr int DEFAULT_MAX_STEPS = 48;
+
+    FlowField();
+
+    void Build(const Map& map, int targetX, int targetY, int maxSteps = DEFAULT_MAX_STEPS);
+    void Clear();
+
+    bool IsBuilt() const { return m_built; }
+    bool IsTarget(int x, int y) const { return m_built && x == m_targetX && y == m_targetY; }
+    int GetTargetX() const { return m_targetX; }
+    int GetTargetY() const { return m_targetY; }
+    int GetVisitedCount() const { return static_cast<int>(m_queue.size()); }
+
+    // Steps to the target, or -1 if the tile was not reached
+    int GetDistance(int x, int y) const;
+
+    // Neighbour to move to from (x, y). Diagonal steps are only taken when
+    // both tiles beside them are open, so a chaser never clips a corner.
+    // False at the target and for tiles that were not reached.
+    bool GetNextTile(int x, int y, int& nextX, int& nextY) const;
+
+private:
+    int m_width, m_height;
+    int m_targetX, m_targetY;
+    bool m_built;
+    std::uint32_t m_stamp;                  // Current build; entries with an older stamp are unset
+    std::vector<std::uint32_t> m_stamps;
+    std::vector<std::uint16_t> m_distance;
+    std::vector<int> m_queue;               // BFS order; kept to reuse its allocation
+
+    int Index(int x, int y) const { return y * m_width + x; }
+};
+
+#endif // FLOWFIELD_H
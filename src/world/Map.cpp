@@ -1,30 +1,55 @@
 #include "Map.h"
+#include "MapFile.h"
 #include "../engine/Renderer.h"
 #include "../engine/SpriteSheet.h"
 #include "../engine/TilesetConfig.h"
-#include "../systems/Calendar.h"
+#include "../systems/Farming.h"
+#include "../systems/Season.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
 #include <iostream>
+#include <limits>
 #include <fstream>
 #include <sstream>
+#include <thread>
+
+struct Map::BakedChunk {
+    std::uint32_t target = 0;               // Renderer target handle; 0 while not baked
+    int width = 0, height = 0;              // Target size in pixels
+    std::uint32_t revision = 0;             // Chunk revision the texture shows
+    std::vector<std::uint16_t> animated;    // Local indices of water and crop tiles, drawn every frame
+};
 
 Map::Map()
-    : m_width(25)
-    , m_height(19)
+    : m_width(0)
+    , m_height(0)
+    , m_chunksX(0)
+    , m_chunksY(0)
+    , m_fillTile(TileType::GRASS, 0)
 {
-    m_tiles.resize(m_width * m_height, Tile(TileType::GRASS, 0));
+    ResetChunks(25, 19);
 }
 
 Map::Map(int width, int height)
-    : m_width(width)
-    , m_height(height)
+    : m_width(0)
+    , m_height(0)
+    , m_chunksX(0)
+    , m_chunksY(0)
+    , m_fillTile(TileType::GRASS, 0)
 {
-    m_tiles.resize(m_width * m_height, Tile(TileType::GRASS, 0));
+    ResetChunks(width, height);
 }
 
 Map::~Map() {
+    ReleaseBakedChunks();
 }
 
 bool Map::LoadFromFile(const std::string& filepath) {
+    if (MapFile::IsBinaryFile(filepath)) {
+        return MapFile::Load(*this, filepath);
+    }
+
     std::ifstream file(filepath);
     if (!file.is_open()) {
         std::cout << "Map: Cannot open file: " << filepath << std::endl;
@@ -52,10 +77,7 @@ bool Map::LoadFromFile(const std::string& filepath) {
     }
 
     // Prepare tile storage
-    m_width = width;
-    m_height = height;
-    m_tiles.clear();
-    m_tiles.resize(m_width * m_height, Tile(TileType::GRASS, 0));
+    ResetChunks(width, height);
 
     // Read tile data
     while (std::getline(file, line)) {
@@ -69,24 +91,28 @@ bool Map::LoadFromFile(const std::string& filepath) {
             int x, y, typeInt, visualId;
             iss >> x >> y >> typeInt >> visualId;
             if (IsValidPosition(x, y)) {
-                auto type = static_cast<TileType>(typeInt);
-                Tile tile(type, visualId);
-
                 // Optional: soil state and crop data
+                FarmPlot plot;
                 int soilInt = -1;
                 int cropType = -1;
                 int growthStage = 0;
-                if (iss >> soilInt) {
-                    tile.SetSoilState(static_cast<SoilState>(soilInt));
+                bool hasSoil = static_cast<bool>(iss >> soilInt);
+                if (!MapFile::IsValidTileType(typeInt) || (hasSoil && !MapFile::IsValidSoilState(soilInt))) {
+                    std::cout << "Map: Skipping TILE with invalid type or soil state: " << line << std::endl;
+                    continue;
+                }
+                if (hasSoil) {
+                    plot.SetSoilState(static_cast<SoilState>(soilInt));
                 }
                 if (iss >> cropType) {
-                    tile.SetCropType(cropType);
+                    plot.SetCropType(cropType);
                 }
                 if (iss >> growthStage) {
-                    tile.SetGrowthStage(growthStage);
+                    plot.SetGrowthStage(growthStage);
                 }
 
-                m_tiles[GetIndex(x, y)] = tile;
+                SetTile(x, y, Tile(static_cast<TileType>(typeInt), visualId));
+                SetFarmPlot(x, y, plot);
             }
         }
     }
@@ -97,6 +123,12 @@ bool Map::LoadFromFile(const std::string& filepath) {
 }
 
 bool Map::SaveToFile(const std::string& filepath) const {
+    const std::string binaryExt = MapFile::EXTENSION;
+    if (filepath.size() >= binaryExt.size() &&
+        filepath.compare(filepath.size() - binaryExt.size(), binaryExt.size(), binaryExt) == 0) {
+        return MapFile::Save(*this, filepath);
+    }
+
     std::ofstream file(filepath);
     if (!file.is_open()) {
         std::cout << "Map: Cannot open file for writing: " << filepath << std::endl;
@@ -110,12 +142,15 @@ bool Map::SaveToFile(const std::string& filepath) const {
         for (int x = 0; x < m_width; ++x) {
             const Tile* tile = GetTileAt(x, y);
             if (!tile) continue;
+            const FarmPlot* plot = GetFarmPlot(x, y);
+            FarmPlot empty;
+            if (!plot) plot = &empty;
             file << "TILE " << x << " " << y << " "
                  << static_cast<int>(tile->GetType()) << " "
                  << tile->GetVisualId() << " "
-                 << static_cast<int>(tile->GetSoilState()) << " "
-                 << tile->GetCropType() << " "
-                 << tile->GetGrowthStage() << "\n";
+                 << static_cast<int>(plot->GetSoilState()) << " "
+                 << plot->GetCropType() << " "
+                 << plot->GetGrowthStage() << "\n";
         }
     }
 
@@ -132,9 +167,155 @@ void Map::Update(float deltaTime) {
         m_waterAnimFrame = (m_waterAnimFrame + 1) % WATER_ANIM_FRAMES;
     }
     
-    // Update all tiles (for animations, crop growth, etc.)
-    for (auto& tile : m_tiles) {
-        tile.Update(deltaTime);
+    // Fire whatever tile events came due this frame
+    m_dueEvents.clear();
+    m_timers.Advance(deltaTime, m_dueEvents);
+    for (const auto& event : m_dueEvents) {
+        auto it = m_liveEvents.find(EventKey(event.tileIndex, event.type));
+        if (it == m_liveEvents.end() || it->second != event.serial) continue;  // Superseded
+        m_liveEvents.erase(it);
+        HandleTileEvent(event);
+    }
+}
+
+namespace {
+
+// Growth days indexed by the low byte of a plot's crop type, so the batch
+// kernel never branches on the type. No-crop (-1) and unknown types map to
+// the default.
+const std::array<std::uint8_t, 256> s_growthDaysByCrop = [] {
+    std::array<std::uint8_t, 256> table{};
+    table.fill(FarmingSystem::DEFAULT_GROWTH_DAYS);
+    for (int i = 0; i < FarmingSystem::CROP_TYPE_COUNT; ++i) {
+        table[i] = FarmingSystem::GROWTH_DAYS[i];
+    }
+    return table;
+}();
+
+// Mapping used when no config is given: the world_tileset.png layout
+const TilesetConfig& DefaultTileset() {
+    static const TilesetConfig tileset = [] {
+        TilesetConfig defaults;
+        defaults.LoadDefaults();
+        return defaults;
+    }();
+    return tileset;
+}
+
+// Flat colour per tile type for drawing without art
+Color FallbackColor(TileType type) {
+    switch (type) {
+        case TileType::VOID:       return Color{20, 20, 20, 255};
+        case TileType::FLOOR:      return Color{80, 80, 80, 255};
+        case TileType::WALL:       return Color{60, 60, 70, 255};
+        case TileType::DOOR:       return Color{100, 60, 30, 255};
+        case TileType::WATER:      return Color{50, 100, 200, 255};
+        case TileType::SOIL:       return Color{90, 60, 30, 255};
+        case TileType::CROP:       return Color{50, 150, 50, 255};
+        case TileType::GRASS:      return Color{50, 100, 50, 255};
+        case TileType::DIRT:       return Color{120, 90, 60, 255};
+        case TileType::STONE:      return Color{100, 100, 110, 255};
+        case TileType::SAND:       return Color{194, 178, 128, 255};
+        case TileType::DECORATION: return Color{30, 140, 30, 255};
+        case TileType::TREE:       return Color{20, 80, 20, 255};
+        case TileType::COUNT:      break;
+    }
+    return Color{50, 100, 50, 255};
+}
+
+} // namespace
+
+void Map::AdvanceDay() {
+    const int count = static_cast<int>(m_growingTiles.size());
+    if (count == 0) return;
+
+    int bands = 1;
+    if (count >= PARALLEL_GROWTH_MIN_CROPS) {
+        bands = std::clamp(static_cast<int>(std::thread::hardware_concurrency()), 1, MAX_GROWTH_THREADS);
+        bands = std::min(bands, m_height);
+    }
+    std::vector<std::vector<int>> ripe(bands);
+
+    if (bands == 1) {
+        GrowCropBand(m_growingTiles.data(), m_growingPlots.data(), count, ripe[0]);
+    } else {
+        // Bucket the active set by row band (one counting-sort pass) so each
+        // band is a contiguous slice handed to its own thread
+        m_nightTiles.resize(count);
+        m_nightPlots.resize(count);
+        std::vector<int> bandStart(bands + 1, 0);
+        auto bandOf = [this, bands](int index) { return (index / m_width) * bands / m_height; };
+        for (int index : m_growingTiles) {
+            bandStart[bandOf(index) + 1]++;
+        }
+        for (int b = 0; b < bands; ++b) {
+            bandStart[b + 1] += bandStart[b];
+        }
+        std::vector<int> cursor(bandStart.begin(), bandStart.end() - 1);
+        for (int i = 0; i < count; ++i) {
+            int slot = cursor[bandOf(m_growingTiles[i])]++;
+            m_nightTiles[slot] = m_growingTiles[i];
+            m_nightPlots[slot] = m_growingPlots[i];
+        }
+
+        std::vector<std::thread> workers;
+        for (int b = 0; b < bands; ++b) {
+            int begin = bandStart[b];
+            int size = bandStart[b + 1] - begin;
+            if (size == 0) continue;
+            workers.emplace_back([this, begin, size, &ripe, b] {
+                GrowCropBand(m_nightTiles.data() + begin, m_nightPlots.data() + begin, size, ripe[b]);
+            });
+        }
+        for (auto& worker : workers) {
+            worker.join();
+        }
+    }
+
+    // Ripe crops leave the active set and drop their growth timers
+    for (const auto& band : ripe) {
+        for (int index : band) {
+            UnregisterGrowing(index);
+            m_liveEvents.erase(EventKey(index, TileEventType::CROP_GROWTH));
+        }
+    }
+}
+
+void Map::GrowCropBand(const int* tiles, FarmPlot* const* plots, int count, std::vector<int>& ripeTiles) {
+    // Work in small blocks so the gathered bytes stay in L1 between passes
+    constexpr int BLOCK = 256;
+    std::uint8_t stages[BLOCK];
+    std::uint8_t days[BLOCK];
+    std::uint8_t ripe[BLOCK];
+
+    for (int base = 0; base < count; base += BLOCK) {
+        const int n = std::min(BLOCK, count - base);
+        FarmPlot* const* blockPlots = plots + base;
+
+        // Gather
+        for (int i = 0; i < n; ++i) {
+            const FarmPlot* plot = blockPlots[i];
+            stages[i] = static_cast<std::uint8_t>(std::min(plot->GetGrowthStage(), 254));
+            days[i] = s_growthDaysByCrop[static_cast<std::uint8_t>(plot->GetCropType())];
+        }
+
+        // Kernel: branch-free over contiguous bytes so it vectorizes
+        for (int i = 0; i < n; ++i) {
+            std::uint8_t next = static_cast<std::uint8_t>(stages[i] + 1);
+            std::uint8_t done = next >= days[i];
+            ripe[i] = done;
+            stages[i] = done ? static_cast<std::uint8_t>(FarmPlot::MAX_GROWTH_STAGE) : next;
+        }
+
+        // Scatter
+        for (int i = 0; i < n; ++i) {
+            FarmPlot* plot = blockPlots[i];
+            plot->SetGrowthStage(stages[i]);
+            if (ripe[i]) {
+                plot->SetSoilState(SoilState::HARVEST);
+                ripeTiles.push_back(tiles[base + i]);
+            }
+        }
     }
 }
 
@@ -144,52 +325,13 @@ void Map::Render(Renderer* renderer) {
 }
 
 void Map::RenderTileFallback(Renderer* renderer, const Tile* tile, int screenX, int screenY) {
-    unsigned char r = 50, g = 100, b = 50;  // Default grass
-    
-    switch (tile->GetType()) {
-        case TileType::VOID:
-            r = 20; g = 20; b = 20;
-            break;
-        case TileType::FLOOR:
-            r = 80; g = 80; b = 80;
-            break;
-        case TileType::WALL:
-            r = 60; g = 60; b = 70;
-            break;
-        case TileType::DOOR:
-            r = 100; g = 60; b = 30;
-            break;
-        case TileType::WATER:
-            r = 50; g = 100; b = 200;
-            break;
-        case TileType::SOIL:
-            r = 90; g = 60; b = 30;
-            break;
-        case TileType::CROP:
-            r = 50; g = 150; b = 50;
-            break;
-        case TileType::GRASS:
-            r = 50; g = ((screenX/TILE_SIZE + screenY/TILE_SIZE) % 2 == 0) ? 100 : 120; b = 50;
-            break;
-        case TileType::DIRT:
-            r = 120; g = 90; b = 60;
-            break;
-        case TileType::STONE:
-            r = 100; g = 100; b = 110;
-            break;
-        case TileType::SAND:
-            r = 194; g = 178; b = 128;
-            break;
-        case TileType::DECORATION:
-            r = 30; g = 140; b = 30;
-            break;
-        case TileType::TREE:
-            r = 20; g = 80; b = 20;
-            break;
+    Color color = FallbackColor(tile->GetType());
+    if (tile->GetType() == TileType::GRASS && (screenX/TILE_SIZE + screenY/TILE_SIZE) % 2 != 0) {
+        color.g = 120;   // Checkerboard
     }
     
-    renderer->FillRect(screenX, screenY, TILE_SIZE, TILE_SIZE, r, g, b);
-    renderer->DrawRect(screenX, screenY, TILE_SIZE, TILE_SIZE, r/2, g/2, b/2);
+    renderer->FillRect(screenX, screenY, TILE_SIZE, TILE_SIZE, color.r, color.g, color.b);
+    renderer->DrawRect(screenX, screenY, TILE_SIZE, TILE_SIZE, color.r/2, color.g/2, color.b/2);
 
     // Draw tree trunk and canopy on top of base tile
     if (tile->GetType() == TileType::TREE) {
@@ -201,99 +343,446 @@ void Map::RenderTileFallback(Renderer* renderer, const Tile* tile, int screenX,
     }
 }
 
-int Map::GetTileSpriteId(const Tile* tile) const {
-    // Map semantic tile types to sprite sheet tile IDs
-    // Tileset: 32x32 pixel tiles in a 16-column grid
-    // IDs match the world_tileset.png layout
-    
-    switch (tile->GetType()) {
-        case TileType::GRASS:      return 0;
-        case TileType::DIRT:       return 1;
-        case TileType::SOIL:       return 2;
-        case TileType::WATER:      return WATER_FRAME_IDS[m_waterAnimFrame];
-        case TileType::STONE:      return 4;
-        case TileType::SAND:       return 5;
-        case TileType::FLOOR:      return 6;
-        case TileType::WALL:       return 7 + tile->GetVisualId();
-        case TileType::DOOR:       return 20;
-        case TileType::CROP:       return 30 + tile->GetGrowthStage();
-        case TileType::DECORATION: return 40 + tile->GetVisualId();
-        case TileType::TREE:       return 50;
-        default:                   return 0;
+Image Map::GenerateFallbackTileset() {
+    const TilesetConfig& layout = DefaultTileset();
+    Image image = GenImageColor(FALLBACK_SHEET_COLUMNS * TILE_SIZE, FALLBACK_SHEET_ROWS * TILE_SIZE, BLANK);
+    std::vector<std::uint8_t> painted(FALLBACK_SHEET_COLUMNS * FALLBACK_SHEET_ROWS, 0);
+
+    // Every type's first sprite before any type's later variants, so a run of
+    // wall or crop variants never paints over the next type's base sprite.
+    // Grass before VOID, which shares its sprite in the default layout.
+    static constexpr TileType PAINT_ORDER[] = {
+        TileType::GRASS, TileType::DIRT, TileType::SOIL, TileType::WATER, TileType::STONE,
+        TileType::SAND, TileType::FLOOR, TileType::WALL, TileType::DOOR, TileType::CROP,
+        TileType::DECORATION, TileType::TREE, TileType::VOID
+    };
+    for (int variant = 0; variant < FALLBACK_SHEET_COLUMNS; ++variant) {
+        for (TileType type : PAINT_ORDER) {
+            int id = layout.GetTileSpriteId(type, Season::SPRING, variant);
+            if (id < 0 || id >= static_cast<int>(painted.size()) || painted[id]) continue;
+            painted[id] = 1;
+
+            Color color = FallbackColor(type);
+            if (type == TileType::WATER) {
+                color.b = static_cast<unsigned char>(color.b - 10 * variant);   // A little shimmer between frames
+            }
+            int x = (id % FALLBACK_SHEET_COLUMNS) * TILE_SIZE;
+            int y = (id / FALLBACK_SHEET_COLUMNS) * TILE_SIZE;
+            ImageDrawRectangle(&image, x, y, TILE_SIZE, TILE_SIZE, color);
+            Rectangle outline = { static_cast<float>(x), static_cast<float>(y),
+                                  static_cast<float>(TILE_SIZE), static_cast<float>(TILE_SIZE) };
+            ImageDrawRectangleLines(&image, outline, 1,
+                                    Color{ static_cast<unsigned char>(color.r / 2), static_cast<unsigned char>(color.g / 2),
+                                           static_cast<unsigned char>(color.b / 2), 255 });
+            if (type == TileType::TREE) {
+                ImageDrawRectangle(&image, x + 12, y + 18, 8, 14, Color{100, 60, 20, 255});
+                ImageDrawRectangle(&image, x + 4, y + 2, 24, 18, Color{30, 140, 30, 255});
+                ImageDrawRectangle(&image, x + 8, y + 0, 16, 6, Color{40, 160, 40, 255});
+            }
+        }
     }
+    return image;
 }
 
 void Map::Render(Renderer* renderer, Season season, const TilesetConfig* config) {
     SpriteSheet* worldTiles = SpriteSheetManager::Instance().GetSpriteSheet("world_tiles");
 
-    for (int y = 0; y < m_height; ++y) {
-        for (int x = 0; x < m_width; ++x) {
-            const Tile* tile = GetTileAt(x, y);
-            if (!tile) continue;
+    int x0, y0, x1, y1;
+    if (!GetVisibleTileRange(*renderer, x0, y0, x1, y1)) return;
 
-            int screenX = x * TILE_SIZE;
-            int screenY = y * TILE_SIZE;
+    // Bakes are drawn by whichever thread owns the window; without one draw tile by tile
+    if (IsWindowReady()) {
+        RenderBaked(renderer, worldTiles, season, config, x0, y0, x1, y1);
+        return;
+    }
+    for (int y = y0; y <= y1; ++y) {
+        for (int x = x0; x <= x1; ++x) {
+            const Tile* tile = PeekTile(x, y);
+            if (tile) DrawTile(renderer, worldTiles, tile, x, y, season, config);
+        }
+    }
+}
 
-            if (worldTiles && worldTiles->IsLoaded()) {
-                int tileId = config
-                    ? GetTileSpriteId(tile, season, config)
-                    : GetTileSpriteId(tile);
-                worldTiles->RenderTile(renderer, tileId, screenX, screenY, TILE_SIZE, TILE_SIZE);
-            } else {
-                RenderTileFallback(renderer, tile, screenX, screenY);
+void Map::DrawTile(Renderer* renderer, SpriteSheet* sheet, const Tile* tile, int x, int y, Season season, const TilesetConfig* config) {
+    int screenX = x * TILE_SIZE;
+    int screenY = y * TILE_SIZE;
+
+    if (sheet && sheet->IsLoaded()) {
+        // The variant axis of the compiled table: growth stage, water frame or visual id
+        TileType type = tile->GetType();
+        int variant = tile->GetVisualId();
+        if (type == TileType::CROP) {
+            const FarmPlot* plot = GetFarmPlot(x, y);
+            variant = plot ? plot->GetGrowthStage() : 0;
+        } else if (type == TileType::WATER) {
+            variant = m_waterAnimFrame;
+        }
+        // A generated sheet is laid out like the default tileset, whatever the config says
+        const TilesetConfig& tileset = (config && !sheet->IsGenerated()) ? *config : DefaultTileset();
+        int tileId = tileset.GetTileSpriteId(type, season, variant);
+        sheet->RenderTile(renderer, tileId, screenX, screenY, TILE_SIZE, TILE_SIZE);
+    } else {
+        RenderTileFallback(renderer, tile, screenX, screenY);
+    }
+}
+
+void Map::RenderBaked(Renderer* renderer, SpriteSheet* sheet, Season season, const TilesetConfig* config,
+                      int x0, int y0, int x1, int y1) {
+    // Anything that changes how every tile looks makes every bake stale
+    bool sprites = sheet && sheet->IsLoaded();
+    if (m_bakeRenderer != renderer) {
+        ReleaseBakedChunks();
+        m_bakeRenderer = renderer;
+    }
+    if (m_bakedChunks.size() != m_chunks.size() || m_bakeGeneration != m_chunkGeneration ||
+        m_bakeSeason != season || m_bakeConfig != config || m_bakeSprites != sprites) {
+        ReleaseBakedChunks();
+        m_bakedChunks.clear();
+        m_bakedChunks.resize(m_chunks.size());
+        m_bakeGeneration = m_chunkGeneration;
+        m_bakeSeason = season;
+        m_bakeConfig = config;
+        m_bakeSprites = sprites;
+    }
+
+    int chunkX0 = x0 >> TileChunk::SIZE_SHIFT;
+    int chunkY0 = y0 >> TileChunk::SIZE_SHIFT;
+    int chunkX1 = x1 >> TileChunk::SIZE_SHIFT;
+    int chunkY1 = y1 >> TileChunk::SIZE_SHIFT;
+
+    // Let go of textures that have scrolled well out of view or whose tiles are with the streamer
+    for (size_t i = 0; i < m_bakedIndices.size();) {
+        int index = m_bakedIndices[i];
+        int chunkX = index % m_chunksX;
+        int chunkY = index / m_chunksX;
+        bool keep = !m_chunkEvicted[index] &&
+                    chunkX >= chunkX0 - BAKE_KEEP_MARGIN && chunkX <= chunkX1 + BAKE_KEEP_MARGIN &&
+                    chunkY >= chunkY0 - BAKE_KEEP_MARGIN && chunkY <= chunkY1 + BAKE_KEEP_MARGIN;
+        if (keep) {
+            ++i;
+        } else {
+            ReleaseBakedChunk(index);
+        }
+    }
+
+    // One draw per visible chunk for the static layer
+    for (int chunkY = chunkY0; chunkY <= chunkY1; ++chunkY) {
+        for (int chunkX = chunkX0; chunkX <= chunkX1; ++chunkX) {
+            int index = chunkY * m_chunksX + chunkX;
+            if (m_chunkEvicted[index]) continue;
+            BakedChunk& baked = m_bakedChunks[index];
+            if (baked.target == 0 || baked.revision != m_chunkRevisions[index]) {
+                BakeChunk(renderer, sheet, season, config, index);
+            }
+            Rectangle dst = { static_cast<float>((chunkX << TileChunk::SIZE_SHIFT) * TILE_SIZE),
+                              static_cast<float>((chunkY << TileChunk::SIZE_SHIFT) * TILE_SIZE),
+                              static_cast<float>(baked.width), static_cast<float>(baked.height) };
+            renderer->DrawTarget(baked.target, dst);
+        }
+    }
+
+    // Overlay: only the animated tiles the bakes left out
+    for (int chunkY = chunkY0; chunkY <= chunkY1; ++chunkY) {
+        for (int chunkX = chunkX0; chunkX <= chunkX1; ++chunkX) {
+            int index = chunkY * m_chunksX + chunkX;
+            if (m_chunkEvicted[index] || m_bakedChunks[index].target == 0) continue;
+            int baseX = chunkX << TileChunk::SIZE_SHIFT;
+            int baseY = chunkY << TileChunk::SIZE_SHIFT;
+            for (std::uint16_t local : m_bakedChunks[index].animated) {
+                int x = baseX + (local & TileChunk::MASK);
+                int y = baseY + (local >> TileChunk::SIZE_SHIFT);
+                if (x < x0 || x > x1 || y < y0 || y > y1) continue;
+                DrawTile(renderer, sheet, PeekTile(x, y), x, y, season, config);
             }
         }
     }
 }
 
-int Map::GetTileSpriteId(const Tile* tile, Season season, const TilesetConfig* config) const {
-    TileType type = tile->GetType();
+void Map::BakeChunk(Renderer* renderer, SpriteSheet* sheet, Season season, const TilesetConfig* config, int chunkIndex) {
+    BakedChunk& baked = m_bakedChunks[chunkIndex];
+    int baseX = (chunkIndex % m_chunksX) << TileChunk::SIZE_SHIFT;
+    int baseY = (chunkIndex / m_chunksX) << TileChunk::SIZE_SHIFT;
+    int endX = std::min(baseX + TileChunk::SIZE, m_width);
+    int endY = std::min(baseY + TileChunk::SIZE, m_height);
 
-    switch (type) {
-        case TileType::WATER:
-            return config->GetWaterFrame(m_waterAnimFrame);
-        case TileType::WALL:
-            return config->GetWallAutoTileBase() + tile->GetVisualId();
-        case TileType::CROP:
-            return config->GetCropGrowthBase() + tile->GetGrowthStage();
-        case TileType::DECORATION:
-            return config->GetDecorationBase() + tile->GetVisualId();
-        case TileType::TREE:
-            return config->GetTreeBase();
-        default:
-            return config->GetSpriteId(type, season);
-    }
-}
-
-Tile* Map::GetTileAt(int x, int y) {
-    if (!IsValidPosition(x, y)) return nullptr;
-    return &m_tiles[GetIndex(x, y)];
+    if (baked.target == 0) {
+        baked.target = renderer->CreateTarget();
+        baked.width = (endX - baseX) * TILE_SIZE;
+        baked.height = (endY - baseY) * TILE_SIZE;
+        m_bakedIndices.push_back(chunkIndex);
+    }
+
+    // Draw in chunk-local pixels by pointing the camera at the chunk's corner
+    int cameraX, cameraY;
+    renderer->GetCamera(cameraX, cameraY);
+    renderer->BeginTarget(baked.target, baked.width, baked.height);
+    renderer->SetCamera(baseX * TILE_SIZE, baseY * TILE_SIZE);
+
+    const Tile soil(TileType::SOIL, 0);
+    baked.animated.clear();
+    for (int y = baseY; y < endY; ++y) {
+        for (int x = baseX; x < endX; ++x) {
+            const Tile* tile = PeekTile(x, y);
+            if (IsAnimatedTile(tile->GetType())) {
+                baked.animated.push_back(static_cast<std::uint16_t>(GetLocalIndex(x, y)));
+                // Crops are drawn over tilled soil; water covers its whole tile
+                if (tile->GetType() == TileType::CROP) DrawTile(renderer, sheet, &soil, x, y, season, config);
+                continue;
+            }
+            DrawTile(renderer, sheet, tile, x, y, season, config);
+        }
+    }
+
+    renderer->EndTarget();
+    renderer->SetCamera(cameraX, cameraY);
+    baked.revision = m_chunkRevisions[chunkIndex];
+    m_chunkBakes++;
+}
+
+void Map::ReleaseBakedChunk(int chunkIndex) {
+    BakedChunk& baked = m_bakedChunks[chunkIndex];
+    if (baked.target == 0) return;
+    m_bakeRenderer->DestroyTarget(baked.target);
+    baked.target = 0;
+    baked.animated.clear();
+    m_bakedIndices.erase(std::find(m_bakedIndices.begin(), m_bakedIndices.end(), chunkIndex));
+}
+
+void Map::ReleaseBakedChunks() {
+    while (!m_bakedIndices.empty()) {
+        ReleaseBakedChunk(m_bakedIndices.back());
+    }
+}
+
+std::uint32_t Map::GetChunkRevision(int chunkX, int chunkY) const {
+    if (chunkX < 0 || chunkX >= m_chunksX || chunkY < 0 || chunkY >= m_chunksY) return 0;
+    return m_chunkRevisions[chunkY * m_chunksX + chunkX];
+}
+
+bool Map::GetVisibleTileRange(const Renderer& renderer, int& x0, int& y0, int& x1, int& y1) const {
+    int cameraX, cameraY;
+    renderer.GetCamera(cameraX, cameraY);
+    x0 = std::max(ToTile(static_cast<float>(cameraX)), 0);
+    y0 = std::max(ToTile(static_cast<float>(cameraY)), 0);
+    x1 = std::min(ToTile(static_cast<float>(cameraX + renderer.GetWidth() - 1)), m_width - 1);
+    y1 = std::min(ToTile(static_cast<float>(cameraY + renderer.GetHeight() - 1)), m_height - 1);
+    return renderer.GetWidth() > 0 && renderer.GetHeight() > 0 && x0 <= x1 && y0 <= y1;
 }
 
 const Tile* Map::GetTileAt(int x, int y) const {
     if (!IsValidPosition(x, y)) return nullptr;
-    return &m_tiles[GetIndex(x, y)];
+    FaultInChunk(x, y);
+    return PeekTile(x, y);
 }
 
 void Map::SetTile(int x, int y, const Tile& tile) {
     if (IsValidPosition(x, y)) {
-        m_tiles[GetIndex(x, y)] = tile;
+        TileChunk* chunk = EnsureChunk(x, y);
+        chunk->tiles[GetLocalIndex(x, y)] = tile;
+        m_chunkRevisions[GetChunkIndex(x, y)]++;
+        SetSolid(x, y, tile.IsSolid());
+        // A replaced tile starts with no farming state
+        int index = GetIndex(x, y);
+        MarkChanged(index);
+        auto plot = m_farmPlots.find(index);
+        if (plot != m_farmPlots.end()) {
+            if (plot->second.GetSoilState() == SoilState::CROP) {
+                UnregisterGrowing(index);
+            }
+            m_farmPlots.erase(plot);
+        }
+        CancelEvents(index);
+    }
+}
+
+void Map::SetOrigin(const MapOrigin& origin) {
+    m_origin = origin;
+    m_changedTiles.clear();
+}
+
+void Map::MarkChanged(int index) {
+    if (m_origin.kind != MapOrigin::Kind::NONE) {
+        m_changedTiles.insert(index);
     }
 }
 
+void Map::SetFarmPlot(int x, int y, const FarmPlot& plot) {
+    if (!IsValidPosition(x, y)) return;
+    // Only tiles with farming state get a plot
+    if (plot.GetSoilState() == SoilState::GRASS && plot.GetCropType() < 0) return;
+
+    int index = GetIndex(x, y);
+    MarkChanged(index);
+    FarmPlot& stored = m_farmPlots[index];
+    if (stored.GetSoilState() == SoilState::CROP) {
+        UnregisterGrowing(index);
+    }
+    stored = plot;
+    if (plot.GetSoilState() == SoilState::CROP) {
+        RegisterGrowing(index, &stored);
+        ScheduleEvent(index, TileEventType::CROP_GROWTH, FarmPlot::GROWTH_INTERVAL);
+    }
+}
+
+FarmPlot* Map::GetFarmPlot(int x, int y) {
+    if (!IsValidPosition(x, y)) return nullptr;
+    auto it = m_farmPlots.find(GetIndex(x, y));
+    return it != m_farmPlots.end() ? &it->second : nullptr;
+}
+
+const FarmPlot* Map::GetFarmPlot(int x, int y) const {
+    if (!IsValidPosition(x, y)) return nullptr;
+    auto it = m_farmPlots.find(GetIndex(x, y));
+    return it != m_farmPlots.end() ? &it->second : nullptr;
+}
+
+SoilState Map::GetSoilState(int x, int y) const {
+    const FarmPlot* plot = GetFarmPlot(x, y);
+    return plot ? plot->GetSoilState() : SoilState::GRASS;
+}
+
 bool Map::IsSolid(int x, int y) const {
-    const Tile* tile = GetTileAt(x, y);
-    return tile ? tile->IsSolid() : true;
+    return m_solidity.IsSolid(x, y);
 }
 
 bool Map::IsAreaSolid(float worldX, float worldY, float width, float height) const {
-    int tlX, tlY, trX, trY, blX, blY, brX, brY;
-    WorldToTile(worldX, worldY, tlX, tlY);
-    WorldToTile(worldX + width - 1, worldY, trX, trY);
-    WorldToTile(worldX, worldY + height - 1, blX, blY);
-    WorldToTile(worldX + width - 1, worldY + height - 1, brX, brY);
-    return IsSolid(tlX, tlY) || IsSolid(trX, trY) ||
-           IsSolid(blX, blY) || IsSolid(brX, brY);
+    // Every tile under the box, not just its corners
+    int x0, y0, x1, y1;
+    WorldToTile(worldX, worldY, x0, y0);
+    WorldToTile(worldX + width - 1, worldY + height - 1, x1, y1);
+    return m_solidity.AnySolidInRect(x0, y0, x1, y1);
+}
+
+CollisionResult Map::MoveAndCollide(float& x, float& y, float width, float height, float dx, float dy) const {
+    CollisionResult result;
+    float largest = std::max(std::abs(dx), std::abs(dy));
+    int steps = std::max(1, static_cast<int>(std::ceil(largest / TILE_SIZE)));
+    float stepX = dx / steps;
+    float stepY = dy / steps;
+
+    for (int i = 0; i < steps && !(result.hitX && result.hitY); ++i) {
+        // X then Y, each axis stopping for good once it hits something
+        if (!result.hitX && stepX != 0.0f) x = SweepX(x, y, width, height, stepX, result.hitX);
+        if (!result.hitY && stepY != 0.0f) y = SweepY(x, y, width, height, stepY, result.hitY);
+    }
+    return result;
+}
+
+bool Map::HasLineOfSight(float fromX, float fromY, float toX, float toY) const {
+    // Work in tile units so cell boundaries fall on whole numbers
+    float x0 = fromX / TILE_SIZE;
+    float y0 = fromY / TILE_SIZE;
+    float dx = toX / TILE_SIZE - x0;
+    float dy = toY / TILE_SIZE - y0;
+    int tileX = ToTile(fromX);
+    int tileY = ToTile(fromY);
+    int endX = ToTile(toX);
+    int endY = ToTile(toY);
+    if (m_solidity.IsSolid(tileX, tileY)) return false;
+
+    // Ray parameter t runs 0..1; tMax is where the next column / row boundary is crossed
+    constexpr float NEVER = std::numeric_limits<float>::infinity();
+    int stepX = dx > 0.0f ? 1 : (dx < 0.0f ? -1 : 0);
+    int stepY = dy > 0.0f ? 1 : (dy < 0.0f ? -1 : 0);
+    float tDeltaX = stepX != 0 ? std::abs(1.0f / dx) : NEVER;
+    float tDeltaY = stepY != 0 ? std::abs(1.0f / dy) : NEVER;
+    float tMaxX = stepX > 0 ? (tileX + 1 - x0) * tDeltaX : (stepX < 0 ? (x0 - tileX) * tDeltaX : NEVER);
+    float tMaxY = stepY > 0 ? (tileY + 1 - y0) * tDeltaY : (stepY < 0 ? (y0 - tileY) * tDeltaY : NEVER);
+
+    // Each step moves one cell closer; the bound only matters for rounding at the far end
+    for (int remaining = std::abs(endX - tileX) + std::abs(endY - tileY);
+         remaining > 0 && (tileX != endX || tileY != endY); --remaining) {
+        if (tMaxX < tMaxY) {
+            tileX += stepX;
+            tMaxX += tDeltaX;
+        } else if (tMaxY < tMaxX) {
+            tileY += stepY;
+            tMaxY += tDeltaY;
+        } else {
+            // Exactly through a corner: either side cell closes the gap
+            if (m_solidity.IsSolid(tileX + stepX, tileY) || m_solidity.IsSolid(tileX, tileY + stepY)) return false;
+            tileX += stepX;
+            tileY += stepY;
+            tMaxX += tDeltaX;
+            tMaxY += tDeltaY;
+        }
+        if (m_solidity.IsSolid(tileX, tileY)) return false;
+    }
+    return true;
+}
+
+int Map::HasLineOfSight(float targetX, float targetY, float maxDistance,
+                        const float* fromX, const float* fromY, int count, std::uint8_t* outVisible) const {
+    float maxDistanceSq = maxDistance * maxDistance;
+    int visible = 0;
+    for (int i = 0; i < count; ++i) {
+        float dx = targetX - fromX[i];
+        float dy = targetY - fromY[i];
+        bool sees = dx * dx + dy * dy <= maxDistanceSq && HasLineOfSight(fromX[i], fromY[i], targetX, targetY);
+        outVisible[i] = sees ? 1 : 0;
+        visible += sees ? 1 : 0;
+    }
+    return visible;
+}
+
+int Map::ToTile(float world) {
+    return static_cast<int>(std::floor(world / TILE_SIZE));
+}
+
+float Map::SweepX(float x, float y, float width, float height, float dx, bool& hit) const {
+    // The box covers pixels [x, x + width - 1], as in IsAreaSolid
+    int row0 = ToTile(y);
+    int row1 = ToTile(y + height - 1);
+    int column;
+
+    if (dx > 0.0f) {
+        int from = ToTile(x + width - 1) + 1;
+        int to = ToTile(x + width - 1 + dx);
+        int nearest = to + 1;
+        for (int row = row0; row <= row1; ++row) {
+            if (m_solidity.FirstSolidInRow(row, from, to, column)) nearest = std::min(nearest, column);
+        }
+        if (nearest <= to) {
+            hit = true;
+            return std::max(x, static_cast<float>(nearest * TILE_SIZE) - width);   // Never pushed back
+        }
+    } else {
+        int from = ToTile(x + dx);
+        int to = ToTile(x) - 1;
+        int nearest = from - 1;
+        for (int row = row0; row <= row1; ++row) {
+            if (m_solidity.LastSolidInRow(row, from, to, column)) nearest = std::max(nearest, column);
+        }
+        if (nearest >= from) {
+            hit = true;
+            return std::min(x, static_cast<float>((nearest + 1) * TILE_SIZE));
+        }
+    }
+    return x + dx;
+}
+
+float Map::SweepY(float x, float y, float width, float height, float dy, bool& hit) const {
+    int column0 = ToTile(x);
+    int column1 = ToTile(x + width - 1);
+
+    if (dy > 0.0f) {
+        int to = ToTile(y + height - 1 + dy);
+        for (int row = ToTile(y + height - 1) + 1; row <= to; ++row) {
+            if (m_solidity.AnySolidInRect(column0, row, column1, row)) {
+                hit = true;
+                return std::max(y, static_cast<float>(row * TILE_SIZE) - height);
+            }
+        }
+    } else {
+        int to = ToTile(y + dy);
+        for (int row = ToTile(y) - 1; row >= to; --row) {
+            if (m_solidity.AnySolidInRect(column0, row, column1, row)) {
+                hit = true;
+                return std::min(y, static_cast<float>((row + 1) * TILE_SIZE));
+            }
+        }
+    }
+    return y + dy;
 }
 
 bool Map::CanPlantCrop(int x, int y) const {
@@ -302,57 +791,67 @@ bool Map::CanPlantCrop(int x, int y) const {
 }
 
 bool Map::TillSoil(int x, int y) {
-    Tile* tile = GetTileAt(x, y);
+    const Tile* tile = GetTileAt(x, y);
     if (!tile || tile->GetType() != TileType::GRASS) return false;
     
-    tile->SetType(TileType::SOIL);
-    tile->SetSoilState(SoilState::HOE);
+    SetTile(x, y, Tile(TileType::SOIL, tile->GetVisualId()));
+    FarmPlot plot;
+    plot.SetSoilState(SoilState::HOE);
+    m_farmPlots[GetIndex(x, y)] = plot;
     return true;
 }
 
 bool Map::WaterTile(int x, int y) {
-    Tile* tile = GetTileAt(x, y);
+    const Tile* tile = GetTileAt(x, y);
     if (!tile || !tile->IsFarmable()) return false;
     
-    if (tile->GetSoilState() == SoilState::HOE) {
-        tile->SetSoilState(SoilState::WATERED);
+    FarmPlot* plot = GetFarmPlot(x, y);
+    if (plot && plot->GetSoilState() == SoilState::HOE) {
+        plot->SetSoilState(SoilState::WATERED);
+        MarkChanged(GetIndex(x, y));
         return true;
     }
     return false;
 }
 
 bool Map::PlantCrop(int x, int y, int cropType) {
-    Tile* tile = GetTileAt(x, y);
+    const Tile* tile = GetTileAt(x, y);
     if (!tile || !tile->IsFarmable()) return false;
     
-    if (tile->GetSoilState() == SoilState::HOE || 
-        tile->GetSoilState() == SoilState::WATERED) {
-        tile->SetCropType(cropType);
-        tile->SetGrowthStage(0);
-        tile->SetSoilState(SoilState::CROP);
+    FarmPlot* plot = GetFarmPlot(x, y);
+    if (plot && (plot->GetSoilState() == SoilState::HOE ||
+                 plot->GetSoilState() == SoilState::WATERED)) {
+        plot->SetCropType(cropType);
+        plot->SetGrowthStage(0);
+        plot->SetSoilState(SoilState::CROP);
+        RegisterGrowing(GetIndex(x, y), plot);
+        ScheduleEvent(GetIndex(x, y), TileEventType::CROP_GROWTH, FarmPlot::GROWTH_INTERVAL);
+        MarkChanged(GetIndex(x, y));
         return true;
     }
     return false;
 }
 
 bool Map::HarvestCrop(int x, int y) {
-    Tile* tile = GetTileAt(x, y);
-    if (!tile || tile->GetSoilState() != SoilState::HARVEST) return false;
+    FarmPlot* plot = GetFarmPlot(x, y);
+    if (!plot || plot->GetSoilState() != SoilState::HARVEST) return false;
     
     // Reset to tilled soil
-    tile->SetSoilState(SoilState::HOE);
-    tile->SetCropType(-1);
-    tile->SetGrowthStage(0);
+    plot->SetSoilState(SoilState::HOE);
+    plot->SetCropType(-1);
+    plot->SetGrowthStage(0);
+    UnregisterGrowing(GetIndex(x, y));
+    CancelTileEvent(x, y, TileEventType::CROP_GROWTH);
+    MarkChanged(GetIndex(x, y));
     return true;
 }
 
 bool Map::ChopTree(int x, int y) {
-    Tile* tile = GetTileAt(x, y);
+    const Tile* tile = GetTileAt(x, y);
     if (!tile || tile->GetType() != TileType::TREE) return false;
 
     // Replace tree with grass stump
-    tile->SetType(TileType::GRASS);
-    tile->SetVisualId(0);
+    SetTile(x, y, Tile(TileType::GRASS, 0));
     return true;
 }
 
@@ -370,6 +869,219 @@ int Map::GetIndex(int x, int y) const {
     return y * m_width + x;
 }
 
+void Map::IndexToTile(int index, int& x, int& y) const {
+    x = index % m_width;
+    y = index / m_width;
+}
+
 bool Map::IsValidPosition(int x, int y) const {
     return x >= 0 && x < m_width && y >= 0 && y < m_height;
 }
+
+void Map::ResetChunks(int width, int height) {
+    m_width = width;
+    m_height = height;
+    m_chunksX = (width + TileChunk::MASK) >> TileChunk::SIZE_SHIFT;
+    m_chunksY = (height + TileChunk::MASK) >> TileChunk::SIZE_SHIFT;
+    m_chunks.clear();
+    m_allocatedIndices.clear();
+    m_chunks.resize(static_cast<size_t>(m_chunksX) * m_chunksY);
+    m_chunkEvicted.assign(m_chunks.size(), 0);
+    m_chunkRevisions.assign(m_chunks.size(), 0);
+    m_chunkGeneration++;
+    m_solidityGeneration++;
+    m_solidity.Reset(width, height, m_fillTile.IsSolid());
+    m_farmPlots.clear();
+    m_growingTiles.clear();
+    m_growingPlots.clear();
+    m_growingSlots.clear();
+    m_timers.Clear();
+    m_liveEvents.clear();
+    m_origin = MapOrigin();
+    m_changedTiles.clear();
+}
+
+int Map::GetChunkIndex(int x, int y) const {
+    return (y >> TileChunk::SIZE_SHIFT) * m_chunksX + (x >> TileChunk::SIZE_SHIFT);
+}
+
+int Map::GetLocalIndex(int x, int y) {
+    return ((y & TileChunk::MASK) << TileChunk::SIZE_SHIFT) + (x & TileChunk::MASK);
+}
+
+TileChunk* Map::EnsureChunk(int x, int y) {
+    FaultInChunk(x, y);
+    int index = GetChunkIndex(x, y);
+    auto& chunk = m_chunks[index];
+    bool lost = m_chunkEvicted[index] != 0;
+    m_chunkEvicted[index] = 0;   // No streamer to give it back; start over
+    if (!chunk) {
+        chunk = std::make_unique<TileChunk>();
+        for (auto& tile : chunk->tiles) {
+            tile = m_fillTile;
+        }
+        m_allocatedIndices.push_back(index);
+        if (lost) RefreshChunkSolidity(x >> TileChunk::SIZE_SHIFT, y >> TileChunk::SIZE_SHIFT);
+    }
+    return chunk.get();
+}
+
+const Tile* Map::PeekTile(int x, int y) const {
+    if (!IsValidPosition(x, y)) return nullptr;
+    int index = GetChunkIndex(x, y);
+    const auto& chunk = m_chunks[index];
+    if (!chunk) return m_chunkEvicted[index] ? nullptr : &m_fillTile;
+    return &chunk->tiles[GetLocalIndex(x, y)];
+}
+
+void Map::FaultInChunk(int x, int y) const {
+    if (m_chunkEvicted[GetChunkIndex(x, y)] && m_chunkFaultHandler) {
+        m_chunkFaultHandler(x >> TileChunk::SIZE_SHIFT, y >> TileChunk::SIZE_SHIFT);
+    }
+}
+
+const TileChunk* Map::GetChunk(int chunkX, int chunkY) const {
+    if (chunkX < 0 || chunkX >= m_chunksX || chunkY < 0 || chunkY >= m_chunksY) return nullptr;
+    FaultInChunk(chunkX << TileChunk::SIZE_SHIFT, chunkY << TileChunk::SIZE_SHIFT);
+    return m_chunks[chunkY * m_chunksX + chunkX].get();
+}
+
+TileChunk* Map::EnsureChunkAt(int chunkX, int chunkY) {
+    if (chunkX < 0 || chunkX >= m_chunksX || chunkY < 0 || chunkY >= m_chunksY) return nullptr;
+    return EnsureChunk(chunkX << TileChunk::SIZE_SHIFT, chunkY << TileChunk::SIZE_SHIFT);
+}
+
+bool Map::IsChunkAllocated(int chunkX, int chunkY) const {
+    if (chunkX < 0 || chunkX >= m_chunksX || chunkY < 0 || chunkY >= m_chunksY) return false;
+    return m_chunks[chunkY * m_chunksX + chunkX] != nullptr;
+}
+
+bool Map::IsChunkEvicted(int chunkX, int chunkY) const {
+    if (chunkX < 0 || chunkX >= m_chunksX || chunkY < 0 || chunkY >= m_chunksY) return false;
+    return m_chunkEvicted[chunkY * m_chunksX + chunkX] != 0;
+}
+
+std::unique_ptr<TileChunk> Map::EvictChunk(int chunkX, int chunkY) {
+    if (!IsChunkAllocated(chunkX, chunkY)) return nullptr;
+    int index = chunkY * m_chunksX + chunkX;
+    m_chunkEvicted[index] = 1;
+    m_allocatedIndices.erase(std::find(m_allocatedIndices.begin(), m_allocatedIndices.end(), index));
+    return std::move(m_chunks[index]);
+}
+
+void Map::RestoreChunk(int chunkX, int chunkY, std::unique_ptr<TileChunk> chunk) {
+    if (!IsChunkEvicted(chunkX, chunkY)) return;
+    int index = chunkY * m_chunksX + chunkX;
+    bool lost = !chunk;
+    m_chunks[index] = std::move(chunk);   // A null chunk reads as fill tiles again
+    m_chunkEvicted[index] = 0;
+    if (!lost) m_allocatedIndices.push_back(index);
+    if (lost) RefreshChunkSolidity(chunkX, chunkY);
+}
+
+void Map::RefreshChunkSolidity(int chunkX, int chunkY) {
+    if (chunkX < 0 || chunkX >= m_chunksX || chunkY < 0 || chunkY >= m_chunksY) return;
+    // Tiles were written directly, so whatever was baked for this chunk is stale
+    m_chunkRevisions[chunkY * m_chunksX + chunkX]++;
+    const TileChunk* chunk = m_chunks[chunkY * m_chunksX + chunkX].get();
+    int baseX = chunkX << TileChunk::SIZE_SHIFT;
+    int baseY = chunkY << TileChunk::SIZE_SHIFT;
+    int endX = std::min(baseX + TileChunk::SIZE, m_width);
+    int endY = std::min(baseY + TileChunk::SIZE, m_height);
+    for (int y = baseY; y < endY; ++y) {
+        for (int x = baseX; x < endX; ++x) {
+            const Tile& tile = chunk ? chunk->tiles[GetLocalIndex(x, y)] : m_fillTile;
+            SetSolid(x, y, tile.IsSolid());
+        }
+    }
+}
+
+void Map::SetSolid(int x, int y, bool solid) {
+    if (m_solidity.IsSolid(x, y) == solid) return;
+    m_solidity.Set(x, y, solid);
+    m_solidityGeneration++;
+    if (m_solidityChangeHandler) m_solidityChangeHandler(x, y);
+}
+
+void Map::RegisterGrowing(int index, FarmPlot* plot) {
+    if (m_growingSlots.emplace(index, static_cast<int>(m_growingTiles.size())).second) {
+        m_growingTiles.push_back(index);
+        m_growingPlots.push_back(plot);
+    }
+}
+
+void Map::UnregisterGrowing(int index) {
+    auto it = m_growingSlots.find(index);
+    if (it == m_growingSlots.end()) return;
+
+    // Swap-pop, moving the last tile into the freed slot
+    int slot = it->second;
+    int last = m_growingTiles.back();
+    m_growingTiles[slot] = last;
+    m_growingPlots[slot] = m_growingPlots.back();
+    m_growingSlots[last] = slot;
+    m_growingTiles.pop_back();
+    m_growingPlots.pop_back();
+    m_growingSlots.erase(index);
+}
+
+bool Map::ScheduleTileEvent(int x, int y, TileEventType type, float delaySeconds) {
+    if (!IsValidPosition(x, y)) return false;
+    ScheduleEvent(GetIndex(x, y), type, delaySeconds);
+    return true;
+}
+
+void Map::CancelTileEvent(int x, int y, TileEventType type) {
+    if (!IsValidPosition(x, y)) return;
+    m_liveEvents.erase(EventKey(GetIndex(x, y), type));
+}
+
+std::uint64_t Map::EventKey(int index, TileEventType type) {
+    return (static_cast<std::uint64_t>(index) << 8) | static_cast<std::uint64_t>(type);
+}
+
+void Map::ScheduleEvent(int index, TileEventType type, float delaySeconds) {
+    // The wheel cannot remove entries, so older events for this key are
+    // left in place and ignored when their serial no longer matches
+    std::uint32_t serial = ++m_nextEventSerial;
+    m_liveEvents[EventKey(index, type)] = serial;
+    m_timers.Schedule(delaySeconds, TileEvent{index, type, serial});
+}
+
+void Map::CancelEvents(int index) {
+    m_liveEvents.erase(EventKey(index, TileEventType::CROP_GROWTH));
+    m_liveEvents.erase(EventKey(index, TileEventType::TREE_REGROWTH));
+    m_liveEvents.erase(EventKey(index, TileEventType::SOIL_DRYING));
+}
+
+void Map::HandleTileEvent(const TileEvent& event) {
+    int x, y;
+    IndexToTile(event.tileIndex, x, y);
+
+    switch (event.type) {
+        case TileEventType::CROP_GROWTH: {
+            FarmPlot* plot = GetFarmPlot(x, y);
+            if (plot && plot->AdvanceGrowth()) {
+                ScheduleEvent(event.tileIndex, TileEventType::CROP_GROWTH, FarmPlot::GROWTH_INTERVAL);
+            } else {
+                // Ready to harvest, or no longer a crop at all
+                UnregisterGrowing(event.tileIndex);
+            }
+            break;
+        }
+        case TileEventType::TREE_REGROWTH: {
+            const Tile* tile = GetTileAt(x, y);
+            if (tile && tile->GetType() == TileType::GRASS) {
+                SetTile(x, y, Tile(TileType::TREE, 0));
+            }
+            break;
+        }
+        case TileEventType::SOIL_DRYING: {
+            FarmPlot* plot = GetFarmPlot(x, y);
+            if (plot && plot->GetSoilState() == SoilState::WATERED) {
+                plot->SetSoilState(SoilState::HOE);
+            }
+            break;
+        }
+    }
+}
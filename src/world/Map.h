@@ -2,16 +2,85 @@
 #define MAP_H
 
 #include "Tile.h"
+#include "TimerWheel.h"
+#include "SolidityGrid.h"
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <unordered_map>
+#include <unordered_set>
 #include <vector>
 #include <string>
 
+struct Image;
 class Renderer;
+class SpriteSheet;
 class TilesetConfig;
 enum class Season;
 
+/**
+ * TileChunk - fixed-size square block of tiles
+ * Tiles are stored row-major so scanning a row inside a chunk stays contiguous
+ */
+struct TileChunk {
+    static constexpr int SIZE_SHIFT = 5;
+    static constexpr int SIZE = 1 << SIZE_SHIFT;   // 32x32 tiles
+    static constexpr int MASK = SIZE - 1;
+    static constexpr int TILE_COUNT = SIZE * SIZE;
+
+    Tile tiles[TILE_COUNT];
+};
+
+// Which axes a MoveAndCollide call was stopped on
+struct CollisionResult {
+    bool hitX = false;
+    bool hitY = false;
+};
+
+/**
+ * MapOrigin - the generator parameters a map was built from
+ * Regenerating from these reproduces the map exactly as generated.
+ */
+struct MapOrigin {
+    enum class Kind : std::uint8_t { NONE, FARM, DUNGEON, OVERWORLD };
+
+    Kind kind = Kind::NONE;     // NONE: loaded or hand-built, cannot be regenerated
+    std::uint32_t seed = 0;
+    int width = 0;
+    int height = 0;
+    std::uint8_t biome = 0;     // Biome value (overworld only)
+};
+
 /**
  * Map class represents a tile-based world
  * Uses the smart data approach - tiles have meaning, not just visuals
+ *
+ * Tiles live in TileChunks that are only allocated the first time a tile
+ * inside them is written, so untouched regions of a large map cost one
+ * null pointer per chunk. Reads from an unallocated chunk see the fill tile.
+ *
+ * Farming state is not stored per tile. The few tiles that have been tilled
+ * get a FarmPlot in a sparse side table keyed by tile index. Tiles with a
+ * growing crop are also tracked in an active set.
+ *
+ * Timed tile changes (crop growth stages, tree regrowth, soil drying) are
+ * scheduled on a hierarchical timer wheel, so Update() does no per-tile work
+ * unless an event is actually due.
+ *
+ * Collision queries read a one-bit-per-tile SolidityGrid that SetTile keeps
+ * current, so they never fault evicted chunks back in.
+ *
+ * With a window open, Render bakes each visible chunk's static tiles into a
+ * render texture and draws it in one call. A chunk is re-baked only when its
+ * revision (bumped by every tile write inside it) moves on. Water and crops
+ * animate, so they are left out of the bake and drawn in a small overlay pass.
+ * The bakes are Renderer targets, so a frame recorded on another thread
+ * carries them as commands and the textures live on the window's thread.
+ * The renderer that drew the bakes must outlive them (or the map).
+ *
+ * A map with a known origin keeps a journal of every tile that has been
+ * written since it was generated. A delta save (MapFile::SaveDelta) stores
+ * only the origin plus those tiles and the farm plots.
  */
 class Map {
 public:
@@ -19,25 +88,126 @@ public:
     Map(int width, int height);
     ~Map();
 
+    // Loads either format (binary files are recognised by their magic).
+    // Saves binary when the path ends in ".hqmap", text otherwise.
     bool LoadFromFile(const std::string& filepath);
     bool SaveToFile(const std::string& filepath) const;
+
+    // Drop all tiles, farm state and origin and start over at the given size
+    void Reset(int width, int height) { ResetChunks(width, height); }
     void Update(float deltaTime);
     void Render(Renderer* renderer);
     void Render(Renderer* renderer, Season season, const TilesetConfig* config);
+    // The flat-colour look used when there is no world art, rasterised once
+    // into a sheet laid out like the default tileset (see TilesetConfig)
+    static Image GenerateFallbackTileset();
+    static constexpr int FALLBACK_SHEET_COLUMNS = 16;
+    static constexpr int FALLBACK_SHEET_ROWS = 4;
+    // Tiles under the renderer's camera view (inclusive, clamped to the map).
+    // Render only visits these, so its cost follows screen size, not map size.
+    bool GetVisibleTileRange(const Renderer& renderer, int& x0, int& y0, int& x1, int& y1) const;
+    
+    // Overnight growth: every growing crop ages one day and ripens once it
+    // reaches its growth days. The caller advances the calendar; each call
+    // is one night. Large farms are split across threads by row band.
+    void AdvanceDay();
 
     int GetWidth() const { return m_width; }
     int GetHeight() const { return m_height; }
+
+    // Chunk storage info
+    static constexpr int CHUNK_SIZE = TileChunk::SIZE;
+    int GetChunksX() const { return m_chunksX; }
+    int GetChunksY() const { return m_chunksY; }
+    int GetAllocatedChunkCount() const { return static_cast<int>(m_allocatedIndices.size()); }
+    const std::vector<int>& GetAllocatedChunkIndices() const { return m_allocatedIndices; }
+    const Tile& GetFillTile() const { return m_fillTile; }
+
+    // Whole-chunk access for bulk I/O. GetChunk returns null for chunks
+    // that were never written; EnsureChunkAt allocates them (as fill tiles).
+    // Whoever writes a chunk's tiles directly calls RefreshChunkSolidity after.
+    const TileChunk* GetChunk(int chunkX, int chunkY) const;
+    TileChunk* EnsureChunkAt(int chunkX, int chunkY);
+    void RefreshChunkSolidity(int chunkX, int chunkY);
+
+    // Chunk residency, driven by ChunkStreamer. An evicted chunk's tiles are
+    // held elsewhere; touching one through the tile accessors calls the fault
+    // handler, which must hand it back with RestoreChunk before returning.
+    // Render skips evicted chunks instead of faulting them in.
+    using ChunkFaultHandler = std::function<void(int chunkX, int chunkY)>;
+    void SetChunkFaultHandler(ChunkFaultHandler handler) { m_chunkFaultHandler = std::move(handler); }
+    bool IsChunkAllocated(int chunkX, int chunkY) const;
+    bool IsChunkEvicted(int chunkX, int chunkY) const;
+    std::unique_ptr<TileChunk> EvictChunk(int chunkX, int chunkY);
+    void RestoreChunk(int chunkX, int chunkY, std::unique_ptr<TileChunk> chunk);
+    std::uint32_t GetChunkGeneration() const { return m_chunkGeneration; }  // Bumped when storage is rebuilt
+    std::uint32_t GetChunkRevision(int chunkX, int chunkY) const;           // Bumped on every tile write inside
+
+    // Baked chunk layers: textures currently held, and bakes done so far
+    int GetBakedChunkCount() const { return static_cast<int>(m_bakedIndices.size()); }
+    int GetChunkBakeCount() const { return m_chunkBakes; }
+
+    // Called whenever a tile's solidity bit flips (not on Reset, which bumps
+    // the chunk generation instead). Used to repair path data incrementally.
+    using SolidityChangeHandler = std::function<void(int x, int y)>;
+    void SetSolidityChangeHandler(SolidityChangeHandler handler) { m_solidityChangeHandler = std::move(handler); }
     
-    // Tile access
-    Tile* GetTileAt(int x, int y);
+    // Tile access. All tile writes go through SetTile so the journal sees them.
     const Tile* GetTileAt(int x, int y) const;
     void SetTile(int x, int y, const Tile& tile);
+
+    // Generator origin and change journal. Setting the origin marks the
+    // current tiles as the baseline and empties the journal; only maps with
+    // an origin keep one.
+    void SetOrigin(const MapOrigin& origin);
+    const MapOrigin& GetOrigin() const { return m_origin; }
+    bool HasOrigin() const { return m_origin.kind != MapOrigin::Kind::NONE; }
+    const std::unordered_set<int>& GetChangedTiles() const { return m_changedTiles; }
+    int GetChangedTileCount() const { return static_cast<int>(m_changedTiles.size()); }
     
     // Check tile properties at position
     bool IsSolid(int x, int y) const;
     bool IsAreaSolid(float worldX, float worldY, float width, float height) const;
+    const SolidityGrid& GetSolidityGrid() const { return m_solidity; }
+    // Bumped whenever any tile's solidity changes or the map is reset, so
+    // cached paths can tell they may be stale without diffing the grid
+    std::uint32_t GetSolidityGeneration() const { return m_solidityGeneration; }
+
+    // Swept AABB against the tile grid: moves the box at (x, y) by (dx, dy)
+    // and leaves it flush against the first solid tile it runs into on each
+    // axis. Only tiles crossed by the leading edges are examined, so the cost
+    // follows the distance moved. Long moves are split into tile-sized steps
+    // so diagonal motion slides around corners the same at any speed.
+    CollisionResult MoveAndCollide(float& x, float& y, float width, float height, float dx, float dy) const;
+
+    // Grid raycast (DDA) between two world points. Any solid tile the segment
+    // passes through blocks it, endpoints included; a segment that slips
+    // exactly between two diagonal solid tiles is blocked too.
+    bool HasLineOfSight(float fromX, float fromY, float toX, float toY) const;
+    // Batched form: many viewers looking at one target. Viewers farther than
+    // maxDistance are not raycast. Writes 1/0 per viewer into outVisible and
+    // returns how many can see the target.
+    int HasLineOfSight(float targetX, float targetY, float maxDistance,
+                       const float* fromX, const float* fromY, int count, std::uint8_t* outVisible) const;
     bool CanPlantCrop(int x, int y) const;
     
+    // Farm state (nullptr / SoilState::GRASS for tiles that were never tilled)
+    FarmPlot* GetFarmPlot(int x, int y);
+    const FarmPlot* GetFarmPlot(int x, int y) const;
+    SoilState GetSoilState(int x, int y) const;
+    std::unordered_map<int, FarmPlot>& GetFarmPlots() { return m_farmPlots; }
+    const std::unordered_map<int, FarmPlot>& GetFarmPlots() const { return m_farmPlots; }
+    int GetFarmPlotCount() const { return static_cast<int>(m_farmPlots.size()); }
+    // Store loaded farm state as-is (growing crops rejoin the active set)
+    void SetFarmPlot(int x, int y, const FarmPlot& plot);
+    int GetGrowingTileCount() const { return static_cast<int>(m_growingTiles.size()); }
+    
+    // Timed tile events. Scheduling replaces any pending event of the same
+    // type on that tile; returns false for positions outside the map.
+    bool ScheduleTileEvent(int x, int y, TileEventType type, float delaySeconds);
+    void CancelTileEvent(int x, int y, TileEventType type);
+    int GetPendingEventCount() const { return static_cast<int>(m_liveEvents.size()); }
+    
     // Farming interactions
     bool TillSoil(int x, int y);
     bool WaterTile(int x, int y);
@@ -46,28 +216,103 @@ public:
     bool ChopTree(int x, int y);
     
     // World position to tile coordinates
+    static constexpr int TILE_SIZE = 32;
     void WorldToTile(float worldX, float worldY, int& tileX, int& tileY) const;
     void TileToWorld(int tileX, int tileY, float& worldX, float& worldY) const;
 
+    // Tile index used to key sparse per-tile data
+    int GetIndex(int x, int y) const;
+    void IndexToTile(int index, int& x, int& y) const;
+
 private:
     int m_width, m_height;
-    std::vector<Tile> m_tiles;
-    static constexpr int TILE_SIZE = 32;
-    
+    int m_chunksX, m_chunksY;
+    std::vector<std::unique_ptr<TileChunk>> m_chunks;
+    std::vector<int> m_allocatedIndices;             // Chunks that currently hold tiles
+    Tile m_fillTile;        // What unallocated chunks contain
+    std::vector<std::uint8_t> m_chunkEvicted;        // Per chunk: tiles are out with the streamer
+    SolidityGrid m_solidity;                         // Stays valid while chunks are evicted
+    std::uint32_t m_solidityGeneration = 0;
+    ChunkFaultHandler m_chunkFaultHandler;
+    SolidityChangeHandler m_solidityChangeHandler;
+    std::uint32_t m_chunkGeneration = 0;
+    std::vector<std::uint32_t> m_chunkRevisions;     // Per chunk: tile writes so far
+    std::unordered_map<int, FarmPlot> m_farmPlots;   // Tile index -> farm state
+    std::vector<int> m_growingTiles;                 // Tile indices with SoilState::CROP
+    std::vector<FarmPlot*> m_growingPlots;           // Plot for each entry (map nodes never move)
+    std::unordered_map<int, int> m_growingSlots;     // Tile index -> position in m_growingTiles
+
+    // Delta save state
+    MapOrigin m_origin;
+    std::unordered_set<int> m_changedTiles;          // Tile indices written since generation
+
+    // Scheduled tile events
+    TimerWheel m_timers;
+    std::unordered_map<std::uint64_t, std::uint32_t> m_liveEvents;  // (tile, type) -> live serial
+    std::uint32_t m_nextEventSerial = 0;
+    std::vector<TileEvent> m_dueEvents;              // Scratch buffer reused every Update
+
+    // Overnight growth batch, gathered from the active set by row band
+    std::vector<int> m_nightTiles;
+    std::vector<FarmPlot*> m_nightPlots;
+    static constexpr int PARALLEL_GROWTH_MIN_CROPS = 4096;
+    static constexpr int MAX_GROWTH_THREADS = 8;
+
     // Water animation state
     float m_waterAnimTimer = 0.0f;
     int m_waterAnimFrame = 0;
     static constexpr int WATER_ANIM_FRAMES = 4;
     static constexpr float WATER_ANIM_SPEED = 0.4f;
-    static constexpr int WATER_FRAME_IDS[WATER_ANIM_FRAMES] = {3, 21, 22, 23};
+
+    // Baked static layers, one render texture per chunk (see Render)
+    struct BakedChunk;
+    std::vector<BakedChunk> m_bakedChunks;           // Per chunk
+    std::vector<int> m_bakedIndices;                 // Chunks that hold a texture
+    std::uint32_t m_bakeGeneration = 0;              // What the bakes were drawn with
+    Season m_bakeSeason{};
+    const TilesetConfig* m_bakeConfig = nullptr;
+    bool m_bakeSprites = false;
+    int m_chunkBakes = 0;
+    Renderer* m_bakeRenderer = nullptr;              // Owns the bake targets
+    static constexpr int BAKE_KEEP_MARGIN = 1;       // Chunks past the view edge that keep their texture
     
-    int GetIndex(int x, int y) const;
     bool IsValidPosition(int x, int y) const;
+
+    // Collision helpers: return the new coordinate on one axis
+    static int ToTile(float world);
+    float SweepX(float x, float y, float width, float height, float dx, bool& hit) const;
+    float SweepY(float x, float y, float width, float height, float dy, bool& hit) const;
+
+    // Chunk helpers
+    void ResetChunks(int width, int height);
+    int GetChunkIndex(int x, int y) const;
+    static int GetLocalIndex(int x, int y);
+    TileChunk* EnsureChunk(int x, int y);
+    const Tile* PeekTile(int x, int y) const;   // Never allocates; null for evicted chunks
+    void FaultInChunk(int x, int y) const;
+
+    void MarkChanged(int index);
+    void SetSolid(int x, int y, bool solid);
+
+    // Active crop set maintenance
+    void RegisterGrowing(int index, FarmPlot* plot);
+    void UnregisterGrowing(int index);
+    static void GrowCropBand(const int* tiles, FarmPlot* const* plots, int count, std::vector<int>& ripeTiles);
+
+    // Timer wheel helpers
+    static std::uint64_t EventKey(int index, TileEventType type);
+    void ScheduleEvent(int index, TileEventType type, float delaySeconds);
+    void CancelEvents(int index);
+    void HandleTileEvent(const TileEvent& event);
     
     // Helper methods for rendering
+    static bool IsAnimatedTile(TileType type) { return type == TileType::WATER || type == TileType::CROP; }
+    void DrawTile(Renderer* renderer, SpriteSheet* sheet, const Tile* tile, int x, int y, Season season, const TilesetConfig* config);
+    void RenderBaked(Renderer* renderer, SpriteSheet* sheet, Season season, const TilesetConfig* config, int x0, int y0, int x1, int y1);
+    void BakeChunk(Renderer* renderer, SpriteSheet* sheet, Season season, const TilesetConfig* config, int chunkIndex);
+    void ReleaseBakedChunk(int chunkIndex);
+    void ReleaseBakedChunks();
     void RenderTileFallback(Renderer* renderer, const Tile* tile, int screenX, int screenY);
-    int GetTileSpriteId(const Tile* tile) const;
-    int GetTileSpriteId(const Tile* tile, Season season, const TilesetConfig* config) const;
 };
 
 #endif // MAP_H
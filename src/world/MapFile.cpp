@@ -0,0 +1,428 @@
+#include "MapFile.h"
+#include "Map.h"
+#include "WorldGenerator.h"
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <type_traits>
+#include <vector>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+static_assert(std::endian::native == std::endian::little, ".hqmap is written in host byte order");
+static_assert(sizeof(MapFileHeader) == 48, "MapFileHeader layout is part of the file format");
+static_assert(sizeof(MapFilePlot) == 8, "MapFilePlot layout is part of the file format");
+static_assert(sizeof(MapDeltaHeader) == 32, "MapDeltaHeader layout is part of the file format");
+static_assert(sizeof(MapDeltaEntry) == 12, "MapDeltaEntry layout is part of the file format");
+static_assert(sizeof(Tile) == 2 && std::is_trivially_copyable_v<Tile> && std::is_standard_layout_v<Tile>,
+              "Chunk tiles are copied to and from the file as raw (type, visual id) bytes");
+
+bool MapFile::IsValidTileType(int type) {
+    return type >= 0 && type < TILE_TYPE_COUNT;
+}
+
+bool MapFile::IsValidSoilState(int state) {
+    return state >= 0 && state <= static_cast<int>(SoilState::HARVEST);
+}
+
+namespace {
+
+constexpr std::size_t CHUNK_BYTES = sizeof(TileChunk::tiles);
+
+// Every visual byte is a valid variant, so only the type byte of each tile
+// needs checking
+bool IsValidChunk(const unsigned char* data) {
+    for (std::size_t i = 0; i < CHUNK_BYTES; i += sizeof(Tile)) {
+        if (!MapFile::IsValidTileType(data[i])) return false;
+    }
+    return true;
+}
+
+// Read-only view of a whole file: mmap where available, a plain read elsewhere
+class MappedFile {
+public:
+    explicit MappedFile(const std::string& filepath) {
+#ifdef _WIN32
+        std::ifstream file(filepath, std::ios::binary);
+        if (!file.is_open()) return;
+        m_buffer.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+        m_data = reinterpret_cast<const unsigned char*>(m_buffer.data());
+        m_size = m_buffer.size();
+        m_open = true;
+#else
+        int fd = open(filepath.c_str(), O_RDONLY);
+        if (fd < 0) return;
+        struct stat info;
+        if (fstat(fd, &info) == 0 && info.st_size > 0) {
+            void* mapped = mmap(nullptr, static_cast<std::size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+            if (mapped != MAP_FAILED) {
+                m_data = static_cast<const unsigned char*>(mapped);
+                m_size = static_cast<std::size_t>(info.st_size);
+            }
+        }
+        m_open = true;
+        close(fd);   // The mapping stays valid after the descriptor is closed
+#endif
+    }
+
+    ~MappedFile() {
+#ifndef _WIN32
+        if (m_data) munmap(const_cast<unsigned char*>(m_data), m_size);
+#endif
+    }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    bool IsOpen() const { return m_open; }
+    const unsigned char* Data() const { return m_data; }
+    std::size_t Size() const { return m_size; }
+
+    // Bounds-checked access to [offset, offset + length)
+    bool Contains(std::uint64_t offset, std::uint64_t length) const {
+        return offset <= m_size && length <= m_size - offset;
+    }
+
+private:
+    const unsigned char* m_data = nullptr;
+    std::size_t m_size = 0;
+    bool m_open = false;
+#ifdef _WIN32
+    std::vector<char> m_buffer;
+#endif
+};
+
+} // namespace
+
+bool MapFile::IsBinaryFile(const std::string& filepath) {
+    std::ifstream file(filepath, std::ios::binary);
+    char magic[sizeof(MAGIC)] = {};
+    if (!file.read(magic, sizeof(magic))) return false;
+    return std::memcmp(magic, MAGIC, sizeof(MAGIC)) == 0;
+}
+
+bool MapFile::Save(const Map& map, const std::string& filepath) {
+    std::ofstream file(filepath, std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) {
+        std::cout << "MapFile: Cannot open file for writing: " << filepath << std::endl;
+        return false;
+    }
+
+    const int chunksX = map.GetChunksX();
+    const int chunksY = map.GetChunksY();
+    const std::size_t chunkCount = static_cast<std::size_t>(chunksX) * chunksY;
+
+    // Only chunks that hold data are written; the rest read back as fill
+    std::vector<const TileChunk*> chunks(chunkCount);
+    std::vector<std::uint64_t> directory(chunkCount, 0);
+    std::uint64_t offset = sizeof(MapFileHeader) + chunkCount * sizeof(std::uint64_t);
+    for (int cy = 0; cy < chunksY; ++cy) {
+        for (int cx = 0; cx < chunksX; ++cx) {
+            std::size_t i = static_cast<std::size_t>(cy) * chunksX + cx;
+            chunks[i] = map.GetChunk(cx, cy);
+            if (chunks[i]) {
+                directory[i] = offset;
+                offset += CHUNK_BYTES;
+            }
+        }
+    }
+
+    // Plots in tile order so identical maps give identical files
+    std::vector<MapFilePlot> plots;
+    plots.reserve(map.GetFarmPlots().size());
+    for (const auto& entry : map.GetFarmPlots()) {
+        const FarmPlot& plot = entry.second;
+        MapFilePlot record{};
+        record.tileIndex = entry.first;
+        record.soilState = static_cast<std::uint8_t>(plot.GetSoilState());
+        record.cropType = static_cast<std::int8_t>(plot.GetCropType());
+        record.growthStage = static_cast<std::uint8_t>(plot.GetGrowthStage());
+        plots.push_back(record);
+    }
+    std::sort(plots.begin(), plots.end(),
+              [](const MapFilePlot& a, const MapFilePlot& b) { return a.tileIndex < b.tileIndex; });
+
+    MapFileHeader header{};
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version = VERSION;
+    header.headerSize = sizeof(MapFileHeader);
+    header.width = map.GetWidth();
+    header.height = map.GetHeight();
+    header.chunkSize = Map::CHUNK_SIZE;
+    header.chunksX = static_cast<std::uint32_t>(chunksX);
+    header.chunksY = static_cast<std::uint32_t>(chunksY);
+    header.plotCount = static_cast<std::uint32_t>(plots.size());
+    header.fillType = static_cast<std::uint8_t>(map.GetFillTile().GetType());
+    header.fillVisual = static_cast<std::uint8_t>(map.GetFillTile().GetVisualId());
+    header.plotOffset = offset;
+
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file.write(reinterpret_cast<const char*>(directory.data()), directory.size() * sizeof(std::uint64_t));
+    for (const TileChunk* chunk : chunks) {
+        if (chunk) file.write(reinterpret_cast<const char*>(chunk->tiles), CHUNK_BYTES);
+    }
+    file.write(reinterpret_cast<const char*>(plots.data()), plots.size() * sizeof(MapFilePlot));
+
+    if (!file.good()) {
+        std::cout << "MapFile: Write failed: " << filepath << std::endl;
+        return false;
+    }
+    return true;
+}
+
+bool MapFile::Load(Map& map, const std::string& filepath) {
+    MappedFile file(filepath);
+    if (!file.IsOpen()) {
+        std::cout << "MapFile: Cannot open file: " << filepath << std::endl;
+        return false;
+    }
+    if (!file.Contains(0, sizeof(MapFileHeader))) {
+        std::cout << "MapFile: File too small: " << filepath << std::endl;
+        return false;
+    }
+
+    MapFileHeader header;
+    std::memcpy(&header, file.Data(), sizeof(header));
+    if (std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0) {
+        std::cout << "MapFile: Not a .hqmap file: " << filepath << std::endl;
+        return false;
+    }
+    if (header.version != VERSION || header.headerSize < sizeof(MapFileHeader)) {
+        std::cout << "MapFile: Unsupported version " << header.version << std::endl;
+        return false;
+    }
+    if (header.width <= 0 || header.height <= 0 || header.chunkSize != Map::CHUNK_SIZE ||
+        header.chunksX != (static_cast<std::uint64_t>(header.width) + Map::CHUNK_SIZE - 1) / Map::CHUNK_SIZE ||
+        header.chunksY != (static_cast<std::uint64_t>(header.height) + Map::CHUNK_SIZE - 1) / Map::CHUNK_SIZE) {
+        std::cout << "MapFile: Invalid dimensions" << std::endl;
+        return false;
+    }
+
+    const std::uint64_t chunkCount = static_cast<std::uint64_t>(header.chunksX) * header.chunksY;
+    const std::uint64_t directoryOffset = header.headerSize;
+    if (!file.Contains(directoryOffset, chunkCount * sizeof(std::uint64_t)) ||
+        !file.Contains(header.plotOffset, static_cast<std::uint64_t>(header.plotCount) * sizeof(MapFilePlot))) {
+        std::cout << "MapFile: Truncated file: " << filepath << std::endl;
+        return false;
+    }
+
+    // Validate every chunk, tile and plot before touching the map
+    std::vector<std::uint64_t> directory(chunkCount);
+    std::memcpy(directory.data(), file.Data() + directoryOffset, chunkCount * sizeof(std::uint64_t));
+    for (std::uint64_t offset : directory) {
+        if (offset != 0 && !file.Contains(offset, CHUNK_BYTES)) {
+            std::cout << "MapFile: Chunk data out of range" << std::endl;
+            return false;
+        }
+        if (offset != 0 && !IsValidChunk(file.Data() + offset)) {
+            std::cout << "MapFile: Invalid tile type in chunk data: " << filepath << std::endl;
+            return false;
+        }
+    }
+    if (!IsValidTileType(header.fillType)) {
+        std::cout << "MapFile: Invalid fill tile type: " << filepath << std::endl;
+        return false;
+    }
+    const unsigned char* plotData = file.Data() + header.plotOffset;
+    for (std::uint32_t i = 0; i < header.plotCount; ++i) {
+        MapFilePlot record;
+        std::memcpy(&record, plotData + i * sizeof(MapFilePlot), sizeof(record));
+        if (!IsValidSoilState(record.soilState)) {
+            std::cout << "MapFile: Invalid soil state in plot data: " << filepath << std::endl;
+            return false;
+        }
+    }
+
+    map.Reset(header.width, header.height);
+    Tile fill(static_cast<TileType>(header.fillType), header.fillVisual);
+    bool sameFill = fill.GetType() == map.GetFillTile().GetType() &&
+                    fill.GetVisualId() == map.GetFillTile().GetVisualId();
+    for (std::uint32_t cy = 0; cy < header.chunksY; ++cy) {
+        for (std::uint32_t cx = 0; cx < header.chunksX; ++cx) {
+            std::uint64_t offset = directory[static_cast<std::size_t>(cy) * header.chunksX + cx];
+            if (offset == 0 && sameFill) continue;   // Reads as fill without any storage
+            TileChunk* chunk = map.EnsureChunkAt(static_cast<int>(cx), static_cast<int>(cy));
+            if (offset != 0) {
+                std::memcpy(chunk->tiles, file.Data() + offset, CHUNK_BYTES);
+            } else {
+                std::fill(std::begin(chunk->tiles), std::end(chunk->tiles), fill);
+            }
+            map.RefreshChunkSolidity(static_cast<int>(cx), static_cast<int>(cy));
+        }
+    }
+
+    for (std::uint32_t i = 0; i < header.plotCount; ++i) {
+        MapFilePlot record;
+        std::memcpy(&record, plotData + i * sizeof(MapFilePlot), sizeof(record));
+        if (record.tileIndex < 0 ||
+            record.tileIndex >= static_cast<std::int64_t>(header.width) * header.height) continue;
+
+        FarmPlot plot;
+        plot.SetSoilState(static_cast<SoilState>(record.soilState));
+        plot.SetCropType(record.cropType);
+        plot.SetGrowthStage(record.growthStage);
+        int x, y;
+        map.IndexToTile(record.tileIndex, x, y);
+        map.SetFarmPlot(x, y, plot);
+    }
+
+    std::cout << "Map: Loaded " << header.width << "x" << header.height << " map from " << filepath << std::endl;
+    return true;
+}
+
+bool MapFile::SaveDelta(const Map& map, const std::string& filepath) {
+    if (!map.HasOrigin()) {
+        std::cout << "MapFile: Map has no generator origin, cannot save a delta: " << filepath << std::endl;
+        return false;
+    }
+    if (map.GetOrigin().width > MAX_DELTA_DIMENSION || map.GetOrigin().height > MAX_DELTA_DIMENSION) {
+        std::cout << "MapFile: Map too large for a delta save: " << filepath << std::endl;
+        return false;
+    }
+
+    // Journaled tiles plus every farm plot (crops grow without touching tiles)
+    std::vector<int> indices(map.GetChangedTiles().begin(), map.GetChangedTiles().end());
+    for (const auto& entry : map.GetFarmPlots()) {
+        if (map.GetChangedTiles().count(entry.first) == 0) indices.push_back(entry.first);
+    }
+    std::sort(indices.begin(), indices.end());
+
+    std::vector<MapDeltaEntry> entries;
+    entries.reserve(indices.size());
+    for (int index : indices) {
+        int x, y;
+        map.IndexToTile(index, x, y);
+        const Tile* tile = map.GetTileAt(x, y);
+        if (!tile) continue;
+
+        MapDeltaEntry record{};
+        record.tileIndex = index;
+        record.tileType = static_cast<std::uint8_t>(tile->GetType());
+        record.visualId = static_cast<std::uint8_t>(tile->GetVisualId());
+        record.cropType = -1;
+        if (const FarmPlot* plot = map.GetFarmPlot(x, y)) {
+            record.hasPlot = 1;
+            record.soilState = static_cast<std::uint8_t>(plot->GetSoilState());
+            record.cropType = static_cast<std::int8_t>(plot->GetCropType());
+            record.growthStage = static_cast<std::uint8_t>(plot->GetGrowthStage());
+        }
+        entries.push_back(record);
+    }
+
+    const MapOrigin& origin = map.GetOrigin();
+    MapDeltaHeader header{};
+    std::memcpy(header.magic, DELTA_MAGIC, sizeof(DELTA_MAGIC));
+    header.version = DELTA_VERSION;
+    header.headerSize = sizeof(MapDeltaHeader);
+    header.kind = static_cast<std::uint8_t>(origin.kind);
+    header.biome = origin.biome;
+    header.seed = origin.seed;
+    header.width = origin.width;
+    header.height = origin.height;
+    header.entryCount = static_cast<std::uint32_t>(entries.size());
+
+    std::ofstream file(filepath, std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) {
+        std::cout << "MapFile: Cannot open file for writing: " << filepath << std::endl;
+        return false;
+    }
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file.write(reinterpret_cast<const char*>(entries.data()), entries.size() * sizeof(MapDeltaEntry));
+    if (!file.good()) {
+        std::cout << "MapFile: Write failed: " << filepath << std::endl;
+        return false;
+    }
+    return true;
+}
+
+bool MapFile::LoadDelta(Map& map, const std::string& filepath) {
+    MappedFile file(filepath);
+    if (!file.IsOpen()) {
+        std::cout << "MapFile: Cannot open file: " << filepath << std::endl;
+        return false;
+    }
+    if (!file.Contains(0, sizeof(MapDeltaHeader))) {
+        std::cout << "MapFile: File too small: " << filepath << std::endl;
+        return false;
+    }
+
+    MapDeltaHeader header;
+    std::memcpy(&header, file.Data(), sizeof(header));
+    if (std::memcmp(header.magic, DELTA_MAGIC, sizeof(DELTA_MAGIC)) != 0) {
+        std::cout << "MapFile: Not a .hqdelta file: " << filepath << std::endl;
+        return false;
+    }
+    if (header.version != DELTA_VERSION || header.headerSize < sizeof(MapDeltaHeader)) {
+        std::cout << "MapFile: Unsupported delta version " << header.version << std::endl;
+        return false;
+    }
+    if (header.width <= 0 || header.height <= 0 ||
+        header.width > MAX_DELTA_DIMENSION || header.height > MAX_DELTA_DIMENSION) {
+        std::cout << "MapFile: Invalid dimensions" << std::endl;
+        return false;
+    }
+    if (!file.Contains(header.headerSize, static_cast<std::uint64_t>(header.entryCount) * sizeof(MapDeltaEntry))) {
+        std::cout << "MapFile: Truncated file: " << filepath << std::endl;
+        return false;
+    }
+
+    // Validate every entry before regenerating anything
+    const unsigned char* entryData = file.Data() + header.headerSize;
+    for (std::uint32_t i = 0; i < header.entryCount; ++i) {
+        MapDeltaEntry record;
+        std::memcpy(&record, entryData + i * sizeof(MapDeltaEntry), sizeof(record));
+        if (!IsValidTileType(record.tileType) || (record.hasPlot && !IsValidSoilState(record.soilState))) {
+            std::cout << "MapFile: Invalid tile or soil byte in delta entry " << i << ": " << filepath << std::endl;
+            return false;
+        }
+    }
+
+    // Rebuild the baseline exactly as it was generated
+    WorldGenerator generator;
+    generator.SetSeed(header.seed);
+    switch (static_cast<MapOrigin::Kind>(header.kind)) {
+        case MapOrigin::Kind::FARM:
+            generator.GenerateFarm(&map, header.width, header.height);
+            break;
+        case MapOrigin::Kind::DUNGEON:
+            generator.GenerateDungeon(&map, header.width, header.height);
+            break;
+        case MapOrigin::Kind::OVERWORLD:
+            generator.GenerateOverworld(&map, header.width, header.height, static_cast<Biome>(header.biome));
+            break;
+        default:
+            std::cout << "MapFile: Unknown map kind " << static_cast<int>(header.kind) << std::endl;
+            return false;
+    }
+
+    // Replay the changes; they go back into the journal for the next save
+    const std::int64_t tileCount = static_cast<std::int64_t>(header.width) * header.height;
+    for (std::uint32_t i = 0; i < header.entryCount; ++i) {
+        MapDeltaEntry record;
+        std::memcpy(&record, entryData + i * sizeof(MapDeltaEntry), sizeof(record));
+        if (record.tileIndex < 0 || record.tileIndex >= tileCount) continue;
+
+        int x, y;
+        map.IndexToTile(record.tileIndex, x, y);
+        map.SetTile(x, y, Tile(static_cast<TileType>(record.tileType), record.visualId));
+        if (record.hasPlot) {
+            FarmPlot plot;
+            plot.SetSoilState(static_cast<SoilState>(record.soilState));
+            plot.SetCropType(record.cropType);
+            plot.SetGrowthStage(record.growthStage);
+            map.SetFarmPlot(x, y, plot);
+        }
+    }
+
+    std::cout << "Map: Loaded " << header.width << "x" << header.height << " map from seed "
+              << header.seed << " with " << header.entryCount << " changes" << std::endl;
+    return true;
+}
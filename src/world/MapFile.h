@@ -0,0 +1,110 @@
+#ifndef MAPFILE_H
+#define MAPFILE_H
+
+#include <cstdint>
+#include <string>
+
+class Map;
+
+// On-disk header of a .hqmap file (little-endian, 48 bytes)
+struct MapFileHeader {
+    char magic[4];              // "HQMP"
+    std::uint32_t version;
+    std::uint32_t headerSize;   // sizeof(MapFileHeader) when written
+    std::int32_t width;         // In tiles
+    std::int32_t height;
+    std::uint32_t chunkSize;    // Tiles per chunk side
+    std::uint32_t chunksX;
+    std::uint32_t chunksY;
+    std::uint32_t plotCount;
+    std::uint8_t fillType;      // Tile that unwritten chunks read as
+    std::uint8_t fillVisual;
+    std::uint16_t reserved;
+    std::uint64_t plotOffset;   // Byte offset of the farm plot records
+};
+
+// One farm plot record (8 bytes)
+struct MapFilePlot {
+    std::int32_t tileIndex;
+    std::uint8_t soilState;
+    std::int8_t cropType;       // -1 = no crop
+    std::uint8_t growthStage;
+    std::uint8_t reserved;
+};
+
+// On-disk header of a .hqdelta file (little-endian, 32 bytes)
+struct MapDeltaHeader {
+    char magic[4];              // "HQMD"
+    std::uint32_t version;
+    std::uint32_t headerSize;   // sizeof(MapDeltaHeader) when written
+    std::uint8_t kind;          // MapOrigin::Kind
+    std::uint8_t biome;
+    std::uint16_t reserved;
+    std::uint32_t seed;
+    std::int32_t width;         // In tiles
+    std::int32_t height;
+    std::uint32_t entryCount;
+};
+
+// One changed tile (12 bytes)
+struct MapDeltaEntry {
+    std::int32_t tileIndex;
+    std::uint8_t tileType;
+    std::uint8_t visualId;
+    std::uint8_t hasPlot;       // 1 if the plot fields below are set
+    std::uint8_t soilState;
+    std::int8_t cropType;       // -1 = no crop
+    std::uint8_t growthStage;
+    std::uint16_t reserved;
+};
+
+/**
+ * MapFile - versioned binary map format (.hqmap)
+ *
+ * Layout:
+ *   MapFileHeader
+ *   Chunk directory: chunksX * chunksY uint64 byte offsets, row-major;
+ *                    0 marks a chunk that was never written (all fill tiles)
+ *   Chunk data:      chunkSize^2 tiles per chunk, 2 bytes each (type,
+ *                    visual id), in the same order as TileChunk::tiles
+ *   Farm plots:      plotCount MapFilePlot records
+ *
+ * Loading maps the file read-only and copies each chunk straight out of the
+ * mapping; nothing is parsed per tile. The text format remains available
+ * through Map::LoadFromFile/SaveToFile for import and export.
+ *
+ * Delta saves (.hqdelta) are for generated maps. They hold the map's
+ * MapOrigin and one MapDeltaEntry per journaled tile or farm plot, sorted by
+ * tile index; nothing else. Loading regenerates the map from the origin and
+ * replays the entries, so both file size and save time follow the number of
+ * changes rather than the map area.
+ */
+class MapFile {
+public:
+    static constexpr char MAGIC[4] = { 'H', 'Q', 'M', 'P' };
+    static constexpr std::uint32_t VERSION = 1;
+    static constexpr const char* EXTENSION = ".hqmap";
+
+    // True if the file starts with the .hqmap magic
+    static bool IsBinaryFile(const std::string& filepath);
+
+    static bool Save(const Map& map, const std::string& filepath);
+    static bool Load(Map& map, const std::string& filepath);
+
+    // Enum values read from any map file must name a real value before they
+    // are cast: tile types index TileRegistry and the sprite table
+    static bool IsValidTileType(int type);
+    static bool IsValidSoilState(int state);
+
+    static constexpr char DELTA_MAGIC[4] = { 'H', 'Q', 'M', 'D' };
+    static constexpr std::uint32_t DELTA_VERSION = 1;
+    static constexpr const char* DELTA_EXTENSION = ".hqdelta";
+    // Largest side a delta may regenerate; the file size doesn't bound it
+    static constexpr std::int32_t MAX_DELTA_DIMENSION = 8192;
+
+    // Fails for maps without an origin (loaded or hand-built maps)
+    static bool SaveDelta(const Map& map, const std::string& filepath);
+    static bool LoadDelta(Map& map, const std::string& filepath);
+};
+
+#endif // MAPFILE_H
@@ -0,0 +1,482 @@
+#include "PathGraph.h"
+#include "Map.h"
+#include "SolidityGrid.h"
+#include <algorithm>
+#include <climits>
+#include <cstdlib>
+#include <functional>
+#include <queue>
+#include <tuple>
+
+namespace {
+
+constexpr int DIR_X[8] = { 1, -1, 0, 0, 1, 1, -1, -1 };
+constexpr int DIR_Y[8] = { 0, 0, 1, -1, 1, -1, 1, -1 };
+
+} // namespace
+
+PathGraph::PathGraph(Map* map)
+    : m_map(map)
+    , m_width(0)
+    , m_height(0)
+    , m_clustersX(0)
+    , m_clustersY(0)
+    , m_builtGeneration(0)
+    , m_built(false)
+{
+    m_map->SetSolidityChangeHandler([this](int x, int y) {
+        OnSolidityChanged(x, y);
+    });
+}
+
+PathGraph::PathGraph()
+    : m_map(nullptr)
+    , m_width(0)
+    , m_height(0)
+    , m_clustersX(0)
+    , m_clustersY(0)
+    , m_builtGeneration(0)
+    , m_built(false)
+{
+}
+
+PathGraph::~PathGraph() {
+    if (m_map) m_map->SetSolidityChangeHandler(nullptr);
+}
+
+void PathGraph::SetGrid(std::shared_ptr<const SolidityGrid> grid) {
+    if (m_map || grid == m_grid) return;
+    if (m_built && m_grid && grid && grid->GetWidth() == m_width && grid->GetHeight() == m_height) {
+        grid->ForEachDifference(*m_grid, [this](int x, int y) { OnSolidityChanged(x, y); });
+    } else {
+        m_built = false;
+    }
+    m_grid = std::move(grid);
+}
+
+void PathGraph::OnSolidityChanged(int x, int y) {
+    if (!m_built || x < 0 || y < 0 || x >= m_width || y >= m_height) return;
+    Cluster& cluster = m_clusters[ClusterAt(x, y)];
+    if (!cluster.dirty) {
+        cluster.dirty = true;
+        m_dirtyClusters.push_back(ClusterAt(x, y));
+    }
+}
+
+bool PathGraph::FindPath(int startX, int startY, int goalX, int goalY, std::vector<PathTile>& out) {
+    out.clear();
+    if (!m_map && !m_grid) return false;
+    Repair();
+    if (!IsOpen(startX, startY) || !IsOpen(goalX, goalY)) return false;
+    if (startX == goalX && startY == goalY) return true;
+
+    int startCluster = ClusterAt(startX, startY);
+    int goalCluster = ClusterAt(goalX, goalY);
+
+    // Short trips stay inside one cluster and skip the abstract graph
+    if (startCluster == goalCluster) {
+        if (AppendLocalPath(startCluster, startX, startY, goalX, goalY, out)) return true;
+        out.clear();
+    }
+
+    std::uint64_t key = (static_cast<std::uint64_t>(startCluster) << 32) |
+                        static_cast<std::uint32_t>(goalY * m_width + goalX);
+    auto cached = m_routes.find(key);
+    if (cached != m_routes.end()) {
+        const Node& first = m_nodes[cached->second.firstNode];
+        if (AppendLocalPath(startCluster, startX, startY, first.x, first.y, out)) {
+            out.insert(out.end(), cached->second.tail.begin(), cached->second.tail.end());
+            m_cacheHits++;
+            return true;
+        }
+        // That entrance is walled off from this start tile; search afresh
+        out.clear();
+    }
+
+    std::vector<int> nodePath;
+    if (!SearchAbstract(startX, startY, goalX, goalY, nodePath)) return false;
+
+    // Refine one abstract edge at a time
+    CachedRoute route;
+    route.firstNode = nodePath.front();
+    const Node& first = m_nodes[route.firstNode];
+    if (!AppendLocalPath(startCluster, startX, startY, first.x, first.y, out)) return false;
+    route.clusters.push_back(startCluster);
+    route.clusters.push_back(goalCluster);
+    for (size_t i = 1; i < nodePath.size(); ++i) {
+        const Node& prev = m_nodes[nodePath[i - 1]];
+        const Node& next = m_nodes[nodePath[i]];
+        route.clusters.push_back(next.cluster);
+        if (prev.peer == nodePath[i]) {
+            route.tail.push_back({next.x, next.y});
+        } else if (!AppendLocalPath(next.cluster, prev.x, prev.y, next.x, next.y, route.tail)) {
+            return false;
+        }
+    }
+    const Node& last = m_nodes[nodePath.back()];
+    if (!AppendLocalPath(goalCluster, last.x, last.y, goalX, goalY, route.tail)) return false;
+
+    out.insert(out.end(), route.tail.begin(), route.tail.end());
+    std::sort(route.clusters.begin(), route.clusters.end());
+    route.clusters.erase(std::unique(route.clusters.begin(), route.clusters.end()), route.clusters.end());
+    if (static_cast<int>(m_routes.size()) >= MAX_CACHED_ROUTES) m_routes.clear();
+    m_routes[key] = std::move(route);
+    return true;
+}
+
+void PathGraph::Build() {
+    const SolidityGrid& solidity = Grid();
+    m_width = solidity.GetWidth();
+    m_height = solidity.GetHeight();
+    m_clustersX = (m_width + CLUSTER_SIZE - 1) / CLUSTER_SIZE;
+    m_clustersY = (m_height + CLUSTER_SIZE - 1) / CLUSTER_SIZE;
+
+    m_nodes.clear();
+    m_freeNodes.clear();
+    m_dirtyClusters.clear();
+    m_routes.clear();
+    m_localCluster = nullptr;
+    m_clusters.assign(static_cast<size_t>(m_clustersX) * m_clustersY, Cluster());
+    for (int cy = 0; cy < m_clustersY; ++cy) {
+        for (int cx = 0; cx < m_clustersX; ++cx) {
+            Cluster& cluster = m_clusters[cy * m_clustersX + cx];
+            cluster.x0 = cx * CLUSTER_SIZE;
+            cluster.y0 = cy * CLUSTER_SIZE;
+            cluster.x1 = std::min(cluster.x0 + CLUSTER_SIZE, m_width) - 1;
+            cluster.y1 = std::min(cluster.y0 + CLUSTER_SIZE, m_height) - 1;
+        }
+    }
+
+    for (int c = 0; c < static_cast<int>(m_clusters.size()); ++c) {
+        BuildEastBorder(c);
+        BuildSouthBorder(c);
+    }
+    for (int c = 0; c < static_cast<int>(m_clusters.size()); ++c) {
+        BuildIntraEdges(c);
+    }
+
+    m_builtGeneration = m_map ? m_map->GetChunkGeneration() : 0;
+    m_built = true;
+    m_fullBuilds++;
+    m_repairedClusters = 0;
+}
+
+void PathGraph::Repair() {
+    const SolidityGrid& solidity = Grid();
+    if (!m_built || (m_map && m_builtGeneration != m_map->GetChunkGeneration()) ||
+        solidity.GetWidth() != m_width || solidity.GetHeight() != m_height) {
+        Build();
+        return;
+    }
+    if (m_dirtyClusters.empty()) return;
+
+    // A dirty cluster's four borders are redone, which changes the entrance
+    // nodes of the clusters on the other side too
+    std::vector<int> touched;
+    for (int c : m_dirtyClusters) {
+        int cx = c % m_clustersX;
+        int cy = c / m_clustersX;
+        BuildEastBorder(c);
+        BuildSouthBorder(c);
+        touched.push_back(c);
+        if (cx + 1 < m_clustersX) touched.push_back(c + 1);
+        if (cy + 1 < m_clustersY) touched.push_back(c + m_clustersX);
+        if (cx > 0) {
+            BuildEastBorder(c - 1);
+            touched.push_back(c - 1);
+        }
+        if (cy > 0) {
+            BuildSouthBorder(c - m_clustersX);
+            touched.push_back(c - m_clustersX);
+        }
+        m_clusters[c].dirty = false;
+    }
+    m_dirtyClusters.clear();
+
+    std::sort(touched.begin(), touched.end());
+    touched.erase(std::unique(touched.begin(), touched.end()), touched.end());
+    std::vector<std::uint8_t> repaired(m_clusters.size(), 0);
+    for (int c : touched) {
+        BuildIntraEdges(c);
+        repaired[c] = 1;
+    }
+    m_repairedClusters += static_cast<int>(touched.size());
+
+    // Cached routes through a repaired cluster may be blocked or use freed nodes
+    for (auto it = m_routes.begin(); it != m_routes.end();) {
+        bool stale = std::any_of(it->second.clusters.begin(), it->second.clusters.end(),
+                                 [&repaired](int c) { return repaired[c] != 0; });
+        it = stale ? m_routes.erase(it) : std::next(it);
+    }
+}
+
+const SolidityGrid& PathGraph::Grid() const {
+    return m_map ? m_map->GetSolidityGrid() : *m_grid;
+}
+
+bool PathGraph::IsOpen(int x, int y) const {
+    return !Grid().IsSolid(x, y);
+}
+
+int PathGraph::ClusterAt(int x, int y) const {
+    return (y / CLUSTER_SIZE) * m_clustersX + x / CLUSTER_SIZE;
+}
+
+int PathGraph::AllocNode(int x, int y, int cluster) {
+    int id;
+    if (!m_freeNodes.empty()) {
+        id = m_freeNodes.back();
+        m_freeNodes.pop_back();
+    } else {
+        id = static_cast<int>(m_nodes.size());
+        m_nodes.emplace_back();
+    }
+    Node& node = m_nodes[id];
+    node.x = x;
+    node.y = y;
+    node.cluster = cluster;
+    node.peer = -1;
+    node.edges.clear();
+    m_clusters[cluster].nodes.push_back(id);
+    return id;
+}
+
+void PathGraph::FreeNode(int id) {
+    Node& node = m_nodes[id];
+    std::vector<int>& nodes = m_clusters[node.cluster].nodes;
+    nodes.erase(std::find(nodes.begin(), nodes.end(), id));
+    node.cluster = -1;
+    node.peer = -1;
+    node.edges.clear();
+    m_freeNodes.push_back(id);
+}
+
+void PathGraph::ClearBorder(std::vector<int>& sideNodes) {
+    for (int id : sideNodes) {
+        FreeNode(m_nodes[id].peer);
+        FreeNode(id);
+    }
+    sideNodes.clear();
+}
+
+void PathGraph::BuildEastBorder(int cluster) {
+    ClearBorder(m_clusters[cluster].eastNodes);
+    if (cluster % m_clustersX + 1 >= m_clustersX) return;
+
+    const Cluster& west = m_clusters[cluster];
+    int x = west.x1;
+    int runStart = -1;
+    for (int y = west.y0; y <= west.y1 + 1; ++y) {
+        bool open = y <= west.y1 && IsOpen(x, y) && IsOpen(x + 1, y);
+        if (open && runStart < 0) runStart = y;
+        if (open || runStart < 0) continue;
+
+        // Border run [runStart, y - 1] is open on both sides
+        int runEnd = y - 1;
+        if (runEnd - runStart + 1 <= MAX_SINGLE_ENTRANCE) {
+            int mid = (runStart + runEnd) / 2;
+            LinkEntrance(cluster, x, mid, cluster + 1, x + 1, mid, m_clusters[cluster].eastNodes);
+        } else {
+            LinkEntrance(cluster, x, runStart, cluster + 1, x + 1, runStart, m_clusters[cluster].eastNodes);
+            LinkEntrance(cluster, x, runEnd, cluster + 1, x + 1, runEnd, m_clusters[cluster].eastNodes);
+        }
+        runStart = -1;
+    }
+}
+
+void PathGraph::BuildSouthBorder(int cluster) {
+    ClearBorder(m_clusters[cluster].southNodes);
+    if (cluster / m_clustersX + 1 >= m_clustersY) return;
+
+    const Cluster& north = m_clusters[cluster];
+    int south = cluster + m_clustersX;
+    int y = north.y1;
+    int runStart = -1;
+    for (int x = north.x0; x <= north.x1 + 1; ++x) {
+        bool open = x <= north.x1 && IsOpen(x, y) && IsOpen(x, y + 1);
+        if (open && runStart < 0) runStart = x;
+        if (open || runStart < 0) continue;
+
+        int runEnd = x - 1;
+        if (runEnd - runStart + 1 <= MAX_SINGLE_ENTRANCE) {
+            int mid = (runStart + runEnd) / 2;
+            LinkEntrance(cluster, mid, y, south, mid, y + 1, m_clusters[cluster].southNodes);
+        } else {
+            LinkEntrance(cluster, runStart, y, south, runStart, y + 1, m_clusters[cluster].southNodes);
+            LinkEntrance(cluster, runEnd, y, south, runEnd, y + 1, m_clusters[cluster].southNodes);
+        }
+        runStart = -1;
+    }
+}
+
+void PathGraph::LinkEntrance(int clusterA, int ax, int ay, int clusterB, int bx, int by, std::vector<int>& sideNodes) {
+    int a = AllocNode(ax, ay, clusterA);
+    int b = AllocNode(bx, by, clusterB);
+    m_nodes[a].peer = b;
+    m_nodes[b].peer = a;
+    sideNodes.push_back(a);
+}
+
+void PathGraph::BuildIntraEdges(int cluster) {
+    const std::vector<int>& nodes = m_clusters[cluster].nodes;
+    for (int id : nodes) {
+        m_nodes[id].edges.clear();
+    }
+    for (int id : nodes) {
+        SearchCluster(cluster, m_nodes[id].x, m_nodes[id].y);
+        for (int other : nodes) {
+            if (other == id) continue;
+            int distance = LocalDistance(m_nodes[other].x, m_nodes[other].y);
+            if (distance >= 0) m_nodes[id].edges.push_back({other, distance});
+        }
+    }
+}
+
+void PathGraph::SearchCluster(int cluster, int sx, int sy, int gx, int gy) {
+    if (m_localStamp.size() < static_cast<size_t>(CLUSTER_SIZE * CLUSTER_SIZE)) {
+        m_localDist.assign(CLUSTER_SIZE * CLUSTER_SIZE, 0);
+        m_localParent.assign(CLUSTER_SIZE * CLUSTER_SIZE, -1);
+        m_localStamp.assign(CLUSTER_SIZE * CLUSTER_SIZE, 0);
+    }
+    if (++m_localSearch == 0) {
+        std::fill(m_localStamp.begin(), m_localStamp.end(), 0);
+        m_localSearch = 1;
+    }
+    const Cluster& bounds = m_clusters[cluster];
+    m_localCluster = &bounds;
+    if (sx < bounds.x0 || sx > bounds.x1 || sy < bounds.y0 || sy > bounds.y1 || !IsOpen(sx, sy)) return;
+
+    auto local = [&bounds](int x, int y) { return (y - bounds.y0) * CLUSTER_SIZE + (x - bounds.x0); };
+    int goal = (gx >= 0 && gy >= 0) ? local(gx, gy) : -1;
+
+    using Entry = std::pair<int, int>;   // (distance, local index)
+    std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> open;
+    int start = local(sx, sy);
+    m_localStamp[start] = m_localSearch;
+    m_localDist[start] = 0;
+    m_localParent[start] = -1;
+    open.push({0, start});
+
+    while (!open.empty()) {
+        auto [distance, index] = open.top();
+        open.pop();
+        if (distance > m_localDist[index]) continue;
+        if (index == goal) break;
+
+        int x = bounds.x0 + index % CLUSTER_SIZE;
+        int y = bounds.y0 + index / CLUSTER_SIZE;
+        for (int dir = 0; dir < 8; ++dir) {
+            int nx = x + DIR_X[dir];
+            int ny = y + DIR_Y[dir];
+            if (nx < bounds.x0 || nx > bounds.x1 || ny < bounds.y0 || ny > bounds.y1) continue;
+            if (!IsOpen(nx, ny)) continue;
+            if (dir >= 4 && (!IsOpen(nx, y) || !IsOpen(x, ny))) continue;   // No corner cutting
+
+            int next = local(nx, ny);
+            int cost = distance + (dir < 4 ? STRAIGHT_COST : DIAGONAL_COST);
+            if (m_localStamp[next] == m_localSearch && cost >= m_localDist[next]) continue;
+            m_localStamp[next] = m_localSearch;
+            m_localDist[next] = cost;
+            m_localParent[next] = index;
+            open.push({cost, next});
+        }
+    }
+}
+
+int PathGraph::LocalDistance(int x, int y) const {
+    const Cluster* bounds = m_localCluster;
+    if (!bounds || x < bounds->x0 || x > bounds->x1 || y < bounds->y0 || y > bounds->y1) return -1;
+    int index = (y - bounds->y0) * CLUSTER_SIZE + (x - bounds->x0);
+    return m_localStamp[index] == m_localSearch ? m_localDist[index] : -1;
+}
+
+bool PathGraph::AppendLocalPath(int x, int y, std::vector<PathTile>& out) const {
+    if (LocalDistance(x, y) < 0) return false;
+    const Cluster& bounds = *m_localCluster;
+    size_t first = out.size();
+    for (int index = (y - bounds.y0) * CLUSTER_SIZE + (x - bounds.x0);
+         m_localParent[index] >= 0;
+         index = m_localParent[index]) {
+        out.push_back({bounds.x0 + index % CLUSTER_SIZE, bounds.y0 + index / CLUSTER_SIZE});
+    }
+    std::reverse(out.begin() + static_cast<std::ptrdiff_t>(first), out.end());
+    return true;
+}
+
+bool PathGraph::AppendLocalPath(int cluster, int sx, int sy, int gx, int gy, std::vector<PathTile>& out) {
+    if (sx == gx && sy == gy) return true;
+    SearchCluster(cluster, sx, sy, gx, gy);
+    return AppendLocalPath(gx, gy, out);
+}
+
+bool PathGraph::SearchAbstract(int startX, int startY, int goalX, int goalY, std::vector<int>& nodePath) {
+    int startCluster = ClusterAt(startX, startY);
+    int goalCluster = ClusterAt(goalX, goalY);
+    if (m_nodeStamp.size() < m_nodes.size()) {
+        m_nodeG.resize(m_nodes.size());
+        m_nodeParent.resize(m_nodes.size());
+        m_goalDist.resize(m_nodes.size());
+        m_nodeStamp.resize(m_nodes.size(), 0);
+    }
+    if (++m_abstractSearch == 0) {
+        std::fill(m_nodeStamp.begin(), m_nodeStamp.end(), 0);
+        m_abstractSearch = 1;
+    }
+
+    // Temporary goal links: distance from each goal-cluster entrance to the goal
+    SearchCluster(goalCluster, goalX, goalY);
+    for (int id : m_clusters[goalCluster].nodes) {
+        m_goalDist[id] = LocalDistance(m_nodes[id].x, m_nodes[id].y);
+    }
+
+    using Entry = std::tuple<int, int, int>;   // (f, g, node)
+    std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> open;
+    auto relax = [&](int id, int g, int parent) {
+        if (m_nodeStamp[id] == m_abstractSearch && g >= m_nodeG[id]) return;
+        m_nodeStamp[id] = m_abstractSearch;
+        m_nodeG[id] = g;
+        m_nodeParent[id] = parent;
+        open.push({g + Octile(m_nodes[id].x, m_nodes[id].y, goalX, goalY), g, id});
+    };
+
+    // Temporary start links
+    SearchCluster(startCluster, startX, startY);
+    for (int id : m_clusters[startCluster].nodes) {
+        int distance = LocalDistance(m_nodes[id].x, m_nodes[id].y);
+        if (distance >= 0) relax(id, distance, START_NODE);
+    }
+
+    int bestGoal = INT_MAX;
+    int goalParent = -1;
+    while (!open.empty()) {
+        auto [f, g, id] = open.top();
+        open.pop();
+        if (id == GOAL_NODE) break;
+        if (g != m_nodeG[id]) continue;
+
+        const Node& node = m_nodes[id];
+        if (node.cluster == goalCluster && m_goalDist[id] >= 0 && g + m_goalDist[id] < bestGoal) {
+            bestGoal = g + m_goalDist[id];
+            goalParent = id;
+            open.push({bestGoal, bestGoal, GOAL_NODE});
+        }
+        relax(node.peer, g + STRAIGHT_COST, id);
+        for (const Edge& edge : node.edges) {
+            relax(edge.to, g + edge.cost, id);
+        }
+    }
+    if (goalParent < 0) return false;
+
+    nodePath.clear();
+    for (int id = goalParent; id != START_NODE; id = m_nodeParent[id]) {
+        nodePath.push_back(id);
+    }
+    std::reverse(nodePath.begin(), nodePath.end());
+    return true;
+}
+
+int PathGraph::Octile(int x0, int y0, int x1, int y1) {
+    int dx = std::abs(x1 - x0);
+    int dy = std::abs(y1 - y0);
+    return STRAIGHT_COST * std::max(dx, dy) + (DIAGONAL_COST - STRAIGHT_COST) * std::min(dx, dy);
+}
@@ -0,0 +1,162 @@
+#ifndef PATHGRAPH_H
+#define PATHGRAPH_H
+
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+class Map;
+class SolidityGrid;
+
+struct PathTile {
+    int x;
+    int y;
+};
+
+/**
+ * PathGraph - hierarchical (HPA*) pathfinding over a Map
+ *
+ * The map is split into square clusters. Wherever two neighbouring clusters
+ * share a run of open tiles along their border, an entrance node is placed on
+ * each side; nodes within a cluster are linked by their shortest path inside
+ * it. A long path is found on this small abstract graph, then refined into
+ * tiles one cluster at a time, so no search ever spans more than a cluster of
+ * raw tiles.
+ *
+ * The graph listens to the map's solidity changes and only marks the cluster
+ * dirty; the next FindPath rebuilds that cluster's borders and the nodes of
+ * the clusters beside it. A map reset (new chunk generation) rebuilds it all.
+ *
+ * A detached graph (default constructor) searches an immutable SolidityGrid
+ * snapshot instead of a live map, so it can be owned by a worker thread.
+ * SetGrid swaps in a newer snapshot and marks the clusters whose tiles
+ * differ from the previous one dirty, so repairs stay local there too.
+ *
+ * Refined routes are cached per (start cluster, destination tile): NPCs that
+ * keep walking between the same schedule spots from the same area only run a
+ * search inside their own cluster. Repairs drop the routes that cross a
+ * repaired cluster.
+ *
+ * Movement is 8-way; diagonal steps never cut a solid corner.
+ */
+class PathGraph {
+public:
+    static constexpr int CLUSTER_SIZE = 16;
+
+    explicit PathGraph(Map* map);
+    PathGraph();
+    ~PathGraph();
+
+    PathGraph(const PathGraph&) = delete;
+    PathGraph& operator=(const PathGraph&) = delete;
+
+    // Tiles to walk from start (exclusive) to goal (inclusive). Empty and
+    // true when already there; false if the goal cannot be reached.
+    bool FindPath(int startX, int startY, int goalX, int goalY, std::vector<PathTile>& out);
+
+    // Called by the map when a tile's solidity changes
+    void OnSolidityChanged(int x, int y);
+
+    // Detached graphs only: search this grid from now on
+    void SetGrid(std::shared_ptr<const SolidityGrid> grid);
+
+    // Stats
+    int GetClusterCount() const { return static_cast<int>(m_clusters.size()); }
+    int GetNodeCount() const { return static_cast<int>(m_nodes.size() - m_freeNodes.size()); }
+    int GetCachedRouteCount() const { return static_cast<int>(m_routes.size()); }
+    int GetCacheHits() const { return m_cacheHits; }
+    int GetFullBuilds() const { return m_fullBuilds; }
+    int GetRepairedClusters() const { return m_repairedClusters; }   // Intra-cluster rebuilds since the last full build
+
+private:
+    static constexpr int STRAIGHT_COST = 10;
+    static constexpr int DIAGONAL_COST = 14;
+    static constexpr int MAX_SINGLE_ENTRANCE = 5;   // Longer border runs get an entrance at each end
+    static constexpr int MAX_CACHED_ROUTES = 512;
+    static constexpr int START_NODE = -1;
+    static constexpr int GOAL_NODE = -2;
+
+    struct Edge {
+        int to;
+        int cost;
+    };
+
+    struct Node {
+        int x, y;
+        int cluster;
+        int peer;                   // Entrance node across the border
+        std::vector<Edge> edges;    // Other nodes of the same cluster
+    };
+
+    struct Cluster {
+        int x0, y0, x1, y1;         // Inclusive tile bounds
+        std::vector<int> nodes;
+        std::vector<int> eastNodes;   // This side of the entrances on the east border
+        std::vector<int> southNodes;
+        bool dirty = false;
+    };
+
+    struct CachedRoute {
+        int firstNode;              // Entrance node in the start cluster the route leaves by
+        std::vector<PathTile> tail; // From that node (exclusive) to the destination
+        std::vector<int> clusters;  // Every cluster the route passes through
+    };
+
+    Map* m_map;                                 // Null when detached
+    std::shared_ptr<const SolidityGrid> m_grid;   // Detached graphs' snapshot
+    int m_width, m_height;
+    int m_clustersX, m_clustersY;
+    std::uint32_t m_builtGeneration;
+    bool m_built;
+
+    std::vector<Node> m_nodes;
+    std::vector<int> m_freeNodes;
+    std::vector<Cluster> m_clusters;
+    std::vector<int> m_dirtyClusters;
+    std::unordered_map<std::uint64_t, CachedRoute> m_routes;
+
+    int m_cacheHits = 0;
+    int m_fullBuilds = 0;
+    int m_repairedClusters = 0;
+
+    // Scratch for searches inside one cluster
+    std::vector<int> m_localDist;
+    std::vector<int> m_localParent;
+    std::vector<std::uint32_t> m_localStamp;
+    std::uint32_t m_localSearch = 0;
+    const Cluster* m_localCluster = nullptr;
+
+    // Scratch for the abstract search
+    std::vector<int> m_nodeG;
+    std::vector<int> m_nodeParent;
+    std::vector<int> m_goalDist;
+    std::vector<std::uint32_t> m_nodeStamp;
+    std::uint32_t m_abstractSearch = 0;
+
+    void Build();
+    void Repair();
+    const SolidityGrid& Grid() const;
+    bool IsOpen(int x, int y) const;
+    int ClusterAt(int x, int y) const;
+
+    int AllocNode(int x, int y, int cluster);
+    void FreeNode(int id);
+    void ClearBorder(std::vector<int>& sideNodes);
+    void BuildEastBorder(int cluster);
+    void BuildSouthBorder(int cluster);
+    void LinkEntrance(int clusterA, int ax, int ay, int clusterB, int bx, int by, std::vector<int>& sideNodes);
+    void BuildIntraEdges(int cluster);
+
+    // Dijkstra from (sx, sy) confined to the cluster; stops once (gx, gy) is settled
+    void SearchCluster(int cluster, int sx, int sy, int gx = -1, int gy = -1);
+    int LocalDistance(int x, int y) const;
+    // Appends the last search's path to (x, y), excluding its start
+    bool AppendLocalPath(int x, int y, std::vector<PathTile>& out) const;
+    bool AppendLocalPath(int cluster, int sx, int sy, int gx, int gy, std::vector<PathTile>& out);
+
+    bool SearchAbstract(int startX, int startY, int goalX, int goalY, std::vector<int>& nodePath);
+    static int Octile(int x0, int y0, int x1, int y1);
+};
+
+#endif // PATHGRAPH_H
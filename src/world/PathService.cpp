@@ -0,0 +1,216 @@
+#include "PathService.h"
+#include "Map.h"
+#include "SolidityGrid.h"
+#include <algorithm>
+
+PathService::PathService(const Map* map, const PathServiceConfig& config)
+    : m_map(map)
+    , m_config(config)
+{
+    int workers = std::max(1, m_config.workerCount);
+    for (int i = 0; i < workers; ++i) {
+        m_workers.emplace_back(&PathService::WorkerLoop, this);
+    }
+}
+
+PathService::~PathService() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopping = true;
+    }
+    m_wake.notify_all();
+    for (std::thread& worker : m_workers) {
+        worker.join();
+    }
+}
+
+PathHandle PathService::Request(int startX, int startY, int goalX, int goalY) {
+    RefreshSnapshot();
+    const SolidityGrid& grid = *m_snapshot;
+    if (grid.IsSolid(startX, startY) || grid.IsSolid(goalX, goalY)) {
+        return NewHandle(PathStatus::FAILED);
+    }
+    if (startX == goalX && startY == goalY) {
+        return NewHandle(PathStatus::READY);
+    }
+
+    int startIndex = startY * grid.GetWidth() + startX;
+    int goalIndex = goalY * grid.GetWidth() + goalX;
+    std::uint64_t key = (static_cast<std::uint64_t>(startIndex) << 32) | static_cast<std::uint32_t>(goalIndex);
+
+    CollectFinished();
+    std::vector<PathTile> cached;
+    if (LookupCache(key, startX, startY, goalIndex, cached)) {
+        m_cacheHits++;
+        PathHandle handle = NewHandle(PathStatus::READY);
+        m_handles[handle].path = std::move(cached);
+        return handle;
+    }
+
+    // Same search already queued or running against this snapshot: share it
+    auto running = m_inFlight.find(key);
+    if (running != m_inFlight.end() && running->second->generation == m_snapshotGeneration) {
+        m_shared++;
+        running->second->waiters++;
+        PathHandle handle = NewHandle(PathStatus::PENDING);
+        m_handles[handle].job = running->second;
+        return handle;
+    }
+
+    auto job = std::make_shared<Job>();
+    job->startX = startX;
+    job->startY = startY;
+    job->goalX = goalX;
+    job->goalY = goalY;
+    job->key = key;
+    job->generation = m_snapshotGeneration;
+    job->grid = m_snapshot;
+    job->waiters = 1;
+    m_inFlight[key] = job;
+    m_solves++;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_queue.push_back(job);
+    }
+    m_wake.notify_one();
+
+    PathHandle handle = NewHandle(PathStatus::PENDING);
+    m_handles[handle].job = std::move(job);
+    return handle;
+}
+
+PathStatus PathService::GetStatus(PathHandle handle) {
+    CollectFinished();
+    auto it = m_handles.find(handle);
+    if (it == m_handles.end()) return PathStatus::UNKNOWN;
+
+    HandleState& state = it->second;
+    if (state.status == PathStatus::PENDING && state.job->done) {
+        state.status = state.job->found ? PathStatus::READY : PathStatus::FAILED;
+        state.path = state.job->path;
+        state.job.reset();
+    }
+    return state.status;
+}
+
+bool PathService::TakePath(PathHandle handle, std::vector<PathTile>& out) {
+    PathStatus status = GetStatus(handle);
+    if (status == PathStatus::PENDING || status == PathStatus::UNKNOWN) return false;
+
+    auto it = m_handles.find(handle);
+    bool ready = status == PathStatus::READY;
+    if (ready) out = std::move(it->second.path);
+    m_handles.erase(it);
+    return ready;
+}
+
+void PathService::Release(PathHandle handle) {
+    auto it = m_handles.find(handle);
+    if (it == m_handles.end()) return;
+
+    std::shared_ptr<Job> job = std::move(it->second.job);
+    m_handles.erase(it);
+    if (!job || job->done || --job->waiters > 0) return;
+
+    // Nobody wants this search any more; a worker that has not started it skips it
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        job->cancelled = true;
+    }
+    auto running = m_inFlight.find(job->key);
+    if (running != m_inFlight.end() && running->second == job) m_inFlight.erase(running);
+}
+
+void PathService::RefreshSnapshot() {
+    std::uint32_t generation = m_map->GetSolidityGeneration();
+    if (m_snapshot && generation == m_snapshotGeneration) return;
+
+    m_snapshot = std::make_shared<const SolidityGrid>(m_map->GetSolidityGrid());
+    m_snapshotGeneration = generation;
+    // Every cached path was solved against an older grid
+    m_cache.clear();
+    m_cacheIndex.clear();
+}
+
+void PathService::CollectFinished() {
+    std::vector<std::shared_ptr<Job>> finished;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        finished.swap(m_finished);
+    }
+    for (const std::shared_ptr<Job>& job : finished) {
+        job->done = true;
+        auto running = m_inFlight.find(job->key);
+        if (running != m_inFlight.end() && running->second == job) m_inFlight.erase(running);
+        if (job->found && job->generation == m_snapshotGeneration) {
+            StoreInCache(job->key, static_cast<int>(job->key & 0xFFFFFFFFu), job->path);
+        }
+    }
+}
+
+bool PathService::LookupCache(std::uint64_t key, int startX, int startY, int goalIndex, std::vector<PathTile>& out) {
+    auto exact = m_cacheIndex.find(key);
+    if (exact != m_cacheIndex.end()) {
+        m_cache.splice(m_cache.begin(), m_cache, exact->second);
+        out = exact->second->path;
+        return true;
+    }
+
+    // A cached path to the same goal that runs through the start tile: its tail is the answer
+    for (auto entry = m_cache.begin(); entry != m_cache.end(); ++entry) {
+        if (entry->goalIndex != goalIndex) continue;
+        auto onPath = std::find_if(entry->path.begin(), entry->path.end(), [startX, startY](const PathTile& tile) {
+            return tile.x == startX && tile.y == startY;
+        });
+        if (onPath == entry->path.end()) continue;
+        out.assign(onPath + 1, entry->path.end());
+        m_cache.splice(m_cache.begin(), m_cache, entry);
+        return true;
+    }
+    return false;
+}
+
+void PathService::StoreInCache(std::uint64_t key, int goalIndex, const std::vector<PathTile>& path) {
+    if (m_config.cacheCapacity <= 0) return;
+
+    auto existing = m_cacheIndex.find(key);
+    if (existing != m_cacheIndex.end()) {
+        existing->second->path = path;
+        m_cache.splice(m_cache.begin(), m_cache, existing->second);
+        return;
+    }
+    m_cache.push_front(CacheEntry{key, goalIndex, path});
+    m_cacheIndex[key] = m_cache.begin();
+    if (static_cast<int>(m_cache.size()) > m_config.cacheCapacity) {
+        m_cacheIndex.erase(m_cache.back().key);
+        m_cache.pop_back();
+    }
+}
+
+PathHandle PathService::NewHandle(PathStatus status) {
+    PathHandle handle = m_nextHandle++;
+    if (m_nextHandle == 0) m_nextHandle = 1;
+    m_handles[handle] = HandleState{status, {}, nullptr};
+    return handle;
+}
+
+void PathService::WorkerLoop() {
+    PathGraph graph;   // This worker's own; only ever sees snapshots
+    for (;;) {
+        std::shared_ptr<Job> job;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_wake.wait(lock, [this] { return m_stopping || !m_queue.empty(); });
+            if (m_stopping) return;
+            job = std::move(m_queue.front());
+            m_queue.pop_front();
+            if (job->cancelled) continue;
+        }
+
+        graph.SetGrid(job->grid);
+        job->found = graph.FindPath(job->startX, job->startY, job->goalX, job->goalY, job->path);
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_finished.push_back(std::move(job));
+    }
+}
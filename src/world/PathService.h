@@ -0,0 +1,125 @@
+#ifndef PATHSERVICE_H
+#define PATHSERVICE_H
+
+#include "PathGraph.h"
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+class Map;
+class SolidityGrid;
+
+using PathHandle = std::uint32_t;   // 0 is never handed out
+
+enum class PathStatus { PENDING, READY, FAILED, UNKNOWN };
+
+struct PathServiceConfig {
+    int workerCount = 2;
+    int cacheCapacity = 256;            // Solved paths kept for reuse (least recently used go first)
+};
+
+/**
+ * PathService - asynchronous tile paths shared by many entities
+ *
+ * Request() hands back a handle straight away; the search runs on a worker
+ * thread and GetStatus() / TakePath() pick up the answer on a later frame,
+ * so the game loop never waits for a solve. Workers search an immutable
+ * snapshot of the map's SolidityGrid, which is only re-copied when the map's
+ * solidity generation has moved on. Each worker owns a detached PathGraph
+ * (HPA*, 8-way, no corner cutting) over the snapshot; a newer snapshot only
+ * repairs the clusters that changed.
+ *
+ * Solved paths go into an LRU cache tagged with that generation; any
+ * solidity change makes every entry stale. A request that matches a cached
+ * path, or starts on a tile of a cached path to the same goal, is answered
+ * from the cache. A request identical to one still in flight shares its job.
+ *
+ * Everything except the workers runs on the game thread.
+ */
+class PathService {
+public:
+    explicit PathService(const Map* map, const PathServiceConfig& config = PathServiceConfig());
+    ~PathService();
+
+    PathService(const PathService&) = delete;
+    PathService& operator=(const PathService&) = delete;
+
+    PathHandle Request(int startX, int startY, int goalX, int goalY);
+    PathStatus GetStatus(PathHandle handle);
+    // Hands over the path (start exclusive, goal inclusive) and frees the handle.
+    // False while pending, or if no path exists (the handle is freed either way then).
+    bool TakePath(PathHandle handle, std::vector<PathTile>& out);
+    void Release(PathHandle handle);
+
+    // Counters
+    int GetSolveCount() const { return m_solves; }
+    int GetCacheHits() const { return m_cacheHits; }
+    int GetSharedRequests() const { return m_shared; }
+    int GetCachedPathCount() const { return static_cast<int>(m_cache.size()); }
+    int GetOpenHandleCount() const { return static_cast<int>(m_handles.size()); }
+
+private:
+    struct Job {
+        int startX, startY, goalX, goalY;
+        std::uint64_t key;
+        std::uint32_t generation;
+        std::shared_ptr<const SolidityGrid> grid;
+        int waiters = 0;                // Handles still interested (game thread only)
+        bool cancelled = false;         // Guarded by m_mutex
+        bool found = false;             // Written by the worker before it posts the job
+        bool done = false;              // Set on the game thread once the job is collected
+        std::vector<PathTile> path;
+    };
+
+    struct HandleState {
+        PathStatus status;
+        std::vector<PathTile> path;
+        std::shared_ptr<Job> job;       // Set while pending
+    };
+
+    struct CacheEntry {
+        std::uint64_t key;
+        int goalIndex;
+        std::vector<PathTile> path;
+    };
+
+    const Map* m_map;
+    PathServiceConfig m_config;
+
+    // Snapshot the workers search; replaced when the map's solidity changes
+    std::shared_ptr<const SolidityGrid> m_snapshot;
+    std::uint32_t m_snapshotGeneration = 0;
+
+    // Game thread state
+    std::unordered_map<PathHandle, HandleState> m_handles;
+    PathHandle m_nextHandle = 1;
+    std::unordered_map<std::uint64_t, std::shared_ptr<Job>> m_inFlight;
+    std::list<CacheEntry> m_cache;      // Most recently used first
+    std::unordered_map<std::uint64_t, std::list<CacheEntry>::iterator> m_cacheIndex;
+    int m_solves = 0;
+    int m_cacheHits = 0;
+    int m_shared = 0;
+
+    // Shared with the workers
+    mutable std::mutex m_mutex;
+    std::condition_variable m_wake;
+    std::deque<std::shared_ptr<Job>> m_queue;
+    std::vector<std::shared_ptr<Job>> m_finished;
+    bool m_stopping = false;
+    std::vector<std::thread> m_workers;
+
+    void RefreshSnapshot();
+    void CollectFinished();
+    bool LookupCache(std::uint64_t key, int startX, int startY, int goalIndex, std::vector<PathTile>& out);
+    void StoreInCache(std::uint64_t key, int goalIndex, const std::vector<PathTile>& path);
+    PathHandle NewHandle(PathStatus status);
+    void WorkerLoop();
+};
+
+#endif // PATHSERVICE_H
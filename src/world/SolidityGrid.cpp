@@ -0,0 +1,230 @@
+#include "SolidityGrid.h"
+#include <algorithm>
+#include <bit>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define SOLIDITY_USE_SSE2 1
+#endif
+
+namespace {
+
+constexpr int WORD_BITS = 64;
+constexpr int WORD_SHIFT = 6;
+
+// Bits bit..63 of a word
+inline std::uint64_t MaskFrom(int bit) { return ~0ull << bit; }
+// Bits 0..bit of a word
+inline std::uint64_t MaskThrough(int bit) { return ~0ull >> (WORD_BITS - 1 - bit); }
+
+} // namespace
+
+SolidityGrid::SolidityGrid()
+    : m_width(0)
+    , m_height(0)
+    , m_stride(0)
+{
+}
+
+void SolidityGrid::Reset(int width, int height, bool solid) {
+    m_width = std::max(width, 0);
+    m_height = std::max(height, 0);
+    int words = (m_width + WORD_BITS - 1) >> WORD_SHIFT;
+    m_stride = (words + 1) & ~1;
+    m_words.assign(static_cast<std::size_t>(m_stride) * m_height, 0);
+    if (!solid || m_width == 0) return;
+
+    // Fill whole rows, leaving the padding bits past the last column clear
+    for (int y = 0; y < m_height; ++y) {
+        std::uint64_t* row = m_words.data() + static_cast<std::size_t>(y) * m_stride;
+        std::fill(row, row + words, ~0ull);
+        row[words - 1] = MaskThrough((m_width - 1) & (WORD_BITS - 1));
+    }
+}
+
+void SolidityGrid::Set(int x, int y, bool solid) {
+    if (x < 0 || y < 0 || x >= m_width || y >= m_height) return;
+    std::uint64_t& word = m_words[static_cast<std::size_t>(y) * m_stride + (x >> WORD_SHIFT)];
+    std::uint64_t bit = 1ull << (x & (WORD_BITS - 1));
+    word = solid ? (word | bit) : (word & ~bit);
+}
+
+void SolidityGrid::ForEachDifference(const SolidityGrid& other, const std::function<void(int x, int y)>& visit) const {
+    if (other.m_width != m_width || other.m_height != m_height) return;
+    for (int y = 0; y < m_height; ++y) {
+        const std::uint64_t* a = Row(y);
+        const std::uint64_t* b = other.Row(y);
+        for (int w = 0; w < m_stride; ++w) {
+            for (std::uint64_t diff = a[w] ^ b[w]; diff != 0; diff &= diff - 1) {
+                int x = (w << WORD_SHIFT) + std::countr_zero(diff);
+                if (x < m_width) visit(x, y);
+            }
+        }
+    }
+}
+
+bool SolidityGrid::IsSolid(int x, int y) const {
+    if (x < 0 || y < 0 || x >= m_width || y >= m_height) return true;
+    return (Row(y)[x >> WORD_SHIFT] >> (x & (WORD_BITS - 1))) & 1;
+}
+
+bool SolidityGrid::AnySolidInRect(int x0, int y0, int x1, int y1) const {
+    if (x0 > x1 || y0 > y1) return false;
+    if (x0 < 0 || y0 < 0 || x1 >= m_width || y1 >= m_height) return true;
+
+    int w0 = x0 >> WORD_SHIFT;
+    int w1 = x1 >> WORD_SHIFT;
+    std::uint64_t first = MaskFrom(x0 & (WORD_BITS - 1));
+    std::uint64_t last = MaskThrough(x1 & (WORD_BITS - 1));
+
+    for (int y = y0; y <= y1; ++y) {
+        const std::uint64_t* row = Row(y);
+        if (w0 == w1) {
+            if (row[w0] & first & last) return true;
+            continue;
+        }
+        if ((row[w0] & first) || (row[w1] & last)) return true;
+        if (AnyBits(row + w0 + 1, w1 - w0 - 1)) return true;
+    }
+    return false;
+}
+
+bool SolidityGrid::FirstSolidInRow(int y, int x0, int x1, int& outX) const {
+    if (x0 > x1) return false;
+    if (x0 < 0 || y < 0 || y >= m_height || x0 >= m_width) {
+        outX = x0;
+        return true;
+    }
+    int end = std::min(x1, m_width - 1);
+
+    const std::uint64_t* row = Row(y);
+    int w0 = x0 >> WORD_SHIFT;
+    int w1 = end >> WORD_SHIFT;
+    std::uint64_t bits = row[w0] & MaskFrom(x0 & (WORD_BITS - 1));
+    if (w0 == w1) bits &= MaskThrough(end & (WORD_BITS - 1));
+    if (!bits && w1 > w0) {
+        int middle = FirstNonZero(row + w0 + 1, w1 - w0 - 1);
+        if (middle >= 0) {
+            w0 += 1 + middle;
+            bits = row[w0];
+        } else {
+            w0 = w1;
+            bits = row[w1] & MaskThrough(end & (WORD_BITS - 1));
+        }
+    }
+    if (bits) {
+        outX = (w0 << WORD_SHIFT) + std::countr_zero(bits);
+        return true;
+    }
+
+    // The span ran off the right edge, which counts as solid
+    if (x1 >= m_width) {
+        outX = m_width;
+        return true;
+    }
+    return false;
+}
+
+bool SolidityGrid::LastSolidInRow(int y, int x0, int x1, int& outX) const {
+    if (x0 > x1) return false;
+    if (x1 >= m_width || y < 0 || y >= m_height || x1 < 0) {
+        outX = x1;
+        return true;
+    }
+    int start = std::max(x0, 0);
+
+    const std::uint64_t* row = Row(y);
+    int w0 = start >> WORD_SHIFT;
+    int w1 = x1 >> WORD_SHIFT;
+    std::uint64_t bits = row[w1] & MaskThrough(x1 & (WORD_BITS - 1));
+    if (w0 == w1) bits &= MaskFrom(start & (WORD_BITS - 1));
+    if (!bits && w1 > w0) {
+        int middle = LastNonZero(row + w0 + 1, w1 - w0 - 1);
+        if (middle >= 0) {
+            w1 = w0 + 1 + middle;
+            bits = row[w1];
+        } else {
+            w1 = w0;
+            bits = row[w0] & MaskFrom(start & (WORD_BITS - 1));
+        }
+    }
+    if (bits) {
+        outX = (w1 << WORD_SHIFT) + (WORD_BITS - 1 - std::countl_zero(bits));
+        return true;
+    }
+
+    // The span ran off the left edge, which counts as solid
+    if (x0 < 0) {
+        outX = -1;
+        return true;
+    }
+    return false;
+}
+
+int SolidityGrid::GetSolidCount() const {
+    int count = 0;
+    for (std::uint64_t word : m_words) {
+        count += std::popcount(word);
+    }
+    return count;
+}
+
+bool SolidityGrid::AnyBits(const std::uint64_t* words, int count) {
+    int i = 0;
+#ifdef SOLIDITY_USE_SSE2
+    // OR 128-bit lanes together, checking every four lanes for an early out
+    const __m128i zero = _mm_setzero_si128();
+    while (i + 8 <= count) {
+        __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(words + i));
+        __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(words + i + 2));
+        __m128i c = _mm_loadu_si128(reinterpret_cast<const __m128i*>(words + i + 4));
+        __m128i d = _mm_loadu_si128(reinterpret_cast<const __m128i*>(words + i + 6));
+        __m128i any = _mm_or_si128(_mm_or_si128(a, b), _mm_or_si128(c, d));
+        if (_mm_movemask_epi8(_mm_cmpeq_epi8(any, zero)) != 0xFFFF) return true;
+        i += 8;
+    }
+    while (i + 2 <= count) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(words + i));
+        if (_mm_movemask_epi8(_mm_cmpeq_epi8(v, zero)) != 0xFFFF) return true;
+        i += 2;
+    }
+#endif
+    for (; i < count; ++i) {
+        if (words[i]) return true;
+    }
+    return false;
+}
+
+int SolidityGrid::FirstNonZero(const std::uint64_t* words, int count) {
+    int i = 0;
+#ifdef SOLIDITY_USE_SSE2
+    // Skip clear 128-bit lanes; the scalar loop below pins down the word
+    const __m128i zero = _mm_setzero_si128();
+    while (i + 2 <= count) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(words + i));
+        if (_mm_movemask_epi8(_mm_cmpeq_epi8(v, zero)) != 0xFFFF) break;
+        i += 2;
+    }
+#endif
+    for (; i < count; ++i) {
+        if (words[i]) return i;
+    }
+    return -1;
+}
+
+int SolidityGrid::LastNonZero(const std::uint64_t* words, int count) {
+    int i = count;
+#ifdef SOLIDITY_USE_SSE2
+    // Same as FirstNonZero, walking down from the end
+    const __m128i zero = _mm_setzero_si128();
+    while (i >= 2) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(words + i - 2));
+        if (_mm_movemask_epi8(_mm_cmpeq_epi8(v, zero)) != 0xFFFF) break;
+        i -= 2;
+    }
+#endif
+    while (i-- > 0) {
+        if (words[i]) return i;
+    }
+    return -1;
+}
@@ -0,0 +1,53 @@
+#ifndef SOLIDITYGRID_H
+#define SOLIDITYGRID_H
+
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+/**
+ * SolidityGrid - one bit per tile, set where the tile blocks movement
+ *
+ * Rows are packed into 64-bit words and padded to an even number of words,
+ * so a row can be scanned 128 bits at a time with SSE2 (plain word loops
+ * elsewhere). Map keeps it in step with every tile type change, so
+ * collision queries never touch tiles, chunks or the TileRegistry.
+ *
+ * Everything outside the grid counts as solid, matching Map::IsSolid.
+ */
+class SolidityGrid {
+public:
+    SolidityGrid();
+
+    // Resize and set every bit to the given value
+    void Reset(int width, int height, bool solid);
+
+    void Set(int x, int y, bool solid);
+    bool IsSolid(int x, int y) const;
+
+    // True if any tile in the inclusive rectangle is solid (or off the grid)
+    bool AnySolidInRect(int x0, int y0, int x1, int y1) const;
+    // First / last solid x in [x0, x1] on row y; false if the span is clear
+    bool FirstSolidInRow(int y, int x0, int x1, int& outX) const;
+    bool LastSolidInRow(int y, int x0, int x1, int& outX) const;
+
+    // Calls visit(x, y) for every tile whose bit differs in other, which must
+    // be the same size; whole unchanged words are skipped
+    void ForEachDifference(const SolidityGrid& other, const std::function<void(int x, int y)>& visit) const;
+
+    int GetWidth() const { return m_width; }
+    int GetHeight() const { return m_height; }
+    int GetSolidCount() const;
+
+private:
+    int m_width, m_height;
+    int m_stride;                       // Words per row (even)
+    std::vector<std::uint64_t> m_words;
+
+    const std::uint64_t* Row(int y) const { return m_words.data() + static_cast<std::size_t>(y) * m_stride; }
+    static bool AnyBits(const std::uint64_t* words, int count);
+    static int FirstNonZero(const std::uint64_t* words, int count);
+    static int LastNonZero(const std::uint64_t* words, int count);
+};
+
+#endif // SOLIDITYGRID_H
@@ -0,0 +1,170 @@
+#ifndef SPATIALHASH_H
+#define SPATIALHASH_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * SpatialHash - uniform grid of world-space cells for proximity queries
+ *
+ * Items are registered with their bounding box and filed under every cell
+ * the box touches (one tile per cell by default). Queries only visit the
+ * cells under the query area, so their cost depends on how crowded that
+ * area is, not on how many items the map holds.
+ *
+ * Update() is called whenever an item moves; it only touches the cell
+ * lists when the item crosses into different cells. Items are not owned.
+ */
+template <typename T>
+class SpatialHash {
+public:
+    explicit SpatialHash(float cellSize = 32.0f)
+        : m_cellSize(cellSize)
+        , m_invCellSize(1.0f / cellSize)
+    {
+    }
+
+    void Clear() {
+        m_cells.clear();
+        m_entries.clear();
+    }
+
+    // Insert, or move an item already in the grid
+    void Update(T* item, float x, float y, float width, float height) {
+        CellRange cells = CellsFor(x, y, width, height);
+        auto it = m_entries.find(item);
+        if (it == m_entries.end()) {
+            Entry& entry = m_entries.emplace(item, Entry{cells, x, y, width, height}).first->second;
+            AddToCells(item, &entry, cells);
+            return;
+        }
+        Entry& entry = it->second;
+        if (!(entry.cells == cells)) {
+            RemoveFromCells(item, entry.cells);
+            AddToCells(item, &entry, cells);
+            entry.cells = cells;
+        }
+        entry.x = x;
+        entry.y = y;
+        entry.width = width;
+        entry.height = height;
+    }
+
+    void Remove(T* item) {
+        auto it = m_entries.find(item);
+        if (it == m_entries.end()) return;
+        RemoveFromCells(item, it->second.cells);
+        m_entries.erase(it);
+    }
+
+    bool Contains(const T* item) const { return m_entries.count(item) != 0; }
+    int GetCount() const { return static_cast<int>(m_entries.size()); }
+    float GetCellSize() const { return m_cellSize; }
+
+    // Items whose box overlaps the query box (same test as Combat::CheckCollision).
+    // Each item is appended once.
+    void QueryAABB(float x, float y, float width, float height, std::vector<T*>& out) const {
+        CellRange query = CellsFor(x, y, width, height);
+        Visit(query, out, [&](const Entry& entry) {
+            return x < entry.x + entry.width && x + width > entry.x &&
+                   y < entry.y + entry.height && y + height > entry.y;
+        });
+    }
+
+    // Items whose box comes within radius of (centerX, centerY)
+    void QueryRadius(float centerX, float centerY, float radius, std::vector<T*>& out) const {
+        CellRange query = CellsFor(centerX - radius, centerY - radius, radius * 2.0f, radius * 2.0f);
+        float radiusSq = radius * radius;
+        Visit(query, out, [&](const Entry& entry) {
+            float nearestX = std::clamp(centerX, entry.x, entry.x + entry.width);
+            float nearestY = std::clamp(centerY, entry.y, entry.y + entry.height);
+            float dx = centerX - nearestX;
+            float dy = centerY - nearestY;
+            return dx * dx + dy * dy <= radiusSq;
+        });
+    }
+
+private:
+    struct CellRange {
+        int x0, y0, x1, y1;   // Inclusive
+        bool operator==(const CellRange& other) const {
+            return x0 == other.x0 && y0 == other.y0 && x1 == other.x1 && y1 == other.y1;
+        }
+    };
+
+    struct Entry {
+        CellRange cells;
+        float x, y, width, height;
+    };
+
+    // Entries live in unordered_map nodes, which never move, so cells can point at them
+    struct CellItem {
+        T* item;
+        const Entry* entry;
+    };
+
+    static std::uint64_t Key(int cellX, int cellY) {
+        return (static_cast<std::uint64_t>(static_cast<std::uint32_t>(cellY)) << 32) |
+               static_cast<std::uint32_t>(cellX);
+    }
+
+    CellRange CellsFor(float x, float y, float width, float height) const {
+        return CellRange{
+            static_cast<int>(std::floor(x * m_invCellSize)),
+            static_cast<int>(std::floor(y * m_invCellSize)),
+            static_cast<int>(std::floor((x + std::max(width, 0.0f)) * m_invCellSize)),
+            static_cast<int>(std::floor((y + std::max(height, 0.0f)) * m_invCellSize))
+        };
+    }
+
+    void AddToCells(T* item, const Entry* entry, const CellRange& cells) {
+        for (int cy = cells.y0; cy <= cells.y1; ++cy) {
+            for (int cx = cells.x0; cx <= cells.x1; ++cx) {
+                m_cells[Key(cx, cy)].push_back(CellItem{item, entry});
+            }
+        }
+    }
+
+    void RemoveFromCells(T* item, const CellRange& cells) {
+        for (int cy = cells.y0; cy <= cells.y1; ++cy) {
+            for (int cx = cells.x0; cx <= cells.x1; ++cx) {
+                auto it = m_cells.find(Key(cx, cy));
+                if (it == m_cells.end()) continue;
+                auto& items = it->second;
+                auto pos = std::find_if(items.begin(), items.end(),
+                                        [item](const CellItem& cellItem) { return cellItem.item == item; });
+                if (pos != items.end()) {
+                    *pos = items.back();
+                    items.pop_back();
+                }
+                if (items.empty()) m_cells.erase(it);
+            }
+        }
+    }
+
+    template <typename Filter>
+    void Visit(const CellRange& query, std::vector<T*>& out, Filter&& filter) const {
+        for (int cy = query.y0; cy <= query.y1; ++cy) {
+            for (int cx = query.x0; cx <= query.x1; ++cx) {
+                auto cell = m_cells.find(Key(cx, cy));
+                if (cell == m_cells.end()) continue;
+                for (const CellItem& cellItem : cell->second) {
+                    const Entry& entry = *cellItem.entry;
+                    // An item spanning several cells is reported from the first shared one only
+                    if (cx != std::max(entry.cells.x0, query.x0) || cy != std::max(entry.cells.y0, query.y0)) continue;
+                    if (filter(entry)) out.push_back(cellItem.item);
+                }
+            }
+        }
+    }
+
+    float m_cellSize;
+    float m_invCellSize;
+    std::unordered_map<std::uint64_t, std::vector<CellItem>> m_cells;
+    std::unordered_map<const T*, Entry> m_entries;
+};
+
+#endif // SPATIALHASH_H
@@ -1,7 +1,7 @@
 #include "Tile.h"
 
 // Initialize static members
-TileDef TileRegistry::s_definitions[32];
+TileDef TileRegistry::s_definitions[TILE_TYPE_COUNT];
 bool TileRegistry::s_initialized = false;
 
 void TileRegistry::Initialize() {
@@ -34,20 +34,12 @@ const TileDef& TileRegistry::GetDefinition(TileType type) {
 Tile::Tile()
     : m_type(TileType::GRASS)
     , m_visualId(0)
-    , m_soilState(SoilState::GRASS)
-    , m_cropType(-1)
-    , m_growthStage(0)
-    , m_growthTimer(0.0f)
 {
 }
 
 Tile::Tile(TileType type, int visualId)
     : m_type(type)
-    , m_visualId(visualId)
-    , m_soilState(SoilState::GRASS)
-    , m_cropType(-1)
-    , m_growthStage(0)
-    , m_growthTimer(0.0f)
+    , m_visualId(static_cast<std::uint8_t>(visualId))
 {
 }
 
@@ -63,17 +55,23 @@ bool Tile::IsFarmable() const {
     return TileRegistry::GetDefinition(m_type).farmable;
 }
 
-void Tile::Update(float deltaTime) {
-    // Crop growth over time
-    if (m_soilState == SoilState::CROP && m_cropType >= 0 &&
-        m_growthStage < MAX_GROWTH_STAGE) {
-        m_growthTimer += deltaTime;
-        if (m_growthTimer >= GROWTH_INTERVAL) {
-            m_growthTimer -= GROWTH_INTERVAL;
-            m_growthStage++;
-            if (m_growthStage >= MAX_GROWTH_STAGE) {
-                m_soilState = SoilState::HARVEST;
-            }
-        }
+// FarmPlot implementation
+FarmPlot::FarmPlot()
+    : m_soilState(SoilState::GRASS)
+    , m_cropType(-1)
+    , m_growthStage(0)
+{
+}
+
+bool FarmPlot::AdvanceGrowth() {
+    if (m_soilState != SoilState::CROP || m_cropType < 0 ||
+        m_growthStage >= MAX_GROWTH_STAGE) {
+        return false;
+    }
+    m_growthStage++;
+    if (m_growthStage >= MAX_GROWTH_STAGE) {
+        m_soilState = SoilState::HARVEST;
+        return false;
     }
+    return true;
 }
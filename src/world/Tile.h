@@ -1,10 +1,11 @@
 #ifndef TILE_H
 #define TILE_H
 
+#include <cstdint>
 #include <string>
 
 // Semantic tile types - what the tile MEANS, not how it looks
-enum class TileType {
+enum class TileType : std::uint8_t {
     VOID,           // Empty/ungenerated space
     FLOOR,          // Walkable floor
     WALL,           // Solid wall
@@ -17,9 +18,12 @@ enum class TileType {
     STONE,          // Stone floor
     SAND,           // Sand terrain
     DECORATION,     // Non-interactive decoration
-    TREE            // Tree (solid, choppable)
+    TREE,           // Tree (solid, choppable)
+    COUNT           // Number of tile types - not a real type, keep last
 };
 
+constexpr int TILE_TYPE_COUNT = static_cast<int>(TileType::COUNT);
+
 // Tile definition - the RULES for a tile type
 struct TileDef {
     TileType type;
@@ -45,6 +49,7 @@ enum class SoilState {
 };
 
 // Individual tile instance in the world
+// Kept to two bytes so large maps stay cache-friendly; farm state lives in FarmPlot
 class Tile {
 public:
     Tile();
@@ -56,14 +61,25 @@ public:
     
     // Visual representation (what it LOOKS like)
     int GetVisualId() const { return m_visualId; }
-    void SetVisualId(int id) { m_visualId = id; }
+    void SetVisualId(int id) { m_visualId = static_cast<std::uint8_t>(id); }
     
     // Properties from definition
     bool IsSolid() const;
     bool IsBreakable() const;
     bool IsFarmable() const;
-    
-    // Farming system
+
+private:
+    // .hqmap chunk data stores tiles as these two bytes, in this order
+    TileType m_type;            // Semantic type
+    std::uint8_t m_visualId;    // Which sprite to render
+};
+
+// Farming state for a single tile. Only tiles that have been tilled carry
+// one; Map keeps them in a sparse side table keyed by tile index.
+class FarmPlot {
+public:
+    FarmPlot();
+
     SoilState GetSoilState() const { return m_soilState; }
     void SetSoilState(SoilState state) { m_soilState = state; }
     
@@ -73,22 +89,17 @@ public:
     int GetGrowthStage() const { return m_growthStage; }
     void SetGrowthStage(int stage) { m_growthStage = stage; }
     
-    // Update (for animated tiles, crop growth, etc.)
-    void Update(float deltaTime);
+    // Advance a growing crop by one stage; returns true while it is still growing
+    bool AdvanceGrowth();
 
     // Crop growth constants
     static constexpr int MAX_GROWTH_STAGE = 4;
     static constexpr float GROWTH_INTERVAL = 5.0f; // Seconds between growth stages
 
 private:
-    TileType m_type;        // Semantic type
-    int m_visualId;         // Which sprite to render
-    
-    // Farming state (only used if farmable)
     SoilState m_soilState;
     int m_cropType;         // -1 = no crop
     int m_growthStage;      // 0-N growth stages
-    float m_growthTimer;    // Time accumulator for crop growth
 };
 
 // Global tile definition registry
@@ -98,7 +109,7 @@ public:
     static const TileDef& GetDefinition(TileType type);
     
 private:
-    static TileDef s_definitions[32];
+    static TileDef s_definitions[TILE_TYPE_COUNT];
     static bool s_initialized;
 };
 
@@ -0,0 +1,95 @@
+#include "TimerWheel.h"
+#include <cmath>
+
+TimerWheel::TimerWheel()
+    : m_currentTick(0)
+    , m_tickAccumulator(0.0f)
+    , m_pendingCount(0)
+{
+}
+
+void TimerWheel::Schedule(float delaySeconds, const TileEvent& event) {
+    float ticks = std::ceil(delaySeconds * TICKS_PER_SECOND);
+    ScheduleTicks(ticks > 0.0f ? static_cast<std::uint64_t>(ticks) : 0, event);
+}
+
+void TimerWheel::ScheduleTicks(std::uint64_t delayTicks, const TileEvent& event) {
+    // Events always fire on a future tick, never the current one
+    if (delayTicks < 1) delayTicks = 1;
+    Insert({m_currentTick + delayTicks, event});
+    m_pendingCount++;
+}
+
+void TimerWheel::Advance(float deltaTime, std::vector<TileEvent>& due) {
+    m_tickAccumulator += deltaTime * TICKS_PER_SECOND;
+    if (m_tickAccumulator < 1.0f) return;
+
+    auto ticks = static_cast<std::uint64_t>(m_tickAccumulator);
+    m_tickAccumulator -= static_cast<float>(ticks);
+    AdvanceTicks(ticks, due);
+}
+
+void TimerWheel::AdvanceTicks(std::uint64_t ticks, std::vector<TileEvent>& due) {
+    for (std::uint64_t i = 0; i < ticks; ++i) {
+        m_currentTick++;
+
+        // When a level wraps, pull the next coarser slot down a level
+        int level = 0;
+        while (level < LEVELS - 1 &&
+               ((m_currentTick >> (SLOT_BITS * level)) & SLOT_MASK) == 0) {
+            level++;
+            Cascade(level);
+        }
+
+        auto& slot = m_slots[0][m_currentTick & SLOT_MASK];
+        if (slot.empty()) continue;
+
+        std::vector<Entry> fired;
+        fired.swap(slot);
+        for (const auto& entry : fired) {
+            if (entry.expireTick <= m_currentTick) {
+                due.push_back(entry.event);
+                m_pendingCount--;
+            } else {
+                // Delay was longer than the wheel span; keep waiting
+                Insert(entry);
+            }
+        }
+    }
+}
+
+void TimerWheel::Clear() {
+    for (auto& level : m_slots) {
+        for (auto& slot : level) {
+            slot.clear();
+        }
+    }
+    m_pendingCount = 0;
+    m_tickAccumulator = 0.0f;
+}
+
+void TimerWheel::Insert(const Entry& entry) {
+    std::uint64_t delta = entry.expireTick - m_currentTick;
+    std::uint64_t expire = entry.expireTick;
+    if (delta > MAX_DELAY_TICKS) {
+        // Park at the far edge of the wheel; Insert runs again when it gets there
+        expire = m_currentTick + MAX_DELAY_TICKS;
+        delta = MAX_DELAY_TICKS;
+    }
+
+    int level = 0;
+    while (level < LEVELS - 1 && delta >= (std::uint64_t(1) << (SLOT_BITS * (level + 1)))) {
+        level++;
+    }
+    std::uint64_t index = (expire >> (SLOT_BITS * level)) & SLOT_MASK;
+    m_slots[level][index].push_back(entry);
+}
+
+void TimerWheel::Cascade(int level) {
+    std::uint64_t index = (m_currentTick >> (SLOT_BITS * level)) & SLOT_MASK;
+    std::vector<Entry> moving;
+    moving.swap(m_slots[level][index]);
+    for (const auto& entry : moving) {
+        Insert(entry);
+    }
+}
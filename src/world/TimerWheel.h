@@ -0,0 +1,68 @@
+#ifndef TIMERWHEEL_H
+#define TIMERWHEEL_H
+
+#include <cstdint>
+#include <vector>
+
+// Delayed tile changes that Map schedules on its timer wheel
+enum class TileEventType : std::uint8_t {
+    CROP_GROWTH,    // Advance a crop by one growth stage
+    TREE_REGROWTH,  // Turn a chopped stump back into a tree
+    SOIL_DRYING     // Watered soil dries back to tilled soil
+};
+
+struct TileEvent {
+    int tileIndex;          // Map tile index (y * width + x)
+    TileEventType type;
+    std::uint32_t serial;   // Lets the owner discard superseded events
+};
+
+/**
+ * TimerWheel - hierarchical timing wheel for scheduled tile events
+ *
+ * Time advances in fixed ticks. Four levels of 64 slots cover 64^4 ticks;
+ * an event sits in the coarsest level that can hold its delay and cascades
+ * down as its expiry approaches. Advancing with nothing due only looks at
+ * one empty slot per tick, so thousands of pending timers cost nothing
+ * until they fire.
+ */
+class TimerWheel {
+public:
+    TimerWheel();
+
+    // Schedule an event to fire after the given delay (rounded up to whole ticks)
+    void Schedule(float delaySeconds, const TileEvent& event);
+    void ScheduleTicks(std::uint64_t delayTicks, const TileEvent& event);
+
+    // Advance simulated time; events that came due are appended to 'due'
+    void Advance(float deltaTime, std::vector<TileEvent>& due);
+    void AdvanceTicks(std::uint64_t ticks, std::vector<TileEvent>& due);
+
+    void Clear();
+
+    std::uint64_t GetCurrentTick() const { return m_currentTick; }
+    int GetPendingCount() const { return m_pendingCount; }
+
+    static constexpr int TICKS_PER_SECOND = 20;
+    static constexpr int LEVELS = 4;
+    static constexpr int SLOT_BITS = 6;
+    static constexpr int SLOTS = 1 << SLOT_BITS;
+    static constexpr std::uint64_t SLOT_MASK = SLOTS - 1;
+    static constexpr std::uint64_t MAX_DELAY_TICKS = (std::uint64_t(1) << (SLOT_BITS * LEVELS)) - 1;
+
+private:
+    struct Entry {
+        std::uint64_t expireTick;
+        TileEvent event;
+    };
+
+    void Insert(const Entry& entry);
+    void Cascade(int level);
+
+    std::vector<Entry> m_slots[LEVELS][SLOTS];
+    std::uint64_t m_currentTick;
+    float m_tickAccumulator;
+    int m_pendingCount;
+};
+
+#endif // TIMERWHEEL_H
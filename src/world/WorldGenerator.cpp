@@ -19,6 +19,9 @@ void WorldGenerator::SetSeed(unsigned int seed) {
 // ============================================================================
 
 void WorldGenerator::GenerateFarm(Map* map, int width, int height) {
+    map->Reset(width, height);
+    m_rng.seed(m_seed);   // Same seed, same map, however often this generator is reused
+
     // STEP 1: Generate farm zones (logical layout)
     auto zones = GenerateFarmZones(width, height);
     
@@ -42,6 +45,8 @@ void WorldGenerator::GenerateFarm(Map* map, int width, int height) {
     
     // STEP 6: Add scattered trees around the farm edges
     AddTrees(map, 0.15f);
+
+    map->SetOrigin({MapOrigin::Kind::FARM, m_seed, width, height, 0});
 }
 
 std::vector<WorldGenerator::FarmZone> WorldGenerator::GenerateFarmZones(int width, int height) {
@@ -97,6 +102,9 @@ void WorldGenerator::ApplyFarmZone(Map* map, const FarmZone& zone) {
 // ============================================================================
 
 void WorldGenerator::GenerateDungeon(Map* map, int width, int height) {
+    map->Reset(width, height);
+    m_rng.seed(m_seed);
+
     // STEP 1: Fill with void/walls
     for (int y = 0; y < height; ++y) {
         for (int x = 0; x < width; ++x) {
@@ -123,16 +131,16 @@ void WorldGenerator::GenerateDungeon(Map* map, int width, int height) {
         for (int x = room.x; x < room.x + room.width; ++x) {
             // Top edge
             if (room.y > 0) {
-                Tile* above = map->GetTileAt(x, room.y - 1);
-                Tile* edge = map->GetTileAt(x, room.y);
+                const Tile* above = map->GetTileAt(x, room.y - 1);
+                const Tile* edge = map->GetTileAt(x, room.y);
                 if (above && edge && above->GetType() == TileType::FLOOR && edge->GetType() == TileType::FLOOR) {
                     map->SetTile(x, room.y, Tile(TileType::DOOR, 0));
                 }
             }
             // Bottom edge
             if (room.y + room.height < map->GetHeight()) {
-                Tile* below = map->GetTileAt(x, room.y + room.height);
-                Tile* edge = map->GetTileAt(x, room.y + room.height - 1);
+                const Tile* below = map->GetTileAt(x, room.y + room.height);
+                const Tile* edge = map->GetTileAt(x, room.y + room.height - 1);
                 if (below && edge && below->GetType() == TileType::FLOOR && edge->GetType() == TileType::FLOOR) {
                     map->SetTile(x, room.y + room.height - 1, Tile(TileType::DOOR, 0));
                 }
@@ -141,16 +149,16 @@ void WorldGenerator::GenerateDungeon(Map* map, int width, int height) {
         for (int y = room.y; y < room.y + room.height; ++y) {
             // Left edge
             if (room.x > 0) {
-                Tile* left = map->GetTileAt(room.x - 1, y);
-                Tile* edge = map->GetTileAt(room.x, y);
+                const Tile* left = map->GetTileAt(room.x - 1, y);
+                const Tile* edge = map->GetTileAt(room.x, y);
                 if (left && edge && left->GetType() == TileType::FLOOR && edge->GetType() == TileType::FLOOR) {
                     map->SetTile(room.x, y, Tile(TileType::DOOR, 0));
                 }
             }
             // Right edge
             if (room.x + room.width < map->GetWidth()) {
-                Tile* right = map->GetTileAt(room.x + room.width, y);
-                Tile* edge = map->GetTileAt(room.x + room.width - 1, y);
+                const Tile* right = map->GetTileAt(room.x + room.width, y);
+                const Tile* edge = map->GetTileAt(room.x + room.width - 1, y);
                 if (right && edge && right->GetType() == TileType::FLOOR && edge->GetType() == TileType::FLOOR) {
                     map->SetTile(room.x + room.width - 1, y, Tile(TileType::DOOR, 0));
                 }
@@ -163,6 +171,8 @@ void WorldGenerator::GenerateDungeon(Map* map, int width, int height) {
     
     // STEP 7: Add decorations and details
     AddDecorations(map, 0.03f);
+
+    map->SetOrigin({MapOrigin::Kind::DUNGEON, m_seed, width, height, 0});
 }
 
 std::vector<WorldGenerator::Room> WorldGenerator::GenerateRooms(int mapWidth, int mapHeight) {
@@ -257,7 +267,10 @@ void WorldGenerator::CarveCorridor(Map* map, const Corridor& corridor) {
 // OVERWORLD GENERATION (Noise-based)
 // ============================================================================
 
-void WorldGenerator::GenerateOverworld(Map* map, int width, int height, Biome /*biome*/) {
+void WorldGenerator::GenerateOverworld(Map* map, int width, int height, Biome biome) {
+    map->Reset(width, height);
+    m_rng.seed(m_seed);
+
     for (int y = 0; y < height; ++y) {
         for (int x = 0; x < width; ++x) {
             float heightValue = Noise2D(x, y, 4);
@@ -271,6 +284,8 @@ void WorldGenerator::GenerateOverworld(Map* map, int width, int height, Biome /*
     ApplyAutoTiling(map);
     AddDecorations(map, 0.08f);
     AddTrees(map, 0.12f);
+
+    map->SetOrigin({MapOrigin::Kind::OVERWORLD, m_seed, width, height, static_cast<std::uint8_t>(biome)});
 }
 
 float WorldGenerator::Noise2D(int x, int y, int octaves) {
@@ -314,7 +329,7 @@ TileType WorldGenerator::DetermineTileFromNoise(float height, float moisture) {
 void WorldGenerator::ApplyAutoTiling(Map* map) {
     for (int y = 0; y < map->GetHeight(); ++y) {
         for (int x = 0; x < map->GetWidth(); ++x) {
-            Tile* tile = map->GetTileAt(x, y);
+            const Tile* tile = map->GetTileAt(x, y);
             if (!tile) continue;
             
             // Auto-tile walls based on neighbors
@@ -330,7 +345,7 @@ void WorldGenerator::ApplyAutoTiling(Map* map) {
                 bool se = (x < map->GetWidth()-1 && y < map->GetHeight()-1 && map->GetTileAt(x+1, y+1)->GetType() == TileType::WALL);
                 
                 int visualId = GetWallAutoTile(n, s, e, w, nw, ne, sw, se);
-                tile->SetVisualId(visualId);
+                map->SetTile(x, y, Tile(TileType::WALL, visualId));
             }
         }
     }
@@ -365,7 +380,7 @@ int WorldGenerator::GetWallAutoTile(bool n, bool s, bool e, bool w,
 void WorldGenerator::AddDecorations(Map* map, float density) {
     for (int y = 1; y < map->GetHeight() - 1; ++y) {
         for (int x = 1; x < map->GetWidth() - 1; ++x) {
-            Tile* tile = map->GetTileAt(x, y);
+            const Tile* tile = map->GetTileAt(x, y);
             if (!tile) continue;
             
             // Only decorate grass tiles
@@ -374,7 +389,7 @@ void WorldGenerator::AddDecorations(Map* map, float density) {
                 bool clearPath = true;
                 for (int dy = -1; dy <= 1; ++dy) {
                     for (int dx = -1; dx <= 1; ++dx) {
-                        Tile* neighbor = map->GetTileAt(x + dx, y + dy);
+                        const Tile* neighbor = map->GetTileAt(x + dx, y + dy);
                         if (neighbor && neighbor->GetType() == TileType::DIRT) {
                             clearPath = false;
                             break;
@@ -383,8 +398,7 @@ void WorldGenerator::AddDecorations(Map* map, float density) {
                 }
                 
                 if (clearPath) {
-                    tile->SetType(TileType::DECORATION);
-                    tile->SetVisualId(Random(0, 3)); // Random decoration
+                    map->SetTile(x, y, Tile(TileType::DECORATION, Random(0, 3))); // Random decoration
                 }
             }
         }
@@ -394,7 +408,7 @@ void WorldGenerator::AddDecorations(Map* map, float density) {
 void WorldGenerator::AddTrees(Map* map, float density) {
     for (int y = 1; y < map->GetHeight() - 1; ++y) {
         for (int x = 1; x < map->GetWidth() - 1; ++x) {
-            Tile* tile = map->GetTileAt(x, y);
+            const Tile* tile = map->GetTileAt(x, y);
             if (!tile) continue;
 
             // Only place trees on grass tiles
@@ -404,7 +418,7 @@ void WorldGenerator::AddTrees(Map* map, float density) {
                 for (int dy = -1; dy <= 1; ++dy) {
                     for (int dx = -1; dx <= 1; ++dx) {
                         if (dx == 0 && dy == 0) continue;
-                        Tile* neighbor = map->GetTileAt(x + dx, y + dy);
+                        const Tile* neighbor = map->GetTileAt(x + dx, y + dy);
                         if (neighbor) {
                             TileType nt = neighbor->GetType();
                             if (nt == TileType::DIRT || nt == TileType::SOIL ||
@@ -418,8 +432,7 @@ void WorldGenerator::AddTrees(Map* map, float density) {
                 }
 
                 if (clear) {
-                    tile->SetType(TileType::TREE);
-                    tile->SetVisualId(0);
+                    map->SetTile(x, y, Tile(TileType::TREE, 0));
                 }
             }
         }
@@ -38,12 +38,14 @@ class WorldGenerator {
 public:
     explicit WorldGenerator(unsigned int seed = 0);
     
-    // Generate different world types
+    // Generate different world types. Each call resets the map to the given
+    // size and records the seed and parameters as the map's origin.
     void GenerateFarm(Map* map, int width, int height);
     void GenerateDungeon(Map* map, int width, int height);
     void GenerateOverworld(Map* map, int width, int height, Biome biome);
     
     void SetSeed(unsigned int seed);
+    unsigned int GetSeed() const { return m_seed; }
 
 private:
     // === STEP 1: Layout Generation (Logical) ===
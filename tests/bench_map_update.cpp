@@ -0,0 +1,142 @@
+// Harvest Quest — Map::Update benchmark
+// Compares the per-frame cost of growing crops through the timer wheel
+// against polling every tile of the map each frame (what Map::Update did
+// before growth was scheduled), and the overnight Map::AdvanceDay batch
+// against the old one-plot-at-a-time loop from Game::AdvanceDay.
+// Not registered with CTest; run it by hand:
+//   ./bench_map_update [frames]
+
+#include "world/Map.h"
+#include "world/Tile.h"
+#include "systems/Farming.h"
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+
+static constexpr int MAP_SIZE = 1024;
+static constexpr int CROP_COUNT = 400;
+static constexpr float FRAME_DT = 1.0f / 60.0f;
+static constexpr int NIGHT_MAP_SIZE = 1024;
+static constexpr int NIGHTS = 3;
+
+// Build a fully populated map with CROP_COUNT crops scattered across it
+static void BuildFarm(Map& map) {
+    for (int y = 0; y < MAP_SIZE; ++y) {
+        for (int x = 0; x < MAP_SIZE; ++x) {
+            map.SetTile(x, y, Tile(TileType::GRASS, 0));
+        }
+    }
+    unsigned int state = 12345;
+    int planted = 0;
+    while (planted < CROP_COUNT) {
+        state = state * 1664525u + 1013904223u;
+        int x = static_cast<int>((state >> 8) % MAP_SIZE);
+        state = state * 1664525u + 1013904223u;
+        int y = static_cast<int>((state >> 8) % MAP_SIZE);
+        if (map.TillSoil(x, y) && map.PlantCrop(x, y, 0)) {
+            planted++;
+        }
+    }
+}
+
+// Old behaviour: visit every tile each frame, polling each crop's timer
+static void FullScanUpdate(Map& map, float deltaTime, float& growthTimer) {
+    growthTimer += deltaTime;
+    bool grow = growthTimer >= FarmPlot::GROWTH_INTERVAL;
+    if (grow) growthTimer -= FarmPlot::GROWTH_INTERVAL;
+    for (int y = 0; y < map.GetHeight(); ++y) {
+        for (int x = 0; x < map.GetWidth(); ++x) {
+            const Tile* tile = map.GetTileAt(x, y);
+            if (tile && tile->IsFarmable()) {
+                FarmPlot* plot = map.GetFarmPlot(x, y);
+                if (plot && plot->GetSoilState() == SoilState::CROP && grow) {
+                    plot->AdvanceGrowth();
+                }
+            }
+        }
+    }
+}
+
+// Plant every other tile of a large map
+static int BuildBigFarm(Map& map) {
+    int planted = 0;
+    for (int y = 0; y < NIGHT_MAP_SIZE; ++y) {
+        for (int x = 0; x < NIGHT_MAP_SIZE; x += 2) {
+            if (map.TillSoil(x, y) && map.PlantCrop(x, y, (x + y) % FarmingSystem::CROP_TYPE_COUNT)) {
+                planted++;
+            }
+        }
+    }
+    return planted;
+}
+
+// Old behaviour: Game::AdvanceDay's loop over the plot table
+static void LegacyAdvanceDay(Map& map) {
+    for (auto& entry : map.GetFarmPlots()) {
+        FarmPlot& plot = entry.second;
+        if (plot.GetSoilState() == SoilState::CROP) {
+            int stage = plot.GetGrowthStage() + 1;
+            int maxDays = FarmingSystem::GetGrowthDays(static_cast<CropType>(plot.GetCropType()));
+            if (stage >= maxDays) {
+                plot.SetSoilState(SoilState::HARVEST);
+                plot.SetGrowthStage(FarmPlot::MAX_GROWTH_STAGE);
+            } else {
+                plot.SetGrowthStage(stage);
+            }
+        }
+    }
+}
+
+template <typename Fn>
+static double TimeFrames(int frames, Fn&& fn) {
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < frames; ++i) fn();
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::milli>(end - start).count() / frames;
+}
+
+int main(int argc, char* argv[]) {
+    int frames = (argc > 1) ? std::atoi(argv[1]) : 120;
+    if (frames <= 0) frames = 120;
+    TileRegistry::Initialize();
+
+    std::cout << "=== Map::Update Benchmark ===" << std::endl;
+    std::cout << "  Map: " << MAP_SIZE << "x" << MAP_SIZE
+              << ", crops: " << CROP_COUNT << ", frames: " << frames << std::endl;
+
+    const float dt = FRAME_DT;
+
+    Map scanMap(MAP_SIZE, MAP_SIZE);
+    BuildFarm(scanMap);
+    float scanTimer = 0.0f;
+    double scanMs = TimeFrames(frames, [&] { FullScanUpdate(scanMap, dt, scanTimer); });
+
+    Map activeMap(MAP_SIZE, MAP_SIZE);
+    BuildFarm(activeMap);
+    double activeMs = TimeFrames(frames, [&] { activeMap.Update(dt); });
+
+    std::cout << "  Full-area scan: " << scanMs << " ms/frame" << std::endl;
+    std::cout << "  Timer wheel:    " << activeMs << " ms/frame"
+              << " (" << activeMap.GetPendingEventCount() << " events pending)" << std::endl;
+    if (activeMs > 0.0) {
+        std::cout << "  Speedup: " << (scanMs / activeMs) << "x" << std::endl;
+    }
+
+    std::cout << std::endl << "=== Map::AdvanceDay Benchmark ===" << std::endl;
+    Map legacyMap(NIGHT_MAP_SIZE, NIGHT_MAP_SIZE);
+    int crops = BuildBigFarm(legacyMap);
+    std::cout << "  Map: " << NIGHT_MAP_SIZE << "x" << NIGHT_MAP_SIZE
+              << ", crops: " << crops << ", nights: " << NIGHTS << std::endl;
+    double legacyMs = TimeFrames(NIGHTS, [&] { LegacyAdvanceDay(legacyMap); });
+
+    Map batchMap(NIGHT_MAP_SIZE, NIGHT_MAP_SIZE);
+    BuildBigFarm(batchMap);
+    double batchMs = TimeFrames(NIGHTS, [&] { batchMap.AdvanceDay(); });
+
+    std::cout << "  Plot-table loop: " << legacyMs << " ms/night" << std::endl;
+    std::cout << "  Batch kernel:    " << batchMs << " ms/night" << std::endl;
+    if (batchMs > 0.0) {
+        std::cout << "  Speedup: " << (legacyMs / batchMs) << "x" << std::endl;
+    }
+    return 0;
+}
@@ -0,0 +1,170 @@
+// Harvest Quest — Actor registry (structure-of-arrays enemies/NPCs) unit tests
+
+#include "entities/ActorRegistry.h"
+#include "entities/Enemy.h"
+#include "entities/NPC.h"
+#include "systems/ActorSystems.h"
+#include <cassert>
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+static int s_passed = 0;
+static int s_failed = 0;
+
+#define TEST(name) static void name()
+#define RUN_TEST(name) do { \
+    std::cout << "  " #name "... "; \
+    try { name(); std::cout << "PASS" << std::endl; s_passed++; } \
+    catch (...) { std::cout << "FAIL" << std::endl; s_failed++; } \
+} while(0)
+#define ASSERT_TRUE(expr)  do { if (!(expr)) throw 1; } while(0)
+#define ASSERT_FALSE(expr) do { if (expr) throw 1; } while(0)
+#define ASSERT_EQ(a, b)    do { if ((a) != (b)) throw 1; } while(0)
+#define ASSERT_NEAR(a, b, eps) do { if (std::fabs((a) - (b)) > (eps)) throw 1; } while(0)
+
+TEST(test_destroyed_id_is_stale) {
+    ActorRegistry registry;
+    ActorId id = registry.Create(ActorKind::ENEMY);
+    ASSERT_TRUE(id != 0);
+    ASSERT_TRUE(registry.IsAlive(id));
+    registry.Destroy(id);
+    ASSERT_FALSE(registry.IsAlive(id));
+    ASSERT_EQ(registry.GetRow(id), -1);
+
+    // The slot is reused, but the old id must not see the new actor
+    ActorId reused = registry.Create(ActorKind::ENEMY);
+    ASSERT_TRUE(reused != id);
+    ASSERT_TRUE(registry.IsAlive(reused));
+    ASSERT_FALSE(registry.IsAlive(id));
+}
+
+TEST(test_old_id_stays_stale_over_many_reuses) {
+    ActorRegistry registry;
+    ActorId first = registry.Create(ActorKind::NPC);
+    registry.Destroy(first);
+    // Well past any small generation counter wrapping back to the first id
+    for (int i = 0; i < 1000; ++i) {
+        ActorId id = registry.Create(ActorKind::NPC);
+        ASSERT_TRUE(id != first);
+        ASSERT_FALSE(registry.IsAlive(first));
+        registry.Destroy(id);
+    }
+}
+
+TEST(test_swap_remove_keeps_rows_packed) {
+    ActorRegistry registry;
+    std::vector<ActorId> ids;
+    for (int i = 0; i < 5; ++i) {
+        ActorId id = registry.Create(ActorKind::ENEMY);
+        registry.GetColumns(ActorKind::ENEMY).x[registry.GetRow(id)] = static_cast<float>(i);
+        ids.push_back(id);
+    }
+    registry.Destroy(ids[1]);
+    ASSERT_EQ(registry.GetCount(ActorKind::ENEMY), 4);
+
+    // Every survivor still finds its own data
+    const ActorColumns& c = registry.GetColumns(ActorKind::ENEMY);
+    for (int i = 0; i < 5; ++i) {
+        if (i == 1) continue;
+        int row = registry.GetRow(ids[i]);
+        ASSERT_TRUE(row >= 0 && row < 4);
+        ASSERT_EQ(c.x[row], static_cast<float>(i));
+        ASSERT_EQ(c.id[row], ids[i]);
+    }
+}
+
+TEST(test_kinds_have_separate_tables) {
+    ActorRegistry registry;
+    ActorId enemy = registry.Create(ActorKind::ENEMY);
+    ActorId npc = registry.Create(ActorKind::NPC);
+    registry.Create(ActorKind::NPC);
+    ASSERT_EQ(registry.GetCount(ActorKind::ENEMY), 1);
+    ASSERT_EQ(registry.GetCount(ActorKind::NPC), 2);
+    ASSERT_TRUE(registry.GetKind(enemy) == ActorKind::ENEMY);
+    ASSERT_TRUE(registry.GetKind(npc) == ActorKind::NPC);
+    ASSERT_EQ(static_cast<int>(registry.GetEnemyColumns().health.size()), 1);
+
+    registry.Clear();
+    ASSERT_EQ(registry.GetCount(ActorKind::ENEMY), 0);
+    ASSERT_EQ(registry.GetCount(ActorKind::NPC), 0);
+    ASSERT_FALSE(registry.IsAlive(enemy));
+    ASSERT_FALSE(registry.IsAlive(npc));
+}
+
+TEST(test_view_owns_its_row) {
+    ActorRegistry registry;
+    {
+        Enemy enemy(&registry);
+        NPC npc(&registry);
+        enemy.SetPosition(10.0f, 20.0f);
+        ASSERT_EQ(registry.GetCount(ActorKind::ENEMY), 1);
+        ASSERT_EQ(registry.GetCount(ActorKind::NPC), 1);
+        ASSERT_EQ(registry.GetColumns(ActorKind::ENEMY).x[0], 10.0f);
+    }
+    ASSERT_EQ(registry.GetCount(ActorKind::ENEMY), 0);
+    ASSERT_EQ(registry.GetCount(ActorKind::NPC), 0);
+}
+
+TEST(test_system_matches_per_view_update) {
+    // The batched system and Enemy::Update run the same chase for one row
+    ActorRegistry batched;
+    Enemy a(&batched);
+    Enemy b;
+    a.SetPosition(100.0f, 100.0f);
+    b.SetPosition(100.0f, 100.0f);
+    a.SetAIState(Enemy::AIState::CHASE);
+    b.SetAIState(Enemy::AIState::CHASE);
+    b.SetTarget(160.0f, 100.0f);
+
+    ActorSystems::SetEnemyTargets(batched, 160.0f, 100.0f);
+    ActorSystems::UpdateEnemies(batched, 0.1f);
+    b.Update(0.1f);
+
+    float ax, ay, bx, by;
+    a.GetPosition(ax, ay);
+    b.GetPosition(bx, by);
+    ASSERT_TRUE(ax > 100.0f);
+    ASSERT_NEAR(ax, bx, 1e-4f);
+    ASSERT_NEAR(ay, by, 1e-4f);
+}
+
+TEST(test_many_enemies_update_linearly) {
+    const int count = 20000;
+    ActorRegistry registry;
+    std::vector<ActorId> ids;
+    for (int i = 0; i < count; ++i) {
+        ActorId id = registry.Create(ActorKind::ENEMY);
+        int row = registry.GetRow(id);
+        registry.GetColumns(ActorKind::ENEMY).x[row] = static_cast<float>(i % 200);
+        registry.GetEnemyColumns().aiState[row] = EnemyAIState::CHASE;
+        ids.push_back(id);
+    }
+    // Knock a hole in the table; the rest must still update in place
+    for (int i = 0; i < count; i += 3) registry.Destroy(ids[i]);
+
+    ActorSystems::StorePreviousPositions(registry, ActorKind::ENEMY);
+    ActorSystems::SetEnemyTargets(registry, 100.0f, 150.0f);
+    ActorSystems::UpdateEnemies(registry, 1.0f / 60.0f);
+
+    const ActorColumns& c = registry.GetColumns(ActorKind::ENEMY);
+    int live = registry.GetCount(ActorKind::ENEMY);
+    ASSERT_EQ(live, count - (count + 2) / 3);
+    for (int row = 0; row < live; ++row) {
+        ASSERT_TRUE(c.y[row] > c.prevY[row]);   // Every chaser closed in on the target
+    }
+}
+
+int main() {
+    std::cout << "=== Actor Registry Tests ===" << std::endl;
+    RUN_TEST(test_destroyed_id_is_stale);
+    RUN_TEST(test_old_id_stays_stale_over_many_reuses);
+    RUN_TEST(test_swap_remove_keeps_rows_packed);
+    RUN_TEST(test_kinds_have_separate_tables);
+    RUN_TEST(test_view_owns_its_row);
+    RUN_TEST(test_system_matches_per_view_update);
+    RUN_TEST(test_many_enemies_update_linearly);
+
+    std::cout << std::endl << s_passed << " passed, " << s_failed << " failed" << std::endl;
+    return s_failed > 0 ? 1 : 0;
+}
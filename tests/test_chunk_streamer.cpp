@@ -0,0 +1,257 @@
+// Harvest Quest — Chunk streamer unit tests
+// Streams a map in and out of a scratch swap directory and checks that no
+// tile data is lost on the way.
+
+#include "world/ChunkStreamer.h"
+#include "world/Map.h"
+#include "world/Tile.h"
+#include <cassert>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <thread>
+
+static int s_passed = 0;
+static int s_failed = 0;
+
+#define TEST(name) static void name()
+#define RUN_TEST(name) do { \
+    std::cout << "  " #name "... "; \
+    try { name(); std::cout << "PASS" << std::endl; s_passed++; } \
+    catch (...) { std::cout << "FAIL" << std::endl; s_failed++; } \
+} while(0)
+#define ASSERT_TRUE(expr)  do { if (!(expr)) throw 1; } while(0)
+#define ASSERT_FALSE(expr) do { if (expr) throw 1; } while(0)
+#define ASSERT_EQ(a, b)    do { if ((a) != (b)) throw 1; } while(0)
+
+static const char* SWAP_DIR = "test_chunk_swap";
+static constexpr int MAP_SIZE = 256;   // 8x8 chunks
+static constexpr int WORLD_TILE = 32;  // Pixels per tile
+
+static ChunkStreamerConfig SmallConfig() {
+    ChunkStreamerConfig config;
+    config.residencyRadius = 1;
+    config.memoryBudgetBytes = 0;
+    config.swapDirectory = SWAP_DIR;
+    return config;
+}
+
+// Give every tile a recognisable value so lost data shows up
+static void FillPattern(Map& map) {
+    for (int y = 0; y < MAP_SIZE; ++y) {
+        for (int x = 0; x < MAP_SIZE; ++x) {
+            map.SetTile(x, y, Tile((x + y) % 3 == 0 ? TileType::STONE : TileType::DIRT, (x * 7 + y) % 16));
+        }
+    }
+}
+
+static bool PatternIntact(const Map& map) {
+    for (int y = 0; y < MAP_SIZE; ++y) {
+        for (int x = 0; x < MAP_SIZE; ++x) {
+            const Tile* tile = map.GetTileAt(x, y);
+            TileType expected = (x + y) % 3 == 0 ? TileType::STONE : TileType::DIRT;
+            if (!tile || tile->GetType() != expected || tile->GetVisualId() != (x * 7 + y) % 16) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+// Keep updating until the worker has finished everything (bounded wait)
+static void Settle(ChunkStreamer& streamer, float focusX, float focusY) {
+    for (int i = 0; i < 500; ++i) {
+        streamer.Update(focusX, focusY);
+        if (streamer.GetPendingJobCount() == 0) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(2));
+            streamer.Update(focusX, focusY);
+            if (streamer.GetPendingJobCount() == 0) return;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    }
+}
+
+TEST(test_evicts_chunks_outside_radius) {
+    Map map(MAP_SIZE, MAP_SIZE);
+    FillPattern(map);
+    ChunkStreamer streamer(&map, SmallConfig());
+
+    streamer.Update(0.0f, 0.0f);
+    // Radius 1 plus the hysteresis ring keeps a 3x3 corner resident
+    ASSERT_EQ(streamer.GetResidentChunkCount(), 9);
+    ASSERT_EQ(streamer.GetEvictionCount(), 64 - 9);
+    ASSERT_TRUE(map.IsChunkEvicted(7, 7));
+    ASSERT_FALSE(map.IsChunkEvicted(0, 0));
+}
+
+TEST(test_returning_chunks_load_in_background) {
+    Map map(MAP_SIZE, MAP_SIZE);
+    FillPattern(map);
+    ChunkStreamer streamer(&map, SmallConfig());
+    Settle(streamer, 0.0f, 0.0f);
+
+    // Walk to the far corner; its chunks come back without any stall
+    float far = static_cast<float>((MAP_SIZE - 1) * WORLD_TILE);
+    Settle(streamer, far, far);
+    ASSERT_FALSE(map.IsChunkEvicted(7, 7));
+    ASSERT_FALSE(map.IsChunkEvicted(6, 6));
+    ASSERT_TRUE(map.IsChunkEvicted(0, 0));
+    ASSERT_TRUE(streamer.GetLoadCount() >= 4);
+    ASSERT_EQ(streamer.GetStallCount(), 0);
+}
+
+TEST(test_touching_evicted_chunk_stalls_and_keeps_data) {
+    Map map(MAP_SIZE, MAP_SIZE);
+    FillPattern(map);
+    ChunkStreamer streamer(&map, SmallConfig());
+    Settle(streamer, 0.0f, 0.0f);
+
+    const Tile* tile = map.GetTileAt(200, 200);
+    ASSERT_TRUE(tile != nullptr);
+    ASSERT_EQ(tile->GetType(), (200 + 200) % 3 == 0 ? TileType::STONE : TileType::DIRT);
+    ASSERT_EQ(streamer.GetStallCount(), 1);
+    ASSERT_FALSE(map.IsChunkEvicted(6, 6));
+
+    // Writes fault the chunk in too, and survive another round trip
+    map.SetTile(250, 10, Tile(TileType::WATER));
+    Settle(streamer, 0.0f, 0.0f);
+    ASSERT_TRUE(map.IsChunkEvicted(7, 0));
+    ASSERT_EQ(map.GetTileAt(250, 10)->GetType(), TileType::WATER);
+}
+
+TEST(test_collision_does_not_fault_chunks_in) {
+    Map map(MAP_SIZE, MAP_SIZE);
+    FillPattern(map);
+    map.SetTile(200, 201, Tile(TileType::WALL));
+    ChunkStreamer streamer(&map, SmallConfig());
+    Settle(streamer, 0.0f, 0.0f);
+    ASSERT_TRUE(map.IsChunkEvicted(6, 6));
+
+    ASSERT_TRUE(map.IsSolid(200, 201));
+    ASSERT_FALSE(map.IsSolid(200, 200));
+    ASSERT_TRUE(map.IsAreaSolid(199 * WORLD_TILE, 199 * WORLD_TILE, 3 * WORLD_TILE, 3 * WORLD_TILE));
+    ASSERT_EQ(streamer.GetStallCount(), 0);
+    ASSERT_TRUE(map.IsChunkEvicted(6, 6));
+}
+
+TEST(test_destructor_restores_whole_map) {
+    Map map(MAP_SIZE, MAP_SIZE);
+    FillPattern(map);
+    {
+        ChunkStreamer streamer(&map, SmallConfig());
+        streamer.Update(0.0f, 0.0f);
+        ASSERT_TRUE(map.IsChunkEvicted(5, 5));
+    }
+    ASSERT_EQ(map.GetAllocatedChunkCount(), 64);
+    ASSERT_TRUE(PatternIntact(map));
+}
+
+TEST(test_memory_budget_trims_hysteresis_ring) {
+    Map map(MAP_SIZE, MAP_SIZE);
+    FillPattern(map);
+    // SmallConfig has no memory budget, so only the radius itself is guaranteed
+    ChunkStreamer streamer(&map, SmallConfig());
+    // Focus on chunk (3,3): radius keeps 3x3, the ring around it is over budget
+    float centre = static_cast<float>(3 * Map::CHUNK_SIZE * WORLD_TILE + 16);
+    streamer.Update(centre, centre);
+    ASSERT_EQ(streamer.GetResidentChunkCount(), 9);
+}
+
+TEST(test_unusable_swap_directory_disables_eviction) {
+    // A regular file where the swap directory's parent should be
+    const char* blocker = "test_chunk_swap_blocker";
+    { std::ofstream file(blocker); }
+    Map map(MAP_SIZE, MAP_SIZE);
+    FillPattern(map);
+    ChunkStreamerConfig config = SmallConfig();
+    config.swapDirectory = std::string(blocker) + "/chunks";
+    {
+        ChunkStreamer streamer(&map, config);
+        ASSERT_FALSE(streamer.IsSwapAvailable());
+        streamer.Update(0.0f, 0.0f);
+        streamer.Update(0.0f, 0.0f);
+        ASSERT_EQ(streamer.GetEvictionCount(), 0);
+        ASSERT_EQ(streamer.GetResidentChunkCount(), 64);
+    }
+    std::filesystem::remove(blocker);
+    ASSERT_TRUE(PatternIntact(map));
+}
+
+TEST(test_failed_write_keeps_chunk_resident) {
+    Map map(MAP_SIZE, MAP_SIZE);
+    FillPattern(map);
+    ChunkStreamer streamer(&map, SmallConfig());
+    // Pull the directory out from under the worker so every write fails
+    std::filesystem::remove_all(SWAP_DIR);
+    { std::ofstream file(SWAP_DIR); }
+
+    // Each chunk is tried once: the far ones, then the budget trims the ring
+    Settle(streamer, 0.0f, 0.0f);
+    Settle(streamer, 0.0f, 0.0f);
+    int evictions = streamer.GetEvictionCount();
+    ASSERT_TRUE(evictions >= 64 - 9 && evictions < 64);
+    ASSERT_EQ(streamer.GetResidentChunkCount(), 64);
+
+    // Handed-back chunks are not evicted (and written) again every frame
+    for (int i = 0; i < 10; ++i) streamer.Update(0.0f, 0.0f);
+    ASSERT_EQ(streamer.GetEvictionCount(), evictions);
+    ASSERT_TRUE(PatternIntact(map));
+    std::filesystem::remove(SWAP_DIR);
+}
+
+TEST(test_regenerating_mid_write_never_hangs_a_stall) {
+    Map map(MAP_SIZE, MAP_SIZE);
+    FillPattern(map);
+    ChunkStreamer streamer(&map, SmallConfig());
+    // Rebuild the map while the worker is still writing the last one's
+    // chunks, evict the same indices again and fault them straight back in
+    for (int round = 0; round < 200; ++round) {
+        streamer.Update(0.0f, 0.0f);
+        map.Reset(MAP_SIZE, MAP_SIZE);
+        FillPattern(map);
+        streamer.Update(0.0f, 0.0f);
+        ASSERT_TRUE(PatternIntact(map));   // Every evicted chunk stalls back in
+    }
+    Settle(streamer, 0.0f, 0.0f);
+    ASSERT_TRUE(PatternIntact(map));
+}
+
+TEST(test_failed_write_does_not_pin_next_map) {
+    Map map(MAP_SIZE, MAP_SIZE);
+    FillPattern(map);
+    ChunkStreamer streamer(&map, SmallConfig());
+    std::filesystem::remove_all(SWAP_DIR);
+    { std::ofstream file(SWAP_DIR); }
+    Settle(streamer, 0.0f, 0.0f);
+    ASSERT_EQ(streamer.GetResidentChunkCount(), 64);
+
+    // With the directory back, a new map evicts as usual
+    std::filesystem::remove(SWAP_DIR);
+    std::filesystem::create_directories(SWAP_DIR);
+    map.Reset(MAP_SIZE, MAP_SIZE);
+    FillPattern(map);
+    Settle(streamer, 0.0f, 0.0f);
+    ASSERT_TRUE(map.IsChunkEvicted(7, 7));
+    ASSERT_TRUE(PatternIntact(map));
+}
+
+int main() {
+    std::cout << "=== Chunk Streamer Tests ===" << std::endl;
+    TileRegistry::Initialize();
+    RUN_TEST(test_evicts_chunks_outside_radius);
+    RUN_TEST(test_returning_chunks_load_in_background);
+    RUN_TEST(test_touching_evicted_chunk_stalls_and_keeps_data);
+    RUN_TEST(test_collision_does_not_fault_chunks_in);
+    RUN_TEST(test_destructor_restores_whole_map);
+    RUN_TEST(test_memory_budget_trims_hysteresis_ring);
+    RUN_TEST(test_unusable_swap_directory_disables_eviction);
+    RUN_TEST(test_failed_write_keeps_chunk_resident);
+    RUN_TEST(test_regenerating_mid_write_never_hangs_a_stall);
+    RUN_TEST(test_failed_write_does_not_pin_next_map);
+
+    std::filesystem::remove_all(SWAP_DIR);
+
+    std::cout << std::endl << s_passed << " passed, " << s_failed << " failed" << std::endl;
+    return s_failed > 0 ? 1 : 0;
+}
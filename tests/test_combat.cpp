@@ -2,6 +2,11 @@
 // Tests pure-logic static methods (no Raylib dependency)
 
 #include "systems/Combat.h"
+#include "entities/Enemy.h"
+#include "entities/Player.h"
+#include "world/SpatialHash.h"
+#include "world/FlowField.h"
+#include "world/Map.h"
 #include <cassert>
 #include <iostream>
 
@@ -93,6 +98,150 @@ TEST(test_collision_zero_size) {
         5, 5, 10, 10));
 }
 
+// --- Enemy movement ---
+
+TEST(test_enemy_chase_stops_at_wall) {
+    Map map(10, 3);
+    for (int y = 0; y < 3; ++y) map.SetTile(5, y, Tile(TileType::WALL));
+
+    Enemy enemy;
+    enemy.SetMap(&map);
+    enemy.SetSize(28, 28);
+    enemy.SetPosition(32.0f, 32.0f);
+    enemy.SetTarget(8 * 32.0f, 32.0f);
+    enemy.SetAIState(Enemy::AIState::CHASE);
+    for (int i = 0; i < 200; ++i) enemy.Update(0.1f);
+
+    float x, y;
+    enemy.GetPosition(x, y);
+    ASSERT_TRUE(x + 28 <= 5 * 32.0f);   // Flush against the wall, never inside it
+    ASSERT_TRUE(x > 4 * 32.0f);
+}
+
+TEST(test_enemy_chase_follows_flow_field) {
+    // Wall down column 5 with a gap at row 5; the player is on the far side
+    Map map(10, 8);
+    for (int y = 0; y < 5; ++y) map.SetTile(5, y, Tile(TileType::WALL));
+    FlowField field;
+    field.Build(map, 8, 2);
+
+    Enemy enemy;
+    enemy.SetMap(&map);
+    enemy.SetFlowField(&field);
+    enemy.SetSize(28, 28);
+    enemy.SetPosition(2 * 32.0f + 2.0f, 2 * 32.0f + 2.0f);
+    enemy.SetTarget(8 * 32.0f + 2.0f, 2 * 32.0f + 2.0f);
+    enemy.SetAIState(Enemy::AIState::CHASE);
+    for (int i = 0; i < 600 && enemy.GetAIState() == Enemy::AIState::CHASE; ++i) enemy.Update(0.05f);
+
+    float x, y;
+    enemy.GetPosition(x, y);
+    int tileX, tileY;
+    map.WorldToTile(x + 14.0f, y + 14.0f, tileX, tileY);
+    ASSERT_EQ(tileX, 8);
+    ASSERT_EQ(tileY, 2);
+}
+
+TEST(test_enemy_render_position_interpolates) {
+    Enemy enemy;
+    enemy.SetSize(28, 28);
+    enemy.SetPosition(100.0f, 40.0f);
+    enemy.SetTarget(160.0f, 40.0f);
+    enemy.SetAIState(Enemy::AIState::CHASE);
+    enemy.StorePreviousPosition();
+    enemy.Update(0.1f);
+
+    float x, y, drawX, drawY;
+    enemy.GetPosition(x, y);
+    ASSERT_TRUE(x > 100.0f);
+    enemy.GetRenderPosition(0.0f, drawX, drawY);
+    ASSERT_EQ(drawX, 100.0f);
+    enemy.GetRenderPosition(1.0f, drawX, drawY);
+    ASSERT_EQ(drawX, x);
+    enemy.GetRenderPosition(0.5f, drawX, drawY);
+    ASSERT_EQ(drawX, 100.0f + (x - 100.0f) * 0.5f);
+
+    // A placement is a jump: nothing to blend from
+    enemy.SetPosition(10.0f, 10.0f);
+    enemy.GetRenderPosition(0.0f, drawX, drawY);
+    ASSERT_EQ(drawX, 10.0f);
+    ASSERT_EQ(drawY, 10.0f);
+}
+
+TEST(test_enemy_needs_sight_to_chase) {
+    Enemy enemy;
+    enemy.SetPosition(0.0f, 0.0f);
+    enemy.SetPatrolOrigin(0.0f, 0.0f);
+    enemy.SetTarget(100.0f, 0.0f);
+    enemy.SetTargetVisible(false);
+    enemy.Update(0.01f);
+    ASSERT_TRUE(enemy.GetAIState() == Enemy::AIState::PATROL);
+
+    enemy.SetTargetVisible(true);
+    enemy.Update(0.01f);
+    ASSERT_TRUE(enemy.GetAIState() == Enemy::AIState::CHASE);
+}
+
+TEST(test_enemy_gives_up_out_of_sight) {
+    Enemy enemy;
+    enemy.SetPosition(0.0f, 0.0f);
+    enemy.SetTarget(100.0f, 0.0f);
+    enemy.SetAIState(Enemy::AIState::CHASE);
+    enemy.SetTargetVisible(false);
+    float elapsed = 0.0f;
+    while (enemy.GetAIState() == Enemy::AIState::CHASE && elapsed < 10.0f) {
+        enemy.SetTarget(200.0f, 0.0f);   // Held in range; only sight is missing
+        enemy.SetPosition(0.0f, 0.0f);
+        enemy.Update(0.1f);
+        elapsed += 0.1f;
+    }
+    ASSERT_TRUE(enemy.GetAIState() == Enemy::AIState::PATROL);
+    ASSERT_TRUE(elapsed > Enemy::LOSE_SIGHT_TIME);
+}
+
+// --- Grid queries ---
+
+TEST(test_grid_attack_hits_only_nearby) {
+    Player player;
+    player.SetPosition(100, 100);
+    player.SetSize(32, 32);
+
+    SpatialHash<Enemy> grid;
+    std::vector<Enemy> enemies(200);
+    for (size_t i = 0; i < enemies.size(); ++i) {
+        float x = 64.0f * static_cast<float>(i);
+        enemies[i].SetPosition(x, 110);
+        enemies[i].SetSize(28, 28);
+        grid.Update(&enemies[i], x, 110, 28, 28);
+    }
+
+    std::vector<Enemy*> hits;
+    ASSERT_TRUE(Combat::PlayerAttack(&player, grid, 1, hits));
+    ASSERT_EQ(hits.size(), 2u);   // The enemies at x = 64 and x = 128
+    ASSERT_EQ(enemies[1].GetHealth(), 2);
+    ASSERT_EQ(enemies[2].GetHealth(), 2);
+    ASSERT_EQ(enemies[5].GetHealth(), 3);
+}
+
+TEST(test_grid_enemy_contact) {
+    Player player;
+    player.SetPosition(0, 0);
+    player.SetSize(32, 32);
+    player.SetHealth(5);
+
+    SpatialHash<Enemy> grid;
+    Enemy far;
+    far.SetPosition(500, 500);
+    grid.Update(&far, 500, 500, 32, 32);
+    ASSERT_TRUE(Combat::EnemyContact(grid, &player, 1) == nullptr);
+
+    Enemy close;
+    close.SetPosition(20, 20);
+    grid.Update(&close, 20, 20, 32, 32);
+    ASSERT_TRUE(Combat::EnemyContact(grid, &player, 1) == &close);
+    ASSERT_EQ(player.GetHealth(), 4);
+}
+
 // --- Constants tests ---
 
 TEST(test_attack_range_positive) {
@@ -118,6 +267,13 @@ int main() {
     RUN_TEST(test_collision_partial_x);
     RUN_TEST(test_collision_partial_y);
     RUN_TEST(test_collision_zero_size);
+    RUN_TEST(test_enemy_chase_stops_at_wall);
+    RUN_TEST(test_enemy_chase_follows_flow_field);
+    RUN_TEST(test_enemy_render_position_interpolates);
+    RUN_TEST(test_enemy_needs_sight_to_chase);
+    RUN_TEST(test_enemy_gives_up_out_of_sight);
+    RUN_TEST(test_grid_attack_hits_only_nearby);
+    RUN_TEST(test_grid_enemy_contact);
     RUN_TEST(test_attack_range_positive);
     RUN_TEST(test_damage_cooldown_positive);
 
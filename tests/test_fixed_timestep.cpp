@@ -0,0 +1,84 @@
+// Harvest Quest — Fixed simulation timestep unit tests
+
+#include "engine/FixedTimestep.h"
+#include <cassert>
+#include <cmath>
+#include <iostream>
+
+static int s_passed = 0;
+static int s_failed = 0;
+
+#define TEST(name) static void name()
+#define RUN_TEST(name) do { \
+    std::cout << "  " #name "... "; \
+    try { name(); std::cout << "PASS" << std::endl; s_passed++; } \
+    catch (...) { std::cout << "FAIL" << std::endl; s_failed++; } \
+} while(0)
+#define ASSERT_TRUE(expr)  do { if (!(expr)) throw 1; } while(0)
+#define ASSERT_FALSE(expr) do { if (expr) throw 1; } while(0)
+#define ASSERT_EQ(a, b)    do { if ((a) != (b)) throw 1; } while(0)
+#define ASSERT_NEAR(a, b, eps) do { if (std::fabs((a) - (b)) > (eps)) throw 1; } while(0)
+
+TEST(test_one_tick_per_matching_frame) {
+    FixedTimestep timestep(60, 5);
+    for (int frame = 0; frame < 600; ++frame) {
+        ASSERT_EQ(timestep.Advance(timestep.GetStep()), 1);
+    }
+    ASSERT_EQ(timestep.GetTickCount(), 600u);
+    ASSERT_NEAR(timestep.GetAlpha(), 0.0f, 1e-3f);
+}
+
+TEST(test_tick_count_independent_of_frame_rate) {
+    // One simulated second at 30, 144 and 240 frames per second
+    const int rates[3] = { 30, 144, 240 };
+    for (int fps : rates) {
+        FixedTimestep timestep(60, 5);
+        for (int frame = 0; frame < fps; ++frame) timestep.Advance(1.0 / fps);
+        ASSERT_TRUE(timestep.GetTickCount() >= 59u && timestep.GetTickCount() <= 60u);
+    }
+}
+
+TEST(test_fast_frames_interpolate) {
+    FixedTimestep timestep(60, 5);
+    double quarter = timestep.GetStep() / 4.0;
+    ASSERT_EQ(timestep.Advance(quarter), 0);
+    ASSERT_NEAR(timestep.GetAlpha(), 0.25f, 1e-4f);
+    ASSERT_EQ(timestep.Advance(quarter * 2.0), 0);
+    ASSERT_NEAR(timestep.GetAlpha(), 0.75f, 1e-4f);
+    ASSERT_EQ(timestep.Advance(quarter * 2.0), 1);
+    ASSERT_NEAR(timestep.GetAlpha(), 0.25f, 1e-4f);
+}
+
+TEST(test_slow_frame_is_capped) {
+    FixedTimestep timestep(60, 5);
+    ASSERT_EQ(timestep.Advance(1.0), 5);   // A one-second hitch
+    ASSERT_NEAR(timestep.GetDroppedTime(), 55.0 / 60.0, 1e-6);
+    ASSERT_TRUE(timestep.GetAlpha() < 1.0f);
+    // The backlog is gone: the next normal frame is a normal tick
+    ASSERT_EQ(timestep.Advance(timestep.GetStep()), 1);
+}
+
+TEST(test_configure_and_reset) {
+    FixedTimestep timestep;
+    timestep.Configure(20, 0);    // At least one catch-up step
+    ASSERT_EQ(timestep.GetTickRate(), 20);
+    ASSERT_EQ(timestep.GetMaxCatchUpSteps(), 1);
+    ASSERT_NEAR(timestep.GetStep(), 0.05, 1e-9);
+    ASSERT_EQ(timestep.Advance(-1.0), 0);   // Clock hiccups never run time backwards
+    ASSERT_EQ(timestep.Advance(0.07), 1);
+    timestep.Reset();
+    ASSERT_EQ(timestep.GetTickCount(), 0u);
+    ASSERT_EQ(timestep.GetAlpha(), 0.0f);
+}
+
+int main() {
+    std::cout << "=== Fixed Timestep Tests ===" << std::endl;
+    RUN_TEST(test_one_tick_per_matching_frame);
+    RUN_TEST(test_tick_count_independent_of_frame_rate);
+    RUN_TEST(test_fast_frames_interpolate);
+    RUN_TEST(test_slow_frame_is_capped);
+    RUN_TEST(test_configure_and_reset);
+
+    std::cout << std::endl << s_passed << " passed, " << s_failed << " failed" << std::endl;
+    return s_failed > 0 ? 1 : 0;
+}
@@ -0,0 +1,142 @@
+// Harvest Quest — Flow field unit tests
+
+#include "world/FlowField.h"
+#include "world/Map.h"
+#include <cassert>
+#include <iostream>
+
+static int s_passed = 0;
+static int s_failed = 0;
+
+#define TEST(name) static void name()
+#define RUN_TEST(name) do { \
+    std::cout << "  " #name "... "; \
+    try { name(); std::cout << "PASS" << std::endl; s_passed++; } \
+    catch (...) { std::cout << "FAIL" << std::endl; s_failed++; } \
+} while(0)
+#define ASSERT_TRUE(expr)  do { if (!(expr)) throw 1; } while(0)
+#define ASSERT_FALSE(expr) do { if (expr) throw 1; } while(0)
+#define ASSERT_EQ(a, b)    do { if ((a) != (b)) throw 1; } while(0)
+
+// Follows the field from (x, y); returns the number of steps to the target, or -1
+static int Walk(const FlowField& field, int x, int y, int maxSteps) {
+    int steps = 0;
+    while (!field.IsTarget(x, y)) {
+        if (steps >= maxSteps) return -1;
+        int nx, ny;
+        if (!field.GetNextTile(x, y, nx, ny)) return -1;
+        x = nx;
+        y = ny;
+        steps++;
+    }
+    return steps;
+}
+
+TEST(test_open_map_distances) {
+    Map map(20, 20);
+    FlowField field;
+    field.Build(map, 10, 10);
+    ASSERT_TRUE(field.IsBuilt());
+    ASSERT_TRUE(field.IsTarget(10, 10));
+    ASSERT_EQ(field.GetDistance(10, 10), 0);
+    ASSERT_EQ(field.GetDistance(13, 10), 3);
+    ASSERT_EQ(field.GetDistance(12, 7), 5);
+    ASSERT_EQ(field.GetDistance(-1, 0), -1);
+    ASSERT_EQ(field.GetVisitedCount(), 20 * 20);
+}
+
+TEST(test_diagonal_steps_on_open_ground) {
+    Map map(20, 20);
+    FlowField field;
+    field.Build(map, 10, 10);
+    int nx = 0, ny = 0;
+    ASSERT_TRUE(field.GetNextTile(13, 13, nx, ny));
+    ASSERT_EQ(nx, 12);
+    ASSERT_EQ(ny, 12);
+    ASSERT_EQ(Walk(field, 13, 13, 10), 3);
+    ASSERT_FALSE(field.GetNextTile(10, 10, nx, ny));   // Already there
+}
+
+TEST(test_routes_around_wall) {
+    // Wall down column 5 with a single gap at the bottom
+    Map map(10, 10);
+    for (int y = 0; y < 9; ++y) map.SetTile(5, y, Tile(TileType::WALL));
+    FlowField field;
+    field.Build(map, 8, 1);
+
+    ASSERT_EQ(field.GetDistance(5, 4), -1);            // Solid
+    ASSERT_TRUE(field.GetDistance(2, 1) > 7);         // Straight line is blocked
+    ASSERT_TRUE(Walk(field, 2, 1, 40) > 0);
+
+    // Every step on the way stays off the wall and never cuts its corner
+    int x = 2, y = 1;
+    while (!field.IsTarget(x, y)) {
+        int nx, ny;
+        ASSERT_TRUE(field.GetNextTile(x, y, nx, ny));
+        ASSERT_FALSE(map.IsSolid(nx, ny));
+        ASSERT_FALSE(map.IsSolid(nx, y));
+        ASSERT_FALSE(map.IsSolid(x, ny));
+        x = nx;
+        y = ny;
+    }
+}
+
+TEST(test_sealed_area_unreached) {
+    Map map(10, 10);
+    for (int i = 0; i < 10; ++i) map.SetTile(5, i, Tile(TileType::WALL));
+    FlowField field;
+    field.Build(map, 8, 5);
+    ASSERT_EQ(field.GetDistance(2, 5), -1);
+    int nx, ny;
+    ASSERT_FALSE(field.GetNextTile(2, 5, nx, ny));
+}
+
+TEST(test_max_steps_bounds_search) {
+    Map map(200, 200);
+    FlowField field;
+    field.Build(map, 100, 100, 5);
+    ASSERT_EQ(field.GetDistance(105, 100), 5);
+    ASSERT_EQ(field.GetDistance(106, 100), -1);
+    ASSERT_EQ(field.GetDistance(0, 0), -1);
+    ASSERT_EQ(field.GetVisitedCount(), 2 * 5 * 6 + 1);    // Diamond of radius 5
+}
+
+TEST(test_rebuild_forgets_old_target) {
+    Map map(50, 50);
+    FlowField field;
+    field.Build(map, 5, 5, 3);
+    ASSERT_EQ(field.GetDistance(6, 5), 1);
+    field.Build(map, 40, 40, 3);
+    ASSERT_EQ(field.GetDistance(6, 5), -1);
+    ASSERT_EQ(field.GetDistance(41, 40), 1);
+    ASSERT_FALSE(field.IsTarget(5, 5));
+
+    field.Clear();
+    ASSERT_FALSE(field.IsBuilt());
+    ASSERT_EQ(field.GetDistance(41, 40), -1);
+}
+
+TEST(test_solid_target_still_reached) {
+    // The player's centre can sit on a blocking tile while pressed against it
+    Map map(10, 10);
+    map.SetTile(5, 5, Tile(TileType::WALL));
+    FlowField field;
+    field.Build(map, 5, 5);
+    ASSERT_EQ(field.GetDistance(5, 5), 0);
+    ASSERT_EQ(field.GetDistance(5, 7), 2);
+    ASSERT_EQ(Walk(field, 5, 8, 10), 3);
+}
+
+int main() {
+    std::cout << "=== Flow Field Tests ===" << std::endl;
+    RUN_TEST(test_open_map_distances);
+    RUN_TEST(test_diagonal_steps_on_open_ground);
+    RUN_TEST(test_routes_around_wall);
+    RUN_TEST(test_sealed_area_unreached);
+    RUN_TEST(test_max_steps_bounds_search);
+    RUN_TEST(test_rebuild_forgets_old_target);
+    RUN_TEST(test_solid_target_still_reached);
+
+    std::cout << std::endl << s_passed << " passed, " << s_failed << " failed" << std::endl;
+    return s_failed > 0 ? 1 : 0;
+}
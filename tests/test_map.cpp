@@ -2,8 +2,10 @@
 // Tests tile operations, farming interactions, coordinate conversion,
 // and collision detection (pure logic, rendering stubs provided via linking)
 
+#include "engine/Renderer.h"
 #include "world/Map.h"
 #include "world/Tile.h"
+#include "systems/Farming.h"
 #include <cassert>
 #include <iostream>
 #include <fstream>
@@ -46,13 +48,13 @@ TEST(test_default_tiles_are_grass) {
 
 TEST(test_get_tile_at_valid) {
     Map map(5, 5);
-    Tile* tile = map.GetTileAt(2, 3);
+    const Tile* tile = map.GetTileAt(2, 3);
     ASSERT_TRUE(tile != nullptr);
 }
 
 TEST(test_get_tile_at_invalid) {
     Map map(5, 5);
-    Tile* tile = map.GetTileAt(-1, 0);
+    const Tile* tile = map.GetTileAt(-1, 0);
     ASSERT_TRUE(tile == nullptr);
     tile = map.GetTileAt(5, 0);
     ASSERT_TRUE(tile == nullptr);
@@ -72,6 +74,48 @@ TEST(test_set_tile) {
     ASSERT_EQ(tile->GetVisualId(), 3);
 }
 
+// ---- Chunked storage tests ----
+
+TEST(test_large_map_untouched_costs_nothing) {
+    Map map(4096, 4096);
+    ASSERT_EQ(map.GetChunksX(), 4096 / Map::CHUNK_SIZE);
+    ASSERT_EQ(map.GetAllocatedChunkCount(), 0);
+    // Const reads never allocate and see the fill tile
+    const Map& view = map;
+    const Tile* tile = view.GetTileAt(4000, 4000);
+    ASSERT_TRUE(tile != nullptr);
+    ASSERT_EQ(tile->GetType(), TileType::GRASS);
+    ASSERT_FALSE(map.IsSolid(4000, 4000));
+    ASSERT_EQ(map.GetAllocatedChunkCount(), 0);
+}
+
+TEST(test_set_tile_allocates_single_chunk) {
+    Map map(1000, 1000);
+    map.SetTile(999, 999, Tile(TileType::WALL));
+    ASSERT_EQ(map.GetAllocatedChunkCount(), 1);
+    ASSERT_TRUE(map.IsSolid(999, 999));
+    ASSERT_FALSE(map.IsSolid(998, 999));
+}
+
+TEST(test_tiles_across_chunk_boundary) {
+    Map map(100, 100);
+    int edge = Map::CHUNK_SIZE;
+    map.SetTile(edge - 1, 5, Tile(TileType::WATER));
+    map.SetTile(edge, 5, Tile(TileType::STONE));
+    ASSERT_EQ(map.GetTileAt(edge - 1, 5)->GetType(), TileType::WATER);
+    ASSERT_EQ(map.GetTileAt(edge, 5)->GetType(), TileType::STONE);
+    ASSERT_EQ(map.GetAllocatedChunkCount(), 2);
+}
+
+TEST(test_partial_edge_chunk) {
+    // 25x19 does not fill a whole chunk; edges must still be bounded by map size
+    Map map(25, 19);
+    ASSERT_EQ(map.GetChunksX(), 1);
+    ASSERT_EQ(map.GetChunksY(), 1);
+    ASSERT_TRUE(map.GetTileAt(24, 18) != nullptr);
+    ASSERT_TRUE(map.GetTileAt(25, 18) == nullptr);
+}
+
 // ---- Collision tests ----
 
 TEST(test_is_solid_wall) {
@@ -93,6 +137,236 @@ TEST(test_is_solid_out_of_bounds) {
     ASSERT_TRUE(map.IsSolid(5, 0));
 }
 
+TEST(test_area_solid_covers_whole_box) {
+    Map map(10, 10);
+    map.SetTile(4, 4, Tile(TileType::WALL));
+    // A 3x3-tile box whose corners are all clear but whose middle is a wall
+    ASSERT_TRUE(map.IsAreaSolid(3 * 32.0f, 3 * 32.0f, 96.0f, 96.0f));
+    ASSERT_FALSE(map.IsAreaSolid(0.0f, 0.0f, 96.0f, 96.0f));
+    ASSERT_TRUE(map.IsAreaSolid(9 * 32.0f + 8, 0.0f, 32.0f, 32.0f));   // Pokes off the map
+}
+
+TEST(test_solidity_follows_tile_changes) {
+    Map map(70, 10);
+    ASSERT_EQ(map.GetSolidityGrid().GetSolidCount(), 0);
+    map.SetTile(65, 2, Tile(TileType::TREE));
+    ASSERT_TRUE(map.IsSolid(65, 2));
+    int firstSolid = -1;
+    ASSERT_TRUE(map.GetSolidityGrid().FirstSolidInRow(2, 0, 69, firstSolid));
+    ASSERT_EQ(firstSolid, 65);
+    ASSERT_TRUE(map.ChopTree(65, 2));
+    ASSERT_FALSE(map.IsSolid(65, 2));
+    map.SetTile(65, 2, Tile(TileType::WATER));
+    ASSERT_TRUE(map.IsSolid(65, 2));
+    map.Reset(70, 10);
+    ASSERT_FALSE(map.IsSolid(65, 2));
+}
+
+TEST(test_move_free_space) {
+    Map map(10, 10);
+    float x = 40.0f, y = 40.0f;
+    CollisionResult result = map.MoveAndCollide(x, y, 28.0f, 28.0f, 10.5f, -3.0f);
+    ASSERT_FALSE(result.hitX);
+    ASSERT_FALSE(result.hitY);
+    ASSERT_TRUE(x == 50.5f && y == 37.0f);
+}
+
+TEST(test_move_does_not_tunnel) {
+    Map map(40, 3);
+    map.SetTile(20, 1, Tile(TileType::WALL));
+    // Far more than a tile in one step: still stops at the wall
+    float x = 32.0f, y = 32.0f;
+    CollisionResult result = map.MoveAndCollide(x, y, 32.0f, 32.0f, 5000.0f, 0.0f);
+    ASSERT_TRUE(result.hitX);
+    ASSERT_TRUE(x == 19 * 32.0f);
+
+    x = 30 * 32.0f;
+    result = map.MoveAndCollide(x, y, 32.0f, 32.0f, -5000.0f, 0.0f);
+    ASSERT_TRUE(result.hitX);
+    ASSERT_TRUE(x == 21 * 32.0f);
+}
+
+TEST(test_move_stops_at_map_edge) {
+    Map map(5, 5);
+    float x = 32.0f, y = 32.0f;
+    CollisionResult result = map.MoveAndCollide(x, y, 30.0f, 30.0f, -100.0f, 1000.0f);
+    ASSERT_TRUE(result.hitX && result.hitY);
+    ASSERT_TRUE(x == 0.0f);
+    ASSERT_TRUE(y == 5 * 32.0f - 30.0f);
+}
+
+TEST(test_move_slides_along_wall) {
+    Map map(10, 10);
+    for (int x = 0; x < 10; ++x) map.SetTile(x, 5, Tile(TileType::WALL));
+    float x = 64.0f, y = 4 * 32.0f;
+    CollisionResult result = map.MoveAndCollide(x, y, 32.0f, 32.0f, 50.0f, 50.0f);
+    ASSERT_FALSE(result.hitX);
+    ASSERT_TRUE(result.hitY);
+    ASSERT_TRUE(x == 114.0f);
+    ASSERT_TRUE(y == 4 * 32.0f);
+}
+
+// ---- Line of sight tests ----
+
+TEST(test_line_of_sight_open) {
+    Map map(20, 20);
+    ASSERT_TRUE(map.HasLineOfSight(16.0f, 16.0f, 600.0f, 400.0f));
+    ASSERT_TRUE(map.HasLineOfSight(100.0f, 100.0f, 100.0f, 100.0f));
+    ASSERT_TRUE(map.HasLineOfSight(40.0f, 300.0f, 40.0f, 20.0f));   // Straight up
+}
+
+TEST(test_line_of_sight_blocked_by_wall) {
+    Map map(20, 20);
+    for (int y = 0; y < 20; ++y) map.SetTile(10, y, Tile(TileType::WALL));
+    ASSERT_FALSE(map.HasLineOfSight(48.0f, 48.0f, 600.0f, 48.0f));
+    ASSERT_FALSE(map.HasLineOfSight(600.0f, 500.0f, 48.0f, 48.0f));
+    ASSERT_TRUE(map.HasLineOfSight(48.0f, 48.0f, 300.0f, 600.0f));  // Stays left of the wall
+    ASSERT_FALSE(map.HasLineOfSight(48.0f, 48.0f, 330.0f, 48.0f));  // Ends inside the wall
+    ASSERT_FALSE(map.HasLineOfSight(48.0f, 48.0f, 48.0f, 900.0f));  // Leaves the map
+}
+
+TEST(test_line_of_sight_diagonal_gap) {
+    // Two walls touching only at a corner; a ray through that corner is blocked
+    Map map(10, 10);
+    map.SetTile(5, 4, Tile(TileType::WALL));
+    map.SetTile(4, 5, Tile(TileType::WALL));
+    ASSERT_FALSE(map.HasLineOfSight(4 * 32.0f + 16.0f, 4 * 32.0f + 16.0f, 5 * 32.0f + 16.0f, 5 * 32.0f + 16.0f));
+    ASSERT_FALSE(map.HasLineOfSight(64.0f, 64.0f, 256.0f, 256.0f));
+    ASSERT_TRUE(map.HasLineOfSight(64.0f, 64.0f, 120.0f, 250.0f));
+}
+
+TEST(test_line_of_sight_batch) {
+    Map map(30, 30);
+    for (int y = 0; y < 30; ++y) map.SetTile(15, y, Tile(TileType::WALL));
+    const float targetX = 5 * 32.0f, targetY = 5 * 32.0f;
+    const float fromX[4] = { 8 * 32.0f, 20 * 32.0f, 5 * 32.0f, 14 * 32.0f };
+    const float fromY[4] = { 8 * 32.0f, 5 * 32.0f, 28 * 32.0f, 5 * 32.0f };
+    std::uint8_t visible[4] = { 9, 9, 9, 9 };
+    int count = map.HasLineOfSight(targetX, targetY, 400.0f, fromX, fromY, 4, visible);
+    ASSERT_EQ(count, 2);
+    ASSERT_EQ(visible[0], 1);   // Clear
+    ASSERT_EQ(visible[1], 0);   // Behind the wall
+    ASSERT_EQ(visible[2], 0);   // Clear, but out of range
+    ASSERT_EQ(visible[3], 1);
+    for (int i = 0; i < 4; ++i) {
+        bool inRange = (fromX[i] - targetX) * (fromX[i] - targetX) + (fromY[i] - targetY) * (fromY[i] - targetY) <= 400.0f * 400.0f;
+        ASSERT_EQ(visible[i] != 0, inRange && map.HasLineOfSight(fromX[i], fromY[i], targetX, targetY));
+    }
+}
+
+// ---- Render culling tests ----
+
+TEST(test_visible_tile_range_follows_camera) {
+    Map map(1000, 1000);
+    Renderer renderer;
+    renderer.Initialize(800, 600);
+    int x0, y0, x1, y1;
+    ASSERT_TRUE(map.GetVisibleTileRange(renderer, x0, y0, x1, y1));
+    ASSERT_EQ(x0, 0);
+    ASSERT_EQ(y0, 0);
+    ASSERT_EQ(x1, 24);      // 800 / 32 - 1
+    ASSERT_EQ(y1, 18);      // 600 / 32 rounded up, minus 1
+
+    renderer.SetCamera(1000, 2010);
+    ASSERT_TRUE(map.GetVisibleTileRange(renderer, x0, y0, x1, y1));
+    ASSERT_EQ(x0, 31);
+    ASSERT_EQ(y0, 62);
+    ASSERT_EQ(x1, 56);
+    ASSERT_EQ(y1, 81);
+    // Same count on any map size: it depends on the screen only
+    ASSERT_TRUE((x1 - x0 + 1) * (y1 - y0 + 1) <= 26 * 20);
+}
+
+TEST(test_visible_tile_range_clamped) {
+    Map map(20, 10);
+    Renderer renderer;
+    renderer.Initialize(800, 600);
+    int x0, y0, x1, y1;
+    renderer.SetCamera(-100, -100);
+    ASSERT_TRUE(map.GetVisibleTileRange(renderer, x0, y0, x1, y1));
+    ASSERT_EQ(x0, 0);
+    ASSERT_EQ(y0, 0);
+    ASSERT_EQ(x1, 19);
+    ASSERT_EQ(y1, 9);
+
+    renderer.SetCamera(5000, 0);     // Looking past the right edge
+    ASSERT_FALSE(map.GetVisibleTileRange(renderer, x0, y0, x1, y1));
+
+    Renderer unsized;
+    ASSERT_FALSE(map.GetVisibleTileRange(unsized, x0, y0, x1, y1));
+}
+
+TEST(test_renderer_is_visible) {
+    Renderer renderer;
+    renderer.Initialize(800, 600);
+    renderer.SetCamera(100, 100);
+    ASSERT_TRUE(renderer.IsVisible(120.0f, 120.0f, 10.0f, 10.0f));
+    ASSERT_TRUE(renderer.IsVisible(80.0f, 80.0f, 32.0f, 32.0f));    // Straddles the corner
+    ASSERT_FALSE(renderer.IsVisible(60.0f, 60.0f, 40.0f, 40.0f));   // Ends exactly at the edge
+    ASSERT_FALSE(renderer.IsVisible(900.0f, 200.0f, 32.0f, 32.0f));
+}
+
+TEST(test_chunk_revision_tracks_tile_writes) {
+    Map map(100, 100);
+    ASSERT_EQ(map.GetChunkRevision(0, 0), 0u);
+    map.SetTile(5, 5, Tile(TileType::WALL));
+    map.SetTile(6, 5, Tile(TileType::WATER));
+    ASSERT_EQ(map.GetChunkRevision(0, 0), 2u);
+    ASSERT_EQ(map.GetChunkRevision(1, 0), 0u);     // Only the chunk that was written moves on
+
+    // Farm state that leaves the tile itself alone does not stale the bake
+    map.SetTile(40, 40, Tile(TileType::SOIL));
+    std::uint32_t revision = map.GetChunkRevision(1, 1);
+    map.TillSoil(41, 41);
+    std::uint32_t tilled = map.GetChunkRevision(1, 1);
+    ASSERT_TRUE(tilled != revision);
+    map.WaterTile(41, 41);
+    ASSERT_EQ(map.GetChunkRevision(1, 1), tilled);
+
+    // Direct chunk writes are announced through RefreshChunkSolidity
+    map.RefreshChunkSolidity(2, 2);
+    ASSERT_EQ(map.GetChunkRevision(2, 2), 1u);
+    ASSERT_EQ(map.GetChunkRevision(9, 9), 0u);     // Off the map
+
+    map.Reset(40, 40);
+    ASSERT_EQ(map.GetChunkRevision(0, 0), 0u);
+}
+
+static Color PixelAt(const Image& image, int x, int y) {
+    const unsigned char* p = static_cast<const unsigned char*>(image.data) + (y * image.width + x) * 4;
+    return Color{ p[0], p[1], p[2], p[3] };
+}
+
+TEST(test_fallback_tileset_follows_default_layout) {
+    Image sheet = Map::GenerateFallbackTileset();
+    ASSERT_TRUE(sheet.data != nullptr);
+    ASSERT_EQ(sheet.width, Map::FALLBACK_SHEET_COLUMNS * Map::TILE_SIZE);
+    ASSERT_EQ(sheet.height, Map::FALLBACK_SHEET_ROWS * Map::TILE_SIZE);
+
+    // Sprite 0 is grass (VOID shares it), 7 the first wall, 20 the door
+    ASSERT_EQ(PixelAt(sheet, 16, 16).g, 100);
+    ASSERT_EQ(PixelAt(sheet, 0, 0).g, 50);                      // Outline at half brightness
+    ASSERT_EQ(PixelAt(sheet, 7 * 32 + 16, 16).b, 70);
+    ASSERT_EQ(PixelAt(sheet, 4 * 32 + 16, 32 + 16).r, 100);     // Sprite 20
+    // Tree (sprite 50) has its trunk drawn in
+    Color trunk = PixelAt(sheet, 2 * 32 + 16, 3 * 32 + 28);
+    ASSERT_EQ(trunk.r, 100);
+    ASSERT_EQ(trunk.g, 60);
+    // Unused slots stay transparent
+    ASSERT_EQ(PixelAt(sheet, 63 * 32 % 512 + 16, 3 * 32 + 16).a, 0);
+    UnloadImage(sheet);
+}
+
+TEST(test_render_without_window_bakes_nothing) {
+    Map map(100, 100);
+    map.SetTile(3, 3, Tile(TileType::WATER));
+    Renderer renderer;
+    renderer.Initialize(800, 600);
+    map.Render(&renderer);
+    ASSERT_EQ(map.GetBakedChunkCount(), 0);
+    ASSERT_EQ(map.GetChunkBakeCount(), 0);
+}
+
 // ---- Coordinate conversion tests ----
 
 TEST(test_world_to_tile) {
@@ -129,7 +403,7 @@ TEST(test_till_soil_on_grass) {
     ASSERT_TRUE(map.TillSoil(2, 2));
     const Tile* tile = map.GetTileAt(2, 2);
     ASSERT_EQ(tile->GetType(), TileType::SOIL);
-    ASSERT_EQ(tile->GetSoilState(), SoilState::HOE);
+    ASSERT_EQ(map.GetSoilState(2, 2), SoilState::HOE);
 }
 
 TEST(test_till_soil_on_wall_fails) {
@@ -143,8 +417,7 @@ TEST(test_water_tile) {
     Map map(5, 5);
     map.TillSoil(2, 2);
     ASSERT_TRUE(map.WaterTile(2, 2));
-    const Tile* tile = map.GetTileAt(2, 2);
-    ASSERT_EQ(tile->GetSoilState(), SoilState::WATERED);
+    ASSERT_EQ(map.GetSoilState(2, 2), SoilState::WATERED);
 }
 
 TEST(test_water_tile_on_grass_fails) {
@@ -156,10 +429,11 @@ TEST(test_plant_crop) {
     Map map(5, 5);
     map.TillSoil(2, 2);
     ASSERT_TRUE(map.PlantCrop(2, 2, 0)); // Crop type 0
-    const Tile* tile = map.GetTileAt(2, 2);
-    ASSERT_EQ(tile->GetSoilState(), SoilState::CROP);
-    ASSERT_EQ(tile->GetCropType(), 0);
-    ASSERT_EQ(tile->GetGrowthStage(), 0);
+    const FarmPlot* plot = map.GetFarmPlot(2, 2);
+    ASSERT_TRUE(plot != nullptr);
+    ASSERT_EQ(plot->GetSoilState(), SoilState::CROP);
+    ASSERT_EQ(plot->GetCropType(), 0);
+    ASSERT_EQ(plot->GetGrowthStage(), 0);
 }
 
 TEST(test_plant_crop_on_watered_soil) {
@@ -167,9 +441,9 @@ TEST(test_plant_crop_on_watered_soil) {
     map.TillSoil(2, 2);
     map.WaterTile(2, 2);
     ASSERT_TRUE(map.PlantCrop(2, 2, 1));
-    const Tile* tile = map.GetTileAt(2, 2);
-    ASSERT_EQ(tile->GetSoilState(), SoilState::CROP);
-    ASSERT_EQ(tile->GetCropType(), 1);
+    const FarmPlot* plot = map.GetFarmPlot(2, 2);
+    ASSERT_EQ(plot->GetSoilState(), SoilState::CROP);
+    ASSERT_EQ(plot->GetCropType(), 1);
 }
 
 TEST(test_plant_crop_on_grass_fails) {
@@ -182,13 +456,13 @@ TEST(test_harvest_crop) {
     map.TillSoil(2, 2);
     map.PlantCrop(2, 2, 0);
     // Manually set to harvest state
-    Tile* tile = map.GetTileAt(2, 2);
-    tile->SetSoilState(SoilState::HARVEST);
+    FarmPlot* plot = map.GetFarmPlot(2, 2);
+    plot->SetSoilState(SoilState::HARVEST);
     ASSERT_TRUE(map.HarvestCrop(2, 2));
     // After harvest, tile should be back to tilled soil
-    ASSERT_EQ(tile->GetSoilState(), SoilState::HOE);
-    ASSERT_EQ(tile->GetCropType(), -1);
-    ASSERT_EQ(tile->GetGrowthStage(), 0);
+    ASSERT_EQ(plot->GetSoilState(), SoilState::HOE);
+    ASSERT_EQ(plot->GetCropType(), -1);
+    ASSERT_EQ(plot->GetGrowthStage(), 0);
 }
 
 TEST(test_harvest_crop_not_ready_fails) {
@@ -224,25 +498,164 @@ TEST(test_can_plant_crop) {
     ASSERT_TRUE(map.CanPlantCrop(0, 0));
 }
 
+TEST(test_farm_state_is_sparse) {
+    Map map(64, 64);
+    ASSERT_EQ(map.GetFarmPlotCount(), 0);
+    ASSERT_TRUE(map.GetFarmPlot(3, 3) == nullptr);
+    ASSERT_EQ(map.GetSoilState(3, 3), SoilState::GRASS);
+    map.TillSoil(3, 3);
+    ASSERT_EQ(map.GetFarmPlotCount(), 1);
+}
+
+TEST(test_set_tile_clears_farm_state) {
+    Map map(5, 5);
+    map.TillSoil(2, 2);
+    map.PlantCrop(2, 2, 0);
+    map.SetTile(2, 2, Tile(TileType::GRASS));
+    ASSERT_TRUE(map.GetFarmPlot(2, 2) == nullptr);
+    ASSERT_EQ(map.GetFarmPlotCount(), 0);
+}
+
+TEST(test_growing_set_tracks_crops) {
+    Map map(64, 64);
+    map.TillSoil(1, 1);
+    map.TillSoil(2, 1);
+    ASSERT_EQ(map.GetGrowingTileCount(), 0);
+    map.PlantCrop(1, 1, 0);
+    map.PlantCrop(2, 1, 0);
+    ASSERT_EQ(map.GetGrowingTileCount(), 2);
+
+    // Growing to harvest removes the tile from the active set
+    for (int i = 0; i < FarmPlot::MAX_GROWTH_STAGE; ++i) {
+        map.Update(FarmPlot::GROWTH_INTERVAL);
+    }
+    ASSERT_EQ(map.GetSoilState(1, 1), SoilState::HARVEST);
+    ASSERT_EQ(map.GetGrowingTileCount(), 0);
+
+    // Replanting after harvest registers again
+    ASSERT_TRUE(map.HarvestCrop(1, 1));
+    ASSERT_TRUE(map.PlantCrop(1, 1, 0));
+    ASSERT_EQ(map.GetGrowingTileCount(), 1);
+}
+
+TEST(test_growing_set_drops_replaced_tiles) {
+    Map map(5, 5);
+    map.TillSoil(2, 2);
+    map.PlantCrop(2, 2, 0);
+    map.SetTile(2, 2, Tile(TileType::STONE));
+    ASSERT_EQ(map.GetGrowingTileCount(), 0);
+}
+
+TEST(test_tile_events_fire_and_supersede) {
+    Map map(8, 8);
+    map.TillSoil(3, 3);
+    map.WaterTile(3, 3);
+    ASSERT_TRUE(map.ScheduleTileEvent(3, 3, TileEventType::SOIL_DRYING, 2.0f));
+    ASSERT_FALSE(map.ScheduleTileEvent(-1, 3, TileEventType::SOIL_DRYING, 2.0f));
+
+    // Rescheduling replaces the pending event instead of adding a second one
+    ASSERT_TRUE(map.ScheduleTileEvent(3, 3, TileEventType::SOIL_DRYING, 4.0f));
+    ASSERT_EQ(map.GetPendingEventCount(), 1);
+    map.Update(2.0f);
+    ASSERT_EQ(map.GetSoilState(3, 3), SoilState::WATERED);
+    map.Update(2.0f);
+    ASSERT_EQ(map.GetSoilState(3, 3), SoilState::HOE);
+    ASSERT_EQ(map.GetPendingEventCount(), 0);
+
+    // Replacing the tile cancels its events
+    map.SetTile(5, 5, Tile(TileType::GRASS));
+    map.ScheduleTileEvent(5, 5, TileEventType::TREE_REGROWTH, 1.0f);
+    map.SetTile(5, 5, Tile(TileType::GRASS));
+    map.Update(2.0f);
+    ASSERT_EQ(map.GetTileAt(5, 5)->GetType(), TileType::GRASS);
+}
+
+// ---- Overnight growth ----
+
+TEST(test_advance_day_uses_crop_growth_days) {
+    Map map(8, 8);
+    map.TillSoil(1, 1);
+    map.TillSoil(2, 1);
+    map.PlantCrop(1, 1, static_cast<int>(CropType::PARSNIP));  // 4 days
+    map.PlantCrop(2, 1, static_cast<int>(CropType::POTATO));   // 6 days
+
+    for (int day = 1; day <= 4; ++day) {
+        map.AdvanceDay();
+    }
+    ASSERT_EQ(map.GetSoilState(1, 1), SoilState::HARVEST);
+    ASSERT_EQ(map.GetSoilState(2, 1), SoilState::CROP);
+    ASSERT_EQ(map.GetFarmPlot(2, 1)->GetGrowthStage(), 4);
+    ASSERT_EQ(map.GetGrowingTileCount(), 1);
+
+    for (int day = 5; day <= 6; ++day) {
+        map.AdvanceDay();
+    }
+    ASSERT_EQ(map.GetSoilState(2, 1), SoilState::HARVEST);
+    ASSERT_EQ(map.GetGrowingTileCount(), 0);
+}
+
+TEST(test_advance_day_each_call_is_a_night) {
+    Map map(8, 8);
+    map.TillSoil(1, 1);
+    map.PlantCrop(1, 1, 0);
+    map.AdvanceDay();
+    map.AdvanceDay();
+    ASSERT_EQ(map.GetFarmPlot(1, 1)->GetGrowthStage(), 2);
+}
+
+TEST(test_advance_day_large_farm) {
+    // Enough crops to take the multi-threaded path
+    Map map(160, 160);
+    int planted = 0;
+    for (int y = 0; y < 160; ++y) {
+        for (int x = 0; x < 160; x += 2) {
+            map.TillSoil(x, y);
+            map.PlantCrop(x, y, (x / 2 + y) % 3);
+            planted++;
+        }
+    }
+    ASSERT_EQ(map.GetGrowingTileCount(), planted);
+
+    map.AdvanceDay();
+    for (int y = 0; y < 160; ++y) {
+        for (int x = 0; x < 160; x += 2) {
+            ASSERT_EQ(map.GetFarmPlot(x, y)->GetGrowthStage(), 1);
+        }
+    }
+
+    // After 4 nights only the parsnips are ripe
+    for (int day = 2; day <= 4; ++day) {
+        map.AdvanceDay();
+    }
+    int ripe = 0;
+    for (int y = 0; y < 160; ++y) {
+        for (int x = 0; x < 160; x += 2) {
+            bool parsnip = (x / 2 + y) % 3 == 0;
+            ASSERT_EQ(map.GetSoilState(x, y) == SoilState::HARVEST, parsnip);
+            if (parsnip) ripe++;
+        }
+    }
+    ASSERT_EQ(map.GetGrowingTileCount(), planted - ripe);
+}
+
 // ---- Full farming cycle ----
 
 TEST(test_full_farming_cycle) {
     Map map(5, 5);
     // 1. Till grass → soil
     ASSERT_TRUE(map.TillSoil(2, 2));
-    ASSERT_EQ(map.GetTileAt(2, 2)->GetSoilState(), SoilState::HOE);
+    ASSERT_EQ(map.GetSoilState(2, 2), SoilState::HOE);
     // 2. Water soil
     ASSERT_TRUE(map.WaterTile(2, 2));
-    ASSERT_EQ(map.GetTileAt(2, 2)->GetSoilState(), SoilState::WATERED);
+    ASSERT_EQ(map.GetSoilState(2, 2), SoilState::WATERED);
     // 3. Plant crop (planting on watered soil also works)
     ASSERT_TRUE(map.PlantCrop(2, 2, 0));
-    ASSERT_EQ(map.GetTileAt(2, 2)->GetSoilState(), SoilState::CROP);
+    ASSERT_EQ(map.GetSoilState(2, 2), SoilState::CROP);
     // 4. Simulate growth to harvest
-    Tile* tile = map.GetTileAt(2, 2);
-    tile->SetSoilState(SoilState::HARVEST);
+    map.GetFarmPlot(2, 2)->SetSoilState(SoilState::HARVEST);
     // 5. Harvest
     ASSERT_TRUE(map.HarvestCrop(2, 2));
-    ASSERT_EQ(tile->GetSoilState(), SoilState::HOE);
+    ASSERT_EQ(map.GetSoilState(2, 2), SoilState::HOE);
 }
 
 // ---- Save/Load tests ----
@@ -284,8 +697,7 @@ TEST(test_save_and_load_farming_state) {
     Map original(3, 3);
     original.TillSoil(1, 1);
     original.PlantCrop(1, 1, 2);  // Tomato
-    Tile* tile = original.GetTileAt(1, 1);
-    tile->SetGrowthStage(3);
+    original.GetFarmPlot(1, 1)->SetGrowthStage(3);
 
     ASSERT_TRUE(original.SaveToFile("/tmp/test_map_farm.txt"));
 
@@ -295,9 +707,13 @@ TEST(test_save_and_load_farming_state) {
     const Tile* lt = loaded.GetTileAt(1, 1);
     ASSERT_TRUE(lt != nullptr);
     ASSERT_EQ(lt->GetType(), TileType::SOIL);
-    ASSERT_EQ(lt->GetSoilState(), SoilState::CROP);
-    ASSERT_EQ(lt->GetCropType(), 2);
-    ASSERT_EQ(lt->GetGrowthStage(), 3);
+    const FarmPlot* lp = loaded.GetFarmPlot(1, 1);
+    ASSERT_TRUE(lp != nullptr);
+    ASSERT_EQ(lp->GetSoilState(), SoilState::CROP);
+    ASSERT_EQ(lp->GetCropType(), 2);
+    ASSERT_EQ(lp->GetGrowthStage(), 3);
+    // Untouched tiles do not get a plot on load
+    ASSERT_EQ(loaded.GetFarmPlotCount(), 1);
 }
 
 TEST(test_load_nonexistent_file) {
@@ -315,6 +731,32 @@ TEST(test_load_invalid_header) {
     ASSERT_FALSE(map.LoadFromFile("/tmp/test_map_bad_header.txt"));
 }
 
+TEST(test_load_skips_invalid_tile_lines) {
+    {
+        std::ofstream f("/tmp/test_map_bad_tiles.txt");
+        f << "HARVEST_QUEST_MAP\nSIZE 4 4\n"
+          << "TILE 0 0 2 0\n"           // Wall
+          << "TILE 1 0 " << TILE_TYPE_COUNT << " 0\n"  // Just past the last type
+          << "TILE 2 0 31 0\n"
+          << "TILE 3 0 -1 0\n"
+          << "TILE 0 1 5 0 9\n"         // Soil with a soil state past HARVEST
+          << "TILE 1 1 5 0 1\n"         // Hoed soil
+          << "END\n";
+    }
+    Map map;
+    ASSERT_TRUE(map.LoadFromFile("/tmp/test_map_bad_tiles.txt"));
+    ASSERT_EQ(map.GetTileAt(0, 0)->GetType(), TileType::WALL);
+    ASSERT_EQ(map.GetTileAt(1, 0)->GetType(), TileType::GRASS);
+    ASSERT_EQ(map.GetTileAt(2, 0)->GetType(), TileType::GRASS);
+    ASSERT_EQ(map.GetTileAt(3, 0)->GetType(), TileType::GRASS);
+    ASSERT_EQ(map.GetTileAt(0, 1)->GetType(), TileType::GRASS);
+    ASSERT_TRUE(map.GetFarmPlot(0, 1) == nullptr);
+    ASSERT_EQ(map.GetTileAt(1, 1)->GetType(), TileType::SOIL);
+    ASSERT_TRUE(map.GetFarmPlot(1, 1) != nullptr);
+    ASSERT_TRUE(map.GetFarmPlot(1, 1)->GetSoilState() == SoilState::HOE);
+    ASSERT_FALSE(map.IsSolid(1, 0));
+}
+
 int main() {
     TileRegistry::Initialize();
     std::cout << "=== Map Tests ===" << std::endl;
@@ -324,9 +766,29 @@ int main() {
     RUN_TEST(test_get_tile_at_valid);
     RUN_TEST(test_get_tile_at_invalid);
     RUN_TEST(test_set_tile);
+    RUN_TEST(test_large_map_untouched_costs_nothing);
+    RUN_TEST(test_set_tile_allocates_single_chunk);
+    RUN_TEST(test_tiles_across_chunk_boundary);
+    RUN_TEST(test_partial_edge_chunk);
     RUN_TEST(test_is_solid_wall);
     RUN_TEST(test_is_solid_grass);
     RUN_TEST(test_is_solid_out_of_bounds);
+    RUN_TEST(test_area_solid_covers_whole_box);
+    RUN_TEST(test_solidity_follows_tile_changes);
+    RUN_TEST(test_move_free_space);
+    RUN_TEST(test_move_does_not_tunnel);
+    RUN_TEST(test_move_stops_at_map_edge);
+    RUN_TEST(test_move_slides_along_wall);
+    RUN_TEST(test_line_of_sight_open);
+    RUN_TEST(test_line_of_sight_blocked_by_wall);
+    RUN_TEST(test_line_of_sight_diagonal_gap);
+    RUN_TEST(test_line_of_sight_batch);
+    RUN_TEST(test_visible_tile_range_follows_camera);
+    RUN_TEST(test_visible_tile_range_clamped);
+    RUN_TEST(test_renderer_is_visible);
+    RUN_TEST(test_chunk_revision_tracks_tile_writes);
+    RUN_TEST(test_fallback_tileset_follows_default_layout);
+    RUN_TEST(test_render_without_window_bakes_nothing);
     RUN_TEST(test_world_to_tile);
     RUN_TEST(test_tile_to_world);
     RUN_TEST(test_world_to_tile_origin);
@@ -342,11 +804,20 @@ int main() {
     RUN_TEST(test_chop_tree);
     RUN_TEST(test_chop_tree_on_grass_fails);
     RUN_TEST(test_can_plant_crop);
+    RUN_TEST(test_farm_state_is_sparse);
+    RUN_TEST(test_set_tile_clears_farm_state);
+    RUN_TEST(test_growing_set_tracks_crops);
+    RUN_TEST(test_growing_set_drops_replaced_tiles);
+    RUN_TEST(test_tile_events_fire_and_supersede);
+    RUN_TEST(test_advance_day_uses_crop_growth_days);
+    RUN_TEST(test_advance_day_each_call_is_a_night);
+    RUN_TEST(test_advance_day_large_farm);
     RUN_TEST(test_full_farming_cycle);
     RUN_TEST(test_save_and_load_roundtrip);
     RUN_TEST(test_save_and_load_farming_state);
     RUN_TEST(test_load_nonexistent_file);
     RUN_TEST(test_load_invalid_header);
+    RUN_TEST(test_load_skips_invalid_tile_lines);
 
     std::cout << std::endl << s_passed << " passed, " << s_failed << " failed" << std::endl;
     return s_failed > 0 ? 1 : 0;
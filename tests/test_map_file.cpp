@@ -0,0 +1,361 @@
+// Harvest Quest — Binary map format (.hqmap) and delta save (.hqdelta) unit tests
+
+#include "world/MapFile.h"
+#include "world/Map.h"
+#include "world/Tile.h"
+#include "world/WorldGenerator.h"
+#include <cassert>
+#include <cstddef>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+
+static int s_passed = 0;
+static int s_failed = 0;
+
+#define TEST(name) static void name()
+#define RUN_TEST(name) do { \
+    std::cout << "  " #name "... "; \
+    try { name(); std::cout << "PASS" << std::endl; s_passed++; } \
+    catch (...) { std::cout << "FAIL" << std::endl; s_failed++; } \
+} while(0)
+#define ASSERT_TRUE(expr)  do { if (!(expr)) throw 1; } while(0)
+#define ASSERT_FALSE(expr) do { if (expr) throw 1; } while(0)
+#define ASSERT_EQ(a, b)    do { if ((a) != (b)) throw 1; } while(0)
+
+static void BuildSampleMap(Map& map) {
+    for (int x = 0; x < map.GetWidth(); ++x) {
+        map.SetTile(x, 0, Tile(TileType::WALL, x % 16));
+    }
+    map.SetTile(40, 40, Tile(TileType::WATER));
+    map.SetTile(70, 5, Tile(TileType::STONE, 3));
+    map.TillSoil(2, 2);
+    map.TillSoil(3, 2);
+    map.WaterTile(3, 2);
+    map.TillSoil(4, 2);
+    map.PlantCrop(4, 2, 1);
+}
+
+TEST(test_binary_roundtrip) {
+    Map original(80, 50);
+    BuildSampleMap(original);
+    ASSERT_TRUE(original.SaveToFile("/tmp/test_map_file.hqmap"));
+    ASSERT_TRUE(MapFile::IsBinaryFile("/tmp/test_map_file.hqmap"));
+
+    Map loaded;
+    ASSERT_TRUE(loaded.LoadFromFile("/tmp/test_map_file.hqmap"));
+    ASSERT_EQ(loaded.GetWidth(), 80);
+    ASSERT_EQ(loaded.GetHeight(), 50);
+    for (int y = 0; y < 50; ++y) {
+        for (int x = 0; x < 80; ++x) {
+            ASSERT_EQ(loaded.GetTileAt(x, y)->GetType(), original.GetTileAt(x, y)->GetType());
+            ASSERT_EQ(loaded.GetTileAt(x, y)->GetVisualId(), original.GetTileAt(x, y)->GetVisualId());
+            ASSERT_EQ(loaded.IsSolid(x, y), original.IsSolid(x, y));
+        }
+    }
+    ASSERT_EQ(loaded.GetSoilState(2, 2), SoilState::HOE);
+    ASSERT_EQ(loaded.GetSoilState(3, 2), SoilState::WATERED);
+    ASSERT_EQ(loaded.GetSoilState(4, 2), SoilState::CROP);
+    ASSERT_EQ(loaded.GetFarmPlot(4, 2)->GetCropType(), 1);
+    ASSERT_EQ(loaded.GetFarmPlotCount(), original.GetFarmPlotCount());
+    ASSERT_EQ(loaded.GetGrowingTileCount(), 1);
+}
+
+TEST(test_untouched_chunks_stay_unallocated) {
+    Map original(256, 256);
+    original.SetTile(10, 10, Tile(TileType::STONE));
+    ASSERT_TRUE(original.SaveToFile("/tmp/test_map_sparse.hqmap"));
+
+    // One chunk of tile data plus the directory, nowhere near 64K tiles
+    auto size = std::filesystem::file_size("/tmp/test_map_sparse.hqmap");
+    ASSERT_TRUE(size < 4096);
+
+    Map loaded;
+    ASSERT_TRUE(loaded.LoadFromFile("/tmp/test_map_sparse.hqmap"));
+    ASSERT_EQ(loaded.GetAllocatedChunkCount(), 1);
+    ASSERT_EQ(loaded.GetTileAt(10, 10)->GetType(), TileType::STONE);
+    ASSERT_EQ(loaded.GetTileAt(200, 200)->GetType(), TileType::GRASS);
+}
+
+TEST(test_binary_smaller_than_text) {
+    Map map(64, 64);
+    BuildSampleMap(map);
+    for (int y = 0; y < 64; ++y) {
+        for (int x = 0; x < 64; ++x) {
+            if ((x + y) % 5 == 0) map.SetTile(x, y, Tile(TileType::DIRT));
+        }
+    }
+    ASSERT_TRUE(map.SaveToFile("/tmp/test_map_compare.txt"));
+    ASSERT_TRUE(map.SaveToFile("/tmp/test_map_compare.hqmap"));
+    ASSERT_FALSE(MapFile::IsBinaryFile("/tmp/test_map_compare.txt"));
+    ASSERT_TRUE(std::filesystem::file_size("/tmp/test_map_compare.hqmap") * 4 <
+                std::filesystem::file_size("/tmp/test_map_compare.txt"));
+}
+
+TEST(test_text_import_then_binary_export) {
+    Map original(40, 30);
+    BuildSampleMap(original);
+    ASSERT_TRUE(original.SaveToFile("/tmp/test_map_import.txt"));
+
+    Map imported;
+    ASSERT_TRUE(imported.LoadFromFile("/tmp/test_map_import.txt"));
+    ASSERT_TRUE(imported.SaveToFile("/tmp/test_map_import.hqmap"));
+
+    Map loaded;
+    ASSERT_TRUE(loaded.LoadFromFile("/tmp/test_map_import.hqmap"));
+    ASSERT_EQ(loaded.GetTileAt(39, 0)->GetType(), TileType::WALL);
+    ASSERT_EQ(loaded.GetSoilState(3, 2), SoilState::WATERED);
+}
+
+TEST(test_rejects_truncated_file) {
+    Map original(80, 50);
+    BuildSampleMap(original);
+    ASSERT_TRUE(original.SaveToFile("/tmp/test_map_trunc.hqmap"));
+    auto size = std::filesystem::file_size("/tmp/test_map_trunc.hqmap");
+    std::filesystem::resize_file("/tmp/test_map_trunc.hqmap", size - 100);
+
+    Map loaded(5, 5);
+    ASSERT_FALSE(loaded.LoadFromFile("/tmp/test_map_trunc.hqmap"));
+    ASSERT_EQ(loaded.GetWidth(), 5);   // Left untouched
+}
+
+TEST(test_rejects_unknown_version) {
+    Map original(10, 10);
+    ASSERT_TRUE(original.SaveToFile("/tmp/test_map_version.hqmap"));
+    {
+        std::fstream file("/tmp/test_map_version.hqmap", std::ios::in | std::ios::out | std::ios::binary);
+        std::uint32_t version = MapFile::VERSION + 1;
+        file.seekp(4);
+        file.write(reinterpret_cast<const char*>(&version), sizeof(version));
+    }
+    Map loaded;
+    ASSERT_FALSE(loaded.LoadFromFile("/tmp/test_map_version.hqmap"));
+}
+
+// Overwrites one byte of a saved file
+static void PokeByte(const char* path, std::uint64_t offset, std::uint8_t value) {
+    std::fstream file(path, std::ios::in | std::ios::out | std::ios::binary);
+    file.seekp(static_cast<std::streamoff>(offset));
+    file.write(reinterpret_cast<const char*>(&value), 1);
+}
+
+TEST(test_rejects_corrupt_enum_bytes) {
+    Map original(10, 10);
+    original.SetTile(3, 3, Tile(TileType::STONE));
+    original.TillSoil(5, 5);
+    const char* path = "/tmp/test_map_corrupt.hqmap";
+    ASSERT_TRUE(original.SaveToFile(path));
+
+    MapFileHeader header;
+    std::uint64_t chunkOffset = 0;
+    {
+        std::ifstream file(path, std::ios::binary);
+        file.read(reinterpret_cast<char*>(&header), sizeof(header));
+        file.read(reinterpret_cast<char*>(&chunkOffset), sizeof(chunkOffset));
+    }
+    ASSERT_TRUE(chunkOffset != 0);
+
+    // A tile type byte past the enum (and past TileRegistry's table)
+    std::uint64_t tileByte = chunkOffset + (3 * Map::CHUNK_SIZE + 3) * sizeof(Tile);
+    PokeByte(path, tileByte, 200);
+    Map loaded(5, 5);
+    ASSERT_FALSE(loaded.LoadFromFile(path));
+    ASSERT_EQ(loaded.GetWidth(), 5);   // Left untouched
+    PokeByte(path, tileByte, TILE_TYPE_COUNT);   // Just past the last type
+    ASSERT_FALSE(loaded.LoadFromFile(path));
+    PokeByte(path, tileByte, static_cast<std::uint8_t>(TileType::STONE));
+    ASSERT_TRUE(loaded.LoadFromFile(path));
+
+    PokeByte(path, offsetof(MapFileHeader, fillType), 99);
+    ASSERT_FALSE(loaded.LoadFromFile(path));
+    PokeByte(path, offsetof(MapFileHeader, fillType), header.fillType);
+
+    PokeByte(path, header.plotOffset + offsetof(MapFilePlot, soilState), 42);
+    ASSERT_FALSE(loaded.LoadFromFile(path));
+}
+
+// First tile of the given type in row-major order
+static bool FindTile(const Map& map, TileType type, int& outX, int& outY) {
+    for (int y = 0; y < map.GetHeight(); ++y) {
+        for (int x = 0; x < map.GetWidth(); ++x) {
+            if (map.GetTileAt(x, y)->GetType() == type) {
+                outX = x;
+                outY = y;
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+TEST(test_generator_records_origin) {
+    Map map;
+    WorldGenerator generator(777);
+    generator.GenerateOverworld(&map, 60, 40, Biome::FOREST);
+    ASSERT_TRUE(map.HasOrigin());
+    ASSERT_EQ(map.GetOrigin().kind, MapOrigin::Kind::OVERWORLD);
+    ASSERT_EQ(map.GetOrigin().seed, 777u);
+    ASSERT_EQ(map.GetOrigin().width, 60);
+    ASSERT_EQ(map.GetOrigin().biome, static_cast<std::uint8_t>(Biome::FOREST));
+    ASSERT_EQ(map.GetChangedTileCount(), 0);
+
+    // Reusing a generator gives the same map again
+    Map again;
+    generator.GenerateOverworld(&again, 60, 40, Biome::FOREST);
+    for (int y = 0; y < 40; ++y) {
+        for (int x = 0; x < 60; ++x) {
+            ASSERT_EQ(again.GetTileAt(x, y)->GetType(), map.GetTileAt(x, y)->GetType());
+            ASSERT_EQ(again.GetTileAt(x, y)->GetVisualId(), map.GetTileAt(x, y)->GetVisualId());
+        }
+    }
+}
+
+TEST(test_mutators_feed_journal) {
+    Map map;
+    WorldGenerator generator(4242);
+    generator.GenerateFarm(&map, 50, 40);
+    int grassX, grassY, treeX, treeY;
+    ASSERT_TRUE(FindTile(map, TileType::GRASS, grassX, grassY));
+    ASSERT_TRUE(FindTile(map, TileType::TREE, treeX, treeY));
+
+    ASSERT_TRUE(map.TillSoil(grassX, grassY));
+    ASSERT_TRUE(map.ChopTree(treeX, treeY));
+    map.SetTile(49, 39, Tile(TileType::STONE));
+    map.SetTile(49, 39, Tile(TileType::DIRT));   // Same tile twice is one entry
+    ASSERT_EQ(map.GetChangedTileCount(), 3);
+    ASSERT_EQ(map.GetChangedTiles().count(map.GetIndex(treeX, treeY)), 1u);
+
+    // Maps that were never generated keep no journal
+    Map plain(10, 10);
+    plain.SetTile(1, 1, Tile(TileType::WATER));
+    ASSERT_FALSE(plain.HasOrigin());
+    ASSERT_EQ(plain.GetChangedTileCount(), 0);
+    ASSERT_FALSE(MapFile::SaveDelta(plain, "/tmp/test_map_plain.hqdelta"));
+}
+
+TEST(test_delta_roundtrip) {
+    Map original;
+    WorldGenerator generator(9001);
+    generator.GenerateFarm(&original, 64, 48);
+    int grassX, grassY, treeX, treeY;
+    ASSERT_TRUE(FindTile(original, TileType::TREE, treeX, treeY));
+    ASSERT_TRUE(original.ChopTree(treeX, treeY));
+    ASSERT_TRUE(FindTile(original, TileType::GRASS, grassX, grassY));
+    ASSERT_TRUE(original.TillSoil(grassX, grassY));
+    ASSERT_TRUE(original.PlantCrop(grassX, grassY, 2));
+    original.SetTile(63, 47, Tile(TileType::WATER, 5));
+    ASSERT_TRUE(MapFile::SaveDelta(original, "/tmp/test_map_delta.hqdelta"));
+
+    Map loaded(5, 5);
+    ASSERT_TRUE(MapFile::LoadDelta(loaded, "/tmp/test_map_delta.hqdelta"));
+    ASSERT_EQ(loaded.GetWidth(), 64);
+    ASSERT_EQ(loaded.GetHeight(), 48);
+    for (int y = 0; y < 48; ++y) {
+        for (int x = 0; x < 64; ++x) {
+            ASSERT_EQ(loaded.GetTileAt(x, y)->GetType(), original.GetTileAt(x, y)->GetType());
+            ASSERT_EQ(loaded.GetTileAt(x, y)->GetVisualId(), original.GetTileAt(x, y)->GetVisualId());
+        }
+    }
+    ASSERT_EQ(loaded.GetSoilState(grassX, grassY), SoilState::CROP);
+    ASSERT_EQ(loaded.GetFarmPlot(grassX, grassY)->GetCropType(), 2);
+    ASSERT_EQ(loaded.GetGrowingTileCount(), 1);
+
+    // The loaded map can be delta-saved again with the same changes
+    ASSERT_EQ(loaded.GetChangedTileCount(), original.GetChangedTileCount());
+}
+
+TEST(test_delta_size_follows_changes) {
+    Map map;
+    WorldGenerator generator(31337);
+    generator.GenerateOverworld(&map, 512, 512, Biome::PLAINS);
+    ASSERT_TRUE(MapFile::SaveDelta(map, "/tmp/test_map_delta_empty.hqdelta"));
+    ASSERT_EQ(std::filesystem::file_size("/tmp/test_map_delta_empty.hqdelta"), sizeof(MapDeltaHeader));
+
+    for (int i = 0; i < 10; ++i) {
+        map.SetTile(i * 40, i * 40, Tile(TileType::STONE));
+    }
+    ASSERT_TRUE(MapFile::SaveDelta(map, "/tmp/test_map_delta_ten.hqdelta"));
+    ASSERT_EQ(std::filesystem::file_size("/tmp/test_map_delta_ten.hqdelta"),
+              sizeof(MapDeltaHeader) + 10 * sizeof(MapDeltaEntry));
+}
+
+TEST(test_delta_rejects_truncated_file) {
+    Map original;
+    WorldGenerator generator(55);
+    generator.GenerateDungeon(&original, 40, 40);
+    original.SetTile(1, 1, Tile(TileType::FLOOR));
+    original.SetTile(2, 1, Tile(TileType::FLOOR));
+    ASSERT_TRUE(MapFile::SaveDelta(original, "/tmp/test_map_delta_trunc.hqdelta"));
+    auto size = std::filesystem::file_size("/tmp/test_map_delta_trunc.hqdelta");
+    std::filesystem::resize_file("/tmp/test_map_delta_trunc.hqdelta", size - 4);
+
+    Map loaded(5, 5);
+    ASSERT_FALSE(MapFile::LoadDelta(loaded, "/tmp/test_map_delta_trunc.hqdelta"));
+    ASSERT_EQ(loaded.GetWidth(), 5);   // Left untouched
+    ASSERT_FALSE(MapFile::LoadDelta(loaded, "/tmp/test_map_version.hqmap"));
+}
+
+TEST(test_delta_rejects_corrupt_entries) {
+    Map original;
+    WorldGenerator generator(77);
+    generator.GenerateFarm(&original, 32, 32);
+    int grassX, grassY;
+    ASSERT_TRUE(FindTile(original, TileType::GRASS, grassX, grassY));
+    ASSERT_TRUE(original.TillSoil(grassX, grassY));
+    const char* path = "/tmp/test_map_delta_corrupt.hqdelta";
+    ASSERT_TRUE(MapFile::SaveDelta(original, path));
+    ASSERT_EQ(original.GetChangedTileCount(), 1);
+
+    std::uint64_t entry = sizeof(MapDeltaHeader);
+    PokeByte(path, entry + offsetof(MapDeltaEntry, tileType), 40);
+    Map loaded(5, 5);
+    ASSERT_FALSE(MapFile::LoadDelta(loaded, path));
+    ASSERT_EQ(loaded.GetWidth(), 5);   // Left untouched
+    PokeByte(path, entry + offsetof(MapDeltaEntry, tileType), static_cast<std::uint8_t>(TileType::SOIL));
+    ASSERT_TRUE(MapFile::LoadDelta(loaded, path));
+
+    PokeByte(path, entry + offsetof(MapDeltaEntry, soilState), 9);
+    ASSERT_FALSE(MapFile::LoadDelta(loaded, path));
+}
+
+TEST(test_delta_rejects_huge_dimensions) {
+    Map original;
+    WorldGenerator generator(78);
+    generator.GenerateFarm(&original, 32, 32);
+    const char* path = "/tmp/test_map_delta_huge.hqdelta";
+    ASSERT_TRUE(MapFile::SaveDelta(original, path));
+
+    // A header alone must not be able to ask for a gigantic map
+    std::int32_t huge = 1 << 20;
+    {
+        std::fstream file(path, std::ios::in | std::ios::out | std::ios::binary);
+        file.seekp(offsetof(MapDeltaHeader, width));
+        file.write(reinterpret_cast<const char*>(&huge), sizeof(huge));
+    }
+    Map loaded(5, 5);
+    ASSERT_FALSE(MapFile::LoadDelta(loaded, path));
+    ASSERT_EQ(loaded.GetWidth(), 5);
+}
+
+int main() {
+    std::cout << "=== Map File Tests ===" << std::endl;
+    TileRegistry::Initialize();
+    RUN_TEST(test_binary_roundtrip);
+    RUN_TEST(test_untouched_chunks_stay_unallocated);
+    RUN_TEST(test_binary_smaller_than_text);
+    RUN_TEST(test_text_import_then_binary_export);
+    RUN_TEST(test_rejects_truncated_file);
+    RUN_TEST(test_rejects_unknown_version);
+    RUN_TEST(test_rejects_corrupt_enum_bytes);
+    RUN_TEST(test_generator_records_origin);
+    RUN_TEST(test_mutators_feed_journal);
+    RUN_TEST(test_delta_roundtrip);
+    RUN_TEST(test_delta_size_follows_changes);
+    RUN_TEST(test_delta_rejects_truncated_file);
+    RUN_TEST(test_delta_rejects_corrupt_entries);
+    RUN_TEST(test_delta_rejects_huge_dimensions);
+
+    std::cout << std::endl << s_passed << " passed, " << s_failed << " failed" << std::endl;
+    return s_failed > 0 ? 1 : 0;
+}
@@ -3,6 +3,11 @@
 // (NPC logic only; Render stubs provided via engine linking)
 
 #include "entities/NPC.h"
+#include "world/Map.h"
+#include "world/PathGraph.h"
+#include "world/PathService.h"
+#include <chrono>
+#include <thread>
 #include <cassert>
 #include <iostream>
 #include <cmath>
@@ -153,6 +158,54 @@ TEST(test_inactive_npc_doesnt_move) {
     ASSERT_EQ(static_cast<int>(y), 100);
 }
 
+TEST(test_schedule_walk_follows_path_around_wall) {
+    // Wall across the middle with one gap at the far right
+    Map map(40, 40);
+    for (int x = 0; x < 38; ++x) map.SetTile(x, 20, Tile(TileType::WALL));
+    PathGraph graph(&map);
+
+    NPC npc;
+    npc.SetMap(&map);
+    npc.SetPathGraph(&graph);
+    npc.SetPosition(5 * 32.0f, 10 * 32.0f);
+    npc.AddScheduleEntry(8, 5 * 32.0f, 30 * 32.0f);
+    npc.SetCurrentHour(8);
+    ASSERT_FALSE(npc.GetPath().empty());
+
+    for (int i = 0; i < 2000 && npc.IsMoving(); ++i) {
+        npc.Update(0.1f);
+    }
+    float x, y;
+    npc.GetPosition(x, y);
+    ASSERT_FALSE(npc.IsMoving());
+    ASSERT_TRUE(std::fabs(x - 5 * 32.0f) < 1.0f);
+    ASSERT_TRUE(std::fabs(y - 30 * 32.0f) < 1.0f);
+}
+
+TEST(test_schedule_walk_waits_for_path_service) {
+    Map map(40, 40);
+    for (int x = 0; x < 38; ++x) map.SetTile(x, 20, Tile(TileType::WALL));
+    PathService service(&map);
+
+    NPC npc;
+    npc.SetMap(&map);
+    npc.SetPathService(&service);
+    npc.SetPosition(5 * 32.0f, 10 * 32.0f);
+    npc.AddScheduleEntry(8, 5 * 32.0f, 30 * 32.0f);
+    npc.SetCurrentHour(8);
+    ASSERT_TRUE(npc.IsWaitingForPath());
+
+    for (int i = 0; i < 5000 && npc.IsMoving(); ++i) {
+        npc.Update(0.1f);
+        if (npc.IsWaitingForPath()) std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    float x, y;
+    npc.GetPosition(x, y);
+    ASSERT_FALSE(npc.IsMoving());
+    ASSERT_TRUE(std::fabs(x - 5 * 32.0f) < 1.0f);
+    ASSERT_TRUE(std::fabs(y - 30 * 32.0f) < 1.0f);
+}
+
 // ---- Proximity detection ----
 
 TEST(test_player_nearby_true) {
@@ -210,6 +263,8 @@ int main() {
     RUN_TEST(test_schedule_picks_latest_entry);
     RUN_TEST(test_npc_stops_at_destination);
     RUN_TEST(test_inactive_npc_doesnt_move);
+    RUN_TEST(test_schedule_walk_follows_path_around_wall);
+    RUN_TEST(test_schedule_walk_waits_for_path_service);
     RUN_TEST(test_player_nearby_true);
     RUN_TEST(test_player_nearby_false);
     RUN_TEST(test_player_nearby_exact_range);
@@ -0,0 +1,233 @@
+// Harvest Quest — Hierarchical pathfinding unit tests
+
+#include "world/PathGraph.h"
+#include "world/Map.h"
+#include "world/SolidityGrid.h"
+#include <cassert>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+static int s_passed = 0;
+static int s_failed = 0;
+
+#define TEST(name) static void name()
+#define RUN_TEST(name) do { \
+    std::cout << "  " #name "... "; \
+    try { name(); std::cout << "PASS" << std::endl; s_passed++; } \
+    catch (...) { std::cout << "FAIL" << std::endl; s_failed++; } \
+} while(0)
+#define ASSERT_TRUE(expr)  do { if (!(expr)) throw 1; } while(0)
+#define ASSERT_FALSE(expr) do { if (expr) throw 1; } while(0)
+#define ASSERT_EQ(a, b)    do { if ((a) != (b)) throw 1; } while(0)
+
+// Every step moves one tile onto open ground without cutting a corner, and the path ends at the goal
+static bool IsWalkable(const Map& map, int x, int y, const std::vector<PathTile>& path, int goalX, int goalY) {
+    for (const PathTile& step : path) {
+        int dx = step.x - x;
+        int dy = step.y - y;
+        if (std::abs(dx) > 1 || std::abs(dy) > 1 || (dx == 0 && dy == 0)) return false;
+        if (map.IsSolid(step.x, step.y)) return false;
+        if (dx != 0 && dy != 0 && (map.IsSolid(step.x, y) || map.IsSolid(x, step.y))) return false;
+        x = step.x;
+        y = step.y;
+    }
+    return x == goalX && y == goalY;
+}
+
+// Wall across row 20 with a single gap at column gapX
+static void BuildWall(Map& map, int gapX) {
+    for (int x = 0; x < map.GetWidth(); ++x) {
+        map.SetTile(x, 20, Tile(x == gapX ? TileType::GRASS : TileType::WALL));
+    }
+}
+
+TEST(test_straight_path_open_map) {
+    Map map(64, 64);
+    PathGraph graph(&map);
+    std::vector<PathTile> path;
+    ASSERT_TRUE(graph.FindPath(2, 2, 60, 2, path));
+    ASSERT_EQ(path.size(), 58u);
+    ASSERT_TRUE(IsWalkable(map, 2, 2, path, 60, 2));
+    ASSERT_EQ(graph.GetClusterCount(), 16);
+    ASSERT_EQ(graph.GetFullBuilds(), 1);
+}
+
+TEST(test_same_tile_and_blocked_goal) {
+    Map map(32, 32);
+    map.SetTile(10, 10, Tile(TileType::WALL));
+    PathGraph graph(&map);
+    std::vector<PathTile> path;
+    ASSERT_TRUE(graph.FindPath(3, 3, 3, 3, path));
+    ASSERT_TRUE(path.empty());
+    ASSERT_FALSE(graph.FindPath(3, 3, 10, 10, path));
+    ASSERT_FALSE(graph.FindPath(3, 3, 100, 3, path));
+}
+
+TEST(test_routes_through_gap) {
+    Map map(48, 40);
+    BuildWall(map, 40);
+    PathGraph graph(&map);
+    std::vector<PathTile> path;
+    ASSERT_TRUE(graph.FindPath(5, 5, 5, 35, path));
+    ASSERT_TRUE(IsWalkable(map, 5, 5, path, 5, 35));
+    bool usedGap = false;
+    for (const PathTile& step : path) {
+        if (step.x == 40 && step.y == 20) usedGap = true;
+    }
+    ASSERT_TRUE(usedGap);
+}
+
+TEST(test_unreachable_goal) {
+    Map map(48, 40);
+    BuildWall(map, -1);
+    PathGraph graph(&map);
+    std::vector<PathTile> path;
+    ASSERT_FALSE(graph.FindPath(5, 5, 5, 35, path));
+}
+
+TEST(test_set_tile_repairs_locally) {
+    Map map(64, 64);
+    BuildWall(map, 40);
+    PathGraph graph(&map);
+    std::vector<PathTile> path;
+    ASSERT_TRUE(graph.FindPath(5, 5, 5, 35, path));
+    size_t longWay = path.size();
+
+    // Open a gap right below the start; only that cluster and its neighbours are redone
+    map.SetTile(5, 20, Tile(TileType::GRASS));
+    ASSERT_TRUE(graph.FindPath(5, 5, 5, 35, path));
+    ASSERT_TRUE(IsWalkable(map, 5, 5, path, 5, 35));
+    ASSERT_TRUE(path.size() < longWay);
+    ASSERT_EQ(graph.GetFullBuilds(), 1);
+    ASSERT_TRUE(graph.GetRepairedClusters() > 0);
+    ASSERT_TRUE(graph.GetRepairedClusters() <= 5);
+
+    // Closing both gaps cuts the map in two
+    map.SetTile(5, 20, Tile(TileType::WALL));
+    map.SetTile(40, 20, Tile(TileType::WALL));
+    ASSERT_FALSE(graph.FindPath(5, 5, 5, 35, path));
+}
+
+TEST(test_same_cluster_detour) {
+    // Start and goal share a cluster but the wall between them forces a trip outside it
+    Map map(48, 48);
+    for (int y = 0; y < 40; ++y) map.SetTile(8, y, Tile(TileType::WALL));
+    PathGraph graph(&map);
+    std::vector<PathTile> path;
+    ASSERT_TRUE(graph.FindPath(4, 4, 12, 4, path));
+    ASSERT_TRUE(IsWalkable(map, 4, 4, path, 12, 4));
+    ASSERT_TRUE(path.size() > 40);
+}
+
+TEST(test_route_cache_per_cluster_and_destination) {
+    Map map(64, 64);
+    BuildWall(map, 40);
+    PathGraph graph(&map);
+    std::vector<PathTile> path;
+    ASSERT_TRUE(graph.FindPath(5, 5, 50, 50, path));
+    ASSERT_EQ(graph.GetCachedRouteCount(), 1);
+    ASSERT_EQ(graph.GetCacheHits(), 0);
+
+    // Another start in the same cluster reuses the route
+    ASSERT_TRUE(graph.FindPath(9, 3, 50, 50, path));
+    ASSERT_TRUE(IsWalkable(map, 9, 3, path, 50, 50));
+    ASSERT_EQ(graph.GetCacheHits(), 1);
+
+    // A different destination is a separate entry
+    ASSERT_TRUE(graph.FindPath(5, 5, 50, 51, path));
+    ASSERT_EQ(graph.GetCachedRouteCount(), 2);
+
+    // Blocking the gap drops the routes that went through it
+    map.SetTile(40, 20, Tile(TileType::WALL));
+    ASSERT_FALSE(graph.FindPath(9, 3, 50, 50, path));
+    ASSERT_EQ(graph.GetCachedRouteCount(), 0);
+}
+
+TEST(test_untouched_routes_survive_repair) {
+    Map map(96, 96);
+    PathGraph graph(&map);
+    std::vector<PathTile> path;
+    ASSERT_TRUE(graph.FindPath(2, 2, 40, 2, path));
+    ASSERT_EQ(graph.GetCachedRouteCount(), 1);
+
+    // An edit far from the route leaves it cached
+    map.SetTile(80, 80, Tile(TileType::WALL));
+    ASSERT_TRUE(graph.FindPath(3, 3, 40, 2, path));
+    ASSERT_EQ(graph.GetCacheHits(), 1);
+    ASSERT_EQ(graph.GetCachedRouteCount(), 1);
+}
+
+TEST(test_reset_rebuilds_graph) {
+    Map map(32, 32);
+    PathGraph graph(&map);
+    std::vector<PathTile> path;
+    ASSERT_TRUE(graph.FindPath(1, 1, 30, 30, path));
+    map.Reset(80, 80);
+    ASSERT_TRUE(graph.FindPath(1, 1, 70, 70, path));
+    ASSERT_TRUE(IsWalkable(map, 1, 1, path, 70, 70));
+    ASSERT_EQ(graph.GetFullBuilds(), 2);
+    ASSERT_EQ(graph.GetClusterCount(), 25);
+}
+
+TEST(test_detaches_from_map) {
+    Map map(32, 32);
+    {
+        PathGraph graph(&map);
+        std::vector<PathTile> path;
+        ASSERT_TRUE(graph.FindPath(1, 1, 20, 20, path));
+    }
+    // No handler left pointing at the destroyed graph
+    map.SetTile(5, 5, Tile(TileType::WALL));
+    ASSERT_TRUE(map.IsSolid(5, 5));
+}
+
+TEST(test_detached_graph_follows_snapshots) {
+    Map map(64, 64);
+    BuildWall(map, 40);
+    PathGraph graph;
+    std::vector<PathTile> path;
+    ASSERT_FALSE(graph.FindPath(5, 5, 5, 35, path));   // No grid yet
+    graph.SetGrid(std::make_shared<const SolidityGrid>(map.GetSolidityGrid()));
+    ASSERT_TRUE(graph.FindPath(5, 5, 5, 35, path));
+    size_t longWay = path.size();
+
+    // The live map moving on changes nothing until a new snapshot arrives
+    map.SetTile(5, 20, Tile(TileType::GRASS));
+    ASSERT_TRUE(graph.FindPath(5, 5, 5, 35, path));
+    ASSERT_EQ(path.size(), longWay);
+
+    // The new snapshot only repairs the clusters that differ
+    graph.SetGrid(std::make_shared<const SolidityGrid>(map.GetSolidityGrid()));
+    ASSERT_TRUE(graph.FindPath(5, 5, 5, 35, path));
+    ASSERT_TRUE(IsWalkable(map, 5, 5, path, 5, 35));
+    ASSERT_TRUE(path.size() < longWay);
+    ASSERT_EQ(graph.GetFullBuilds(), 1);
+    ASSERT_TRUE(graph.GetRepairedClusters() > 0);
+    ASSERT_TRUE(graph.GetRepairedClusters() <= 5);
+
+    // A different size is a different map: rebuilt from scratch
+    Map other(40, 40);
+    graph.SetGrid(std::make_shared<const SolidityGrid>(other.GetSolidityGrid()));
+    ASSERT_TRUE(graph.FindPath(1, 1, 38, 38, path));
+    ASSERT_EQ(graph.GetFullBuilds(), 2);
+}
+
+int main() {
+    std::cout << "=== Path Graph Tests ===" << std::endl;
+    RUN_TEST(test_straight_path_open_map);
+    RUN_TEST(test_same_tile_and_blocked_goal);
+    RUN_TEST(test_routes_through_gap);
+    RUN_TEST(test_unreachable_goal);
+    RUN_TEST(test_set_tile_repairs_locally);
+    RUN_TEST(test_same_cluster_detour);
+    RUN_TEST(test_route_cache_per_cluster_and_destination);
+    RUN_TEST(test_untouched_routes_survive_repair);
+    RUN_TEST(test_reset_rebuilds_graph);
+    RUN_TEST(test_detaches_from_map);
+    RUN_TEST(test_detached_graph_follows_snapshots);
+
+    std::cout << std::endl << s_passed << " passed, " << s_failed << " failed" << std::endl;
+    return s_failed > 0 ? 1 : 0;
+}
@@ -0,0 +1,209 @@
+// Harvest Quest — Asynchronous path service unit tests
+
+#include "world/PathService.h"
+#include "world/Map.h"
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+static int s_passed = 0;
+static int s_failed = 0;
+
+#define TEST(name) static void name()
+#define RUN_TEST(name) do { \
+    std::cout << "  " #name "... "; \
+    try { name(); std::cout << "PASS" << std::endl; s_passed++; } \
+    catch (...) { std::cout << "FAIL" << std::endl; s_failed++; } \
+} while(0)
+#define ASSERT_TRUE(expr)  do { if (!(expr)) throw 1; } while(0)
+#define ASSERT_FALSE(expr) do { if (expr) throw 1; } while(0)
+#define ASSERT_EQ(a, b)    do { if ((a) != (b)) throw 1; } while(0)
+
+// Polls like a game loop would until the request is answered
+static PathStatus WaitFor(PathService& service, PathHandle handle) {
+    for (int i = 0; i < 5000; ++i) {
+        PathStatus status = service.GetStatus(handle);
+        if (status != PathStatus::PENDING) return status;
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return PathStatus::PENDING;
+}
+
+static bool IsWalkable(const Map& map, int x, int y, const std::vector<PathTile>& path, int goalX, int goalY) {
+    for (const PathTile& step : path) {
+        int dx = step.x - x;
+        int dy = step.y - y;
+        if (std::abs(dx) > 1 || std::abs(dy) > 1 || (dx == 0 && dy == 0)) return false;
+        if (map.IsSolid(step.x, step.y)) return false;
+        if (dx != 0 && dy != 0 && (map.IsSolid(step.x, y) || map.IsSolid(x, step.y))) return false;
+        x = step.x;
+        y = step.y;
+    }
+    return x == goalX && y == goalY;
+}
+
+// Wall across row 20 with a single gap at column 40
+static void BuildWall(Map& map) {
+    for (int x = 0; x < map.GetWidth(); ++x) {
+        if (x != 40) map.SetTile(x, 20, Tile(TileType::WALL));
+    }
+}
+
+TEST(test_request_solves_async) {
+    Map map(64, 40);
+    BuildWall(map);
+    PathService service(&map);
+    PathHandle handle = service.Request(5, 5, 5, 35);
+    ASSERT_TRUE(handle != 0);
+    ASSERT_EQ(WaitFor(service, handle), PathStatus::READY);
+
+    std::vector<PathTile> path;
+    ASSERT_TRUE(service.TakePath(handle, path));
+    ASSERT_TRUE(IsWalkable(map, 5, 5, path, 5, 35));
+    ASSERT_EQ(service.GetStatus(handle), PathStatus::UNKNOWN);   // Taken handles are freed
+    ASSERT_EQ(service.GetOpenHandleCount(), 0);
+}
+
+TEST(test_trivial_requests_answer_immediately) {
+    Map map(20, 20);
+    map.SetTile(10, 10, Tile(TileType::WALL));
+    PathService service(&map);
+    ASSERT_EQ(service.GetStatus(service.Request(3, 3, 10, 10)), PathStatus::FAILED);
+    ASSERT_EQ(service.GetStatus(service.Request(3, 3, 30, 3)), PathStatus::FAILED);
+    PathHandle here = service.Request(3, 3, 3, 3);
+    std::vector<PathTile> path{{1, 1}};
+    ASSERT_TRUE(service.TakePath(here, path));
+    ASSERT_TRUE(path.empty());
+    ASSERT_EQ(service.GetSolveCount(), 0);
+}
+
+TEST(test_unreachable_goal_fails) {
+    Map map(30, 30);
+    for (int x = 0; x < 30; ++x) map.SetTile(x, 15, Tile(TileType::WALL));
+    PathService service(&map);
+    PathHandle handle = service.Request(2, 2, 2, 28);
+    ASSERT_EQ(WaitFor(service, handle), PathStatus::FAILED);
+    std::vector<PathTile> path;
+    ASSERT_FALSE(service.TakePath(handle, path));
+    ASSERT_EQ(service.GetOpenHandleCount(), 0);
+}
+
+TEST(test_identical_requests_share_one_solve) {
+    Map map(64, 40);
+    BuildWall(map);
+    PathService service(&map);
+    std::vector<PathHandle> handles;
+    for (int i = 0; i < 20; ++i) {
+        handles.push_back(service.Request(5, 5, 5, 35));
+    }
+    for (PathHandle handle : handles) {
+        ASSERT_EQ(WaitFor(service, handle), PathStatus::READY);
+    }
+    ASSERT_EQ(service.GetSolveCount(), 1);
+    ASSERT_EQ(service.GetSharedRequests() + service.GetCacheHits(), 19);
+}
+
+TEST(test_cache_and_overlapping_requests) {
+    Map map(64, 40);
+    BuildWall(map);
+    PathService service(&map);
+    PathHandle first = service.Request(5, 5, 5, 35);
+    ASSERT_EQ(WaitFor(service, first), PathStatus::READY);
+    std::vector<PathTile> full;
+    ASSERT_TRUE(service.TakePath(first, full));
+    ASSERT_EQ(service.GetCachedPathCount(), 1);
+
+    // Same request: answered from the cache on the spot
+    PathHandle again = service.Request(5, 5, 5, 35);
+    ASSERT_EQ(service.GetStatus(again), PathStatus::READY);
+
+    // Starting partway along the cached path: its tail is reused
+    PathTile mid = full[full.size() / 2];
+    PathHandle partway = service.Request(mid.x, mid.y, 5, 35);
+    ASSERT_EQ(service.GetStatus(partway), PathStatus::READY);
+    std::vector<PathTile> tail;
+    ASSERT_TRUE(service.TakePath(partway, tail));
+    ASSERT_EQ(tail.size(), full.size() - full.size() / 2 - 1);
+    ASSERT_TRUE(IsWalkable(map, mid.x, mid.y, tail, 5, 35));
+    ASSERT_EQ(service.GetSolveCount(), 1);
+    ASSERT_EQ(service.GetCacheHits(), 2);
+}
+
+TEST(test_solidity_change_invalidates_cache) {
+    Map map(64, 40);
+    BuildWall(map);
+    PathService service(&map);
+    PathHandle first = service.Request(5, 5, 5, 35);
+    ASSERT_EQ(WaitFor(service, first), PathStatus::READY);
+    service.Release(first);
+
+    std::uint32_t generation = map.GetSolidityGeneration();
+    map.SetTile(5, 20, Tile(TileType::GRASS));   // Opens a shortcut
+    ASSERT_TRUE(map.GetSolidityGeneration() != generation);
+    map.SetTile(6, 6, Tile(TileType::GRASS));    // Grass on grass: no solidity change
+    generation = map.GetSolidityGeneration();
+    map.SetTile(7, 7, Tile(TileType::GRASS));
+    ASSERT_EQ(map.GetSolidityGeneration(), generation);
+
+    PathHandle second = service.Request(5, 5, 5, 35);
+    ASSERT_EQ(WaitFor(service, second), PathStatus::READY);
+    std::vector<PathTile> path;
+    ASSERT_TRUE(service.TakePath(second, path));
+    ASSERT_TRUE(IsWalkable(map, 5, 5, path, 5, 35));
+    // Through the new gap rather than the old one at column 40
+    ASSERT_TRUE(std::any_of(path.begin(), path.end(), [](const PathTile& t) { return t.x == 5 && t.y == 20; }));
+    ASSERT_TRUE(path.size() < 40u);
+    ASSERT_EQ(service.GetSolveCount(), 2);
+}
+
+TEST(test_lru_evicts_oldest) {
+    Map map(40, 40);
+    PathServiceConfig config;
+    config.cacheCapacity = 2;
+    PathService service(&map, config);
+    const int goals[3] = { 10, 20, 30 };
+    for (int goal : goals) {
+        PathHandle handle = service.Request(1, 1, goal, 38);
+        ASSERT_EQ(WaitFor(service, handle), PathStatus::READY);
+        service.Release(handle);
+    }
+    ASSERT_EQ(service.GetCachedPathCount(), 2);
+
+    // The first goal was pushed out; the last is still there
+    ASSERT_EQ(service.GetStatus(service.Request(1, 1, 30, 38)), PathStatus::READY);
+    PathHandle evicted = service.Request(1, 1, 10, 38);
+    ASSERT_EQ(WaitFor(service, evicted), PathStatus::READY);
+    ASSERT_EQ(service.GetSolveCount(), 4);
+}
+
+TEST(test_release_pending_request) {
+    Map map(200, 200);
+    PathService service(&map);
+    PathHandle handle = service.Request(1, 1, 198, 198);
+    service.Release(handle);
+    ASSERT_EQ(service.GetStatus(handle), PathStatus::UNKNOWN);
+    ASSERT_EQ(service.GetOpenHandleCount(), 0);
+
+    // A fresh request for the same path still gets an answer
+    PathHandle retry = service.Request(1, 1, 198, 198);
+    ASSERT_EQ(WaitFor(service, retry), PathStatus::READY);
+}
+
+int main() {
+    std::cout << "=== Path Service Tests ===" << std::endl;
+    RUN_TEST(test_request_solves_async);
+    RUN_TEST(test_trivial_requests_answer_immediately);
+    RUN_TEST(test_unreachable_goal_fails);
+    RUN_TEST(test_identical_requests_share_one_solve);
+    RUN_TEST(test_cache_and_overlapping_requests);
+    RUN_TEST(test_solidity_change_invalidates_cache);
+    RUN_TEST(test_lru_evicts_oldest);
+    RUN_TEST(test_release_pending_request);
+
+    std::cout << std::endl << s_passed << " passed, " << s_failed << " failed" << std::endl;
+    return s_failed > 0 ? 1 : 0;
+}
@@ -0,0 +1,279 @@
+// Harvest Quest — Render command list and render queue unit tests
+
+#include "engine/RenderQueue.h"
+#include "engine/Renderer.h"
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+static int s_passed = 0;
+static int s_failed = 0;
+
+#define TEST(name) static void name()
+#define RUN_TEST(name) do { \
+    std::cout << "  " #name "... "; \
+    try { name(); std::cout << "PASS" << std::endl; s_passed++; } \
+    catch (...) { std::cout << "FAIL" << std::endl; s_failed++; } \
+} while(0)
+#define ASSERT_TRUE(expr)  do { if (!(expr)) throw 1; } while(0)
+#define ASSERT_FALSE(expr) do { if (expr) throw 1; } while(0)
+#define ASSERT_EQ(a, b)    do { if ((a) != (b)) throw 1; } while(0)
+
+static Texture2D MakeTexture(unsigned int id) {
+    Texture2D texture{};
+    texture.id = id;
+    texture.width = 512;
+    texture.height = 512;
+    return texture;
+}
+
+// One frame of a typical scene: tiles, a sprite and a HUD
+static void DrawScene(Renderer& renderer, const Texture2D& tiles, const Texture2D& sprites) {
+    Rectangle src = { 0, 0, 32, 32 };
+    Rectangle dst = { 0, 0, 32, 32 };
+    renderer.Clear(20, 20, 30);
+    renderer.SetLayer(RenderLayer::WORLD);
+    for (int i = 0; i < 10; ++i) renderer.DrawTextureRect(tiles, &src, &dst);
+    renderer.SetLayer(RenderLayer::ENTITIES);
+    renderer.DrawTextureRect(sprites, &src, &dst);
+    renderer.SetLayer(RenderLayer::UI);
+    renderer.FillRect(10, 10, 20, 20, 200, 50, 50);
+    renderer.DrawGameText("Gold: 10", 10, 38, 16, 255, 215, 0);
+    renderer.Present();
+}
+
+TEST(test_sort_orders_layers_and_keeps_submission_order) {
+    RenderCommandList list;
+    RenderQuad quad{};
+    list.AddText(RenderLayer::UI, "hud", 0, 0, 10, WHITE);
+    quad.textureId = 1;
+    list.AddQuads(RenderLayer::WORLD, &quad, 1);
+    quad.textureId = 2;
+    list.AddQuads(RenderLayer::ENTITIES, &quad, 1);
+    quad.textureId = 3;
+    list.AddQuads(RenderLayer::WORLD, &quad, 1);
+    list.Sort();
+
+    const auto& commands = list.GetCommands();
+    ASSERT_EQ(commands.size(), 4u);
+    ASSERT_EQ(list.GetQuads(commands[0])->textureId, 1u);
+    ASSERT_EQ(list.GetQuads(commands[1])->textureId, 3u);
+    ASSERT_EQ(list.GetQuads(commands[2])->textureId, 2u);
+    ASSERT_TRUE(commands[3].type == RenderCommandList::Type::TEXT);
+    ASSERT_EQ(std::strcmp(list.GetText(commands[3]), "hud"), 0);
+}
+
+TEST(test_reset_empties_list) {
+    RenderCommandList list;
+    RenderQuad quads[3] = {};
+    list.SetClearColor(Color{ 1, 2, 3, 255 });
+    list.AddQuads(RenderLayer::WORLD, quads, 3);
+    list.AddQuads(RenderLayer::WORLD, quads, 0);     // Empty runs are not recorded
+    list.AddText(RenderLayer::UI, "a", 0, 0, 10, WHITE);
+    list.AddText(RenderLayer::UI, "bc", 0, 0, 10, WHITE);
+    ASSERT_EQ(list.GetCommands().size(), 3u);
+    ASSERT_EQ(list.GetQuadCount(), 3);
+    ASSERT_EQ(std::strcmp(list.GetText(list.GetCommands()[2]), "bc"), 0);
+
+    list.Reset();
+    ASSERT_TRUE(list.GetCommands().empty());
+    ASSERT_EQ(list.GetQuadCount(), 0);
+    ASSERT_EQ(list.GetClearColor().r, 0);
+}
+
+TEST(test_recording_touches_no_stats) {
+    Renderer renderer;
+    renderer.Initialize(800, 600, RenderBackend::HEADLESS);
+    RenderCommandList list;
+    renderer.BeginRecording(&list);
+    ASSERT_TRUE(renderer.IsRecording());
+    DrawScene(renderer, MakeTexture(100), MakeTexture(200));
+    renderer.EndRecording();
+    ASSERT_FALSE(renderer.IsRecording());
+
+    ASSERT_EQ(renderer.GetTotals().frames, 0u);
+    ASSERT_EQ(renderer.GetFrameQuadCount(), 0);
+    ASSERT_EQ(list.GetQuadCount(), 12);
+    ASSERT_EQ(list.GetClearColor().b, 30);
+    ASSERT_EQ(list.GetCommands().size(), 4u);   // Tiles, sprite, HUD rect, HUD text
+}
+
+TEST(test_replay_matches_immediate) {
+    Texture2D tiles = MakeTexture(100);
+    Texture2D sprites = MakeTexture(200);
+
+    Renderer immediate;
+    immediate.Initialize(800, 600, RenderBackend::HEADLESS);
+    DrawScene(immediate, tiles, sprites);
+
+    Renderer recorded;
+    recorded.Initialize(800, 600, RenderBackend::HEADLESS);
+    RenderCommandList list;
+    recorded.BeginRecording(&list);
+    DrawScene(recorded, tiles, sprites);
+    recorded.EndRecording();
+    recorded.Replay(list);
+
+    ASSERT_EQ(recorded.GetFrameQuadCount(), immediate.GetFrameQuadCount());
+    ASSERT_EQ(recorded.GetFrameBatchCount(), immediate.GetFrameBatchCount());
+    ASSERT_EQ(recorded.GetFrameTextCount(), immediate.GetFrameTextCount());
+    ASSERT_EQ(recorded.GetTotals().frames, 1u);
+    ASSERT_EQ(recorded.GetFrameBatchCount(), 3);
+}
+
+// A frame that fills a target once and draws it twice
+static void DrawTargetScene(Renderer& renderer, std::uint32_t target, bool fill) {
+    Rectangle dst = { 0, 0, 64, 64 };
+    renderer.Clear();
+    if (fill) {
+        renderer.BeginTarget(target, 64, 64);
+        renderer.FillRect(0, 0, 32, 32, 200, 50, 50);
+        renderer.FillRect(32, 32, 32, 32, 50, 200, 50);
+        renderer.EndTarget();
+    }
+    renderer.DrawTarget(target, dst);
+    dst.x = 64;
+    renderer.DrawTarget(target, dst);
+    renderer.Present();
+}
+
+TEST(test_targets_are_created_on_replay) {
+    Renderer renderer;
+    renderer.Initialize(800, 600, RenderBackend::HEADLESS);
+    RenderCommandList list;
+    std::uint32_t target = renderer.CreateTarget();
+    ASSERT_TRUE(target != 0);
+
+    renderer.BeginRecording(&list);
+    DrawTargetScene(renderer, target, true);
+    renderer.EndRecording();
+    ASSERT_EQ(renderer.GetTargetCount(), 0);   // Recording made no texture
+
+    renderer.Replay(list);
+    ASSERT_EQ(renderer.GetTargetCount(), 1);
+    ASSERT_EQ(renderer.GetFrameQuadCount(), 4);   // Two into the target, two of it
+
+    // Later frames draw the target without filling it again
+    list.Reset();
+    renderer.BeginRecording(&list);
+    DrawTargetScene(renderer, target, false);
+    renderer.EndRecording();
+    renderer.Replay(list);
+    ASSERT_EQ(renderer.GetFrameQuadCount(), 2);
+
+    // Destruction waits for the next frame, then happens on replay
+    renderer.DestroyTarget(target);
+    ASSERT_EQ(renderer.GetTargetCount(), 1);
+    list.Reset();
+    renderer.BeginRecording(&list);
+    renderer.Clear();
+    renderer.Present();
+    renderer.EndRecording();
+    ASSERT_EQ(renderer.GetTargetCount(), 1);
+    renderer.Replay(list);
+    ASSERT_EQ(renderer.GetTargetCount(), 0);
+}
+
+TEST(test_target_replay_matches_immediate) {
+    Renderer immediate;
+    immediate.Initialize(800, 600, RenderBackend::HEADLESS);
+    DrawTargetScene(immediate, immediate.CreateTarget(), true);
+    ASSERT_EQ(immediate.GetTargetCount(), 1);
+
+    Renderer recorded;
+    recorded.Initialize(800, 600, RenderBackend::HEADLESS);
+    RenderCommandList list;
+    recorded.BeginRecording(&list);
+    DrawTargetScene(recorded, recorded.CreateTarget(), true);
+    recorded.EndRecording();
+    recorded.Replay(list);
+
+    ASSERT_EQ(recorded.GetFrameQuadCount(), immediate.GetFrameQuadCount());
+    ASSERT_EQ(recorded.GetFrameBatchCount(), immediate.GetFrameBatchCount());
+
+    // Drawing a target nobody filled draws nothing
+    immediate.Clear();
+    immediate.DrawTarget(immediate.CreateTarget(), Rectangle{ 0, 0, 64, 64 });
+    immediate.Present();
+    ASSERT_EQ(immediate.GetFrameQuadCount(), 0);
+}
+
+TEST(test_queue_hands_over_frames_in_order) {
+    RenderQueue queue;
+    const int frames = 200;
+    std::thread simulation([&queue] {
+        std::vector<RenderQuad> quads(frames);
+        for (int frame = 1; frame <= frames; ++frame) {
+            RenderCommandList* list = queue.BeginRecord();
+            if (!list) return;
+            list->AddQuads(RenderLayer::WORLD, quads.data(), static_cast<std::size_t>(frame));
+            queue.Submit();
+        }
+        queue.Close();
+    });
+
+    int expected = 1;
+    bool inOrder = true;
+    while (const RenderCommandList* list = queue.AcquireFrame()) {
+        if (list->GetQuadCount() != expected++) inOrder = false;
+        queue.ReleaseFrame();
+    }
+    simulation.join();
+    ASSERT_TRUE(inOrder);
+    ASSERT_EQ(expected, frames + 1);
+    ASSERT_EQ(queue.GetSubmittedCount(), static_cast<std::uint64_t>(frames));
+}
+
+TEST(test_simulation_runs_at_most_one_frame_ahead) {
+    RenderQueue queue;
+    queue.BeginRecord();
+    queue.Submit();
+    queue.BeginRecord();
+    queue.Submit();
+
+    // Both lists hold unreplayed frames: the third recording has to wait
+    std::atomic<bool> started{ false };
+    std::thread simulation([&queue, &started] {
+        if (queue.BeginRecord()) started = true;
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    ASSERT_FALSE(started);
+
+    ASSERT_TRUE(queue.AcquireFrame() != nullptr);
+    queue.ReleaseFrame();
+    simulation.join();
+    ASSERT_TRUE(started);
+}
+
+TEST(test_close_drains_then_stops) {
+    RenderQueue queue;
+    queue.BeginRecord();
+    queue.Submit();
+    queue.Close();
+    ASSERT_TRUE(queue.IsClosed());
+    ASSERT_TRUE(queue.BeginRecord() == nullptr);
+
+    ASSERT_TRUE(queue.AcquireFrame() != nullptr);   // Submitted before the close
+    queue.ReleaseFrame();
+    ASSERT_TRUE(queue.AcquireFrame() == nullptr);
+}
+
+int main() {
+    std::cout << "=== Render Queue Tests ===" << std::endl;
+    RUN_TEST(test_sort_orders_layers_and_keeps_submission_order);
+    RUN_TEST(test_reset_empties_list);
+    RUN_TEST(test_recording_touches_no_stats);
+    RUN_TEST(test_replay_matches_immediate);
+    RUN_TEST(test_targets_are_created_on_replay);
+    RUN_TEST(test_target_replay_matches_immediate);
+    RUN_TEST(test_queue_hands_over_frames_in_order);
+    RUN_TEST(test_simulation_runs_at_most_one_frame_ahead);
+    RUN_TEST(test_close_drains_then_stops);
+
+    std::cout << std::endl << s_passed << " passed, " << s_failed << " failed" << std::endl;
+    return s_failed > 0 ? 1 : 0;
+}
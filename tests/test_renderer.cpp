@@ -0,0 +1,146 @@
+// Harvest Quest — Renderer quad batching unit tests
+
+#include "engine/Renderer.h"
+#include <cassert>
+#include <iostream>
+
+static int s_passed = 0;
+static int s_failed = 0;
+
+#define TEST(name) static void name()
+#define RUN_TEST(name) do { \
+    std::cout << "  " #name "... "; \
+    try { name(); std::cout << "PASS" << std::endl; s_passed++; } \
+    catch (...) { std::cout << "FAIL" << std::endl; s_failed++; } \
+} while(0)
+#define ASSERT_TRUE(expr)  do { if (!(expr)) throw 1; } while(0)
+#define ASSERT_FALSE(expr) do { if (expr) throw 1; } while(0)
+#define ASSERT_EQ(a, b)    do { if ((a) != (b)) throw 1; } while(0)
+
+static Texture2D MakeTexture(unsigned int id) {
+    Texture2D texture{};
+    texture.id = id;
+    texture.width = 512;
+    texture.height = 512;
+    return texture;
+}
+
+TEST(test_solid_rects_share_one_batch) {
+    Renderer renderer;
+    renderer.Initialize(800, 600);
+    renderer.Clear();
+    for (int i = 0; i < 100; ++i) {
+        renderer.FillRect(i * 8, 0, 8, 8, 255, 0, 0);
+        renderer.DrawRect(i * 8, 0, 8, 8, 0, 0, 0);    // Outlines are four quads
+    }
+    ASSERT_EQ(renderer.GetPendingQuadCount(), 500);
+    renderer.Present();
+    ASSERT_EQ(renderer.GetPendingQuadCount(), 0);
+    ASSERT_EQ(renderer.GetFrameQuadCount(), 500);
+    ASSERT_EQ(renderer.GetFrameBatchCount(), 1);
+}
+
+TEST(test_texture_switches_split_batches) {
+    Renderer renderer;
+    renderer.Initialize(800, 600);
+    Texture2D tiles = MakeTexture(100);
+    Texture2D sprites = MakeTexture(101);
+    Rectangle src = { 0, 0, 32, 32 };
+    Rectangle dst = { 0, 0, 32, 32 };
+    renderer.Clear();
+    for (int i = 0; i < 50; ++i) renderer.DrawTextureRect(tiles, &src, &dst);
+    for (int i = 0; i < 10; ++i) renderer.DrawTextureRect(sprites, &src, &dst);
+    renderer.FillRect(0, 0, 10, 10, 0, 0, 0);
+    renderer.DrawTextureRect(tiles, &src, &dst);
+    renderer.Present();
+    ASSERT_EQ(renderer.GetFrameQuadCount(), 62);
+    ASSERT_EQ(renderer.GetFrameBatchCount(), 4);     // Runs keep submission order
+}
+
+TEST(test_text_flushes_queue) {
+    Renderer renderer;
+    renderer.Initialize(800, 600);
+    renderer.Clear();
+    renderer.FillRect(0, 0, 10, 10, 0, 0, 0);
+    renderer.DrawGameText("Day 1", 4, 4, 20, 255, 255, 255);
+    ASSERT_EQ(renderer.GetPendingQuadCount(), 0);
+    renderer.FillRect(0, 0, 10, 10, 0, 0, 0);
+    renderer.Present();
+    ASSERT_EQ(renderer.GetFrameBatchCount(), 2);
+}
+
+TEST(test_skips_empty_quads) {
+    Renderer renderer;
+    renderer.Initialize(800, 600);
+    Rectangle src = { 0, 0, 32, 32 };
+    Rectangle dst = { 0, 0, 32, 32 };
+    Rectangle empty = { 0, 0, 0, 32 };
+    renderer.Clear();
+    renderer.DrawTextureRect(MakeTexture(0), &src, &dst);     // Never loaded
+    renderer.DrawTextureRect(MakeTexture(100), &src, &empty);
+    renderer.FillRect(0, 0, 0, 10, 0, 0, 0);
+    ASSERT_EQ(renderer.GetPendingQuadCount(), 0);
+    renderer.Present();
+    ASSERT_EQ(renderer.GetFrameBatchCount(), 0);
+}
+
+TEST(test_clear_starts_new_frame_stats) {
+    Renderer renderer;
+    renderer.Initialize(800, 600);
+    renderer.Clear();
+    renderer.FillRect(0, 0, 10, 10, 0, 0, 0);
+    renderer.Present();
+    renderer.Clear();
+    ASSERT_EQ(renderer.GetFrameQuadCount(), 0);
+    ASSERT_EQ(renderer.GetFrameBatchCount(), 0);
+}
+
+TEST(test_headless_counts_without_drawing) {
+    Renderer renderer;
+    renderer.Initialize(800, 600, RenderBackend::HEADLESS);
+    ASSERT_TRUE(Renderer::IsHeadless());
+    Image image = GenImageColor(64, 32, WHITE);
+    Texture2D texture = Renderer::CreateTexture(image);
+    UnloadImage(image);
+    ASSERT_TRUE(texture.id != 0);
+    ASSERT_EQ(texture.width, 64);
+    ASSERT_EQ(texture.height, 32);
+
+    Rectangle src = { 0, 0, 32, 32 };
+    Rectangle dst = { 0, 0, 32, 32 };
+    for (int frame = 0; frame < 3; ++frame) {
+        renderer.Clear();
+        renderer.FillRect(0, 0, 10, 10, 0, 0, 0);
+        renderer.DrawTextureRect(texture, &src, &dst);
+        renderer.DrawTextureRect(texture, &src, &dst);
+        renderer.DrawGameText("Gold: 10", 4, 4, 20, 255, 255, 255);
+        renderer.Present();
+    }
+    ASSERT_EQ(renderer.GetFrameQuadCount(), 3);
+    ASSERT_EQ(renderer.GetFrameBatchCount(), 2);
+    ASSERT_EQ(renderer.GetFrameTextCount(), 1);
+
+    const RenderStats& totals = renderer.GetTotals();
+    ASSERT_EQ(totals.frames, 3u);
+    ASSERT_EQ(totals.quads, 9u);
+    ASSERT_EQ(totals.batches, 6u);
+    ASSERT_EQ(totals.textDraws, 3u);
+    Renderer::DestroyTexture(texture);
+
+    // Back to the real backend for the other tests
+    renderer.Initialize(800, 600);
+    ASSERT_FALSE(Renderer::IsHeadless());
+}
+
+int main() {
+    std::cout << "=== Renderer Tests ===" << std::endl;
+    RUN_TEST(test_solid_rects_share_one_batch);
+    RUN_TEST(test_texture_switches_split_batches);
+    RUN_TEST(test_text_flushes_queue);
+    RUN_TEST(test_skips_empty_quads);
+    RUN_TEST(test_clear_starts_new_frame_stats);
+    RUN_TEST(test_headless_counts_without_drawing);
+
+    std::cout << std::endl << s_passed << " passed, " << s_failed << " failed" << std::endl;
+    return s_failed > 0 ? 1 : 0;
+}
@@ -8,6 +8,7 @@
 #include "systems/Energy.h"
 #include "systems/Skills.h"
 #include "systems/Quest.h"
+#include "world/Map.h"
 #include <cassert>
 #include <iostream>
 #include <cstdio>
@@ -430,6 +431,32 @@ TEST(test_roundtrip_quest_active) {
     CleanupTestFile();
 }
 
+// ---- Sleeping after loading an earlier day ----
+
+TEST(test_sleep_after_loading_earlier_day_grows_crops) {
+    CleanupTestFile();
+    Player player;
+    Inventory inventory;
+    Calendar calendar;
+    int gold = 0;
+    Map map(8, 8);
+    map.TillSoil(1, 1);
+    map.PlantCrop(1, 1, 0);
+
+    // Save on day N, sleep to N+1, load day N back, then sleep again
+    ASSERT_TRUE(SaveSystem::Save(GetTestSavePath().c_str(), &player, &inventory, &calendar, gold));
+    int savedDay = calendar.GetDay();
+    calendar.AdvanceDay();
+    map.AdvanceDay();
+    ASSERT_TRUE(SaveSystem::Load(GetTestSavePath().c_str(), &player, &inventory, &calendar, gold));
+    ASSERT_EQ(calendar.GetDay(), savedDay);
+    calendar.AdvanceDay();
+    map.AdvanceDay();
+
+    ASSERT_EQ(map.GetFarmPlot(1, 1)->GetGrowthStage(), 2);
+    CleanupTestFile();
+}
+
 int main() {
     std::cout << "=== SaveSystem Tests ===" << std::endl;
     RUN_TEST(test_save_creates_file);
@@ -450,6 +477,7 @@ int main() {
     RUN_TEST(test_roundtrip_energy);
     RUN_TEST(test_roundtrip_skills);
     RUN_TEST(test_roundtrip_quest_active);
+    RUN_TEST(test_sleep_after_loading_earlier_day_grows_crops);
 
     std::cout << std::endl << s_passed << " passed, " << s_failed << " failed" << std::endl;
     return s_failed > 0 ? 1 : 0;
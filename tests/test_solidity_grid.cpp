@@ -0,0 +1,154 @@
+// Harvest Quest — Solidity bitmap unit tests
+
+#include "world/SolidityGrid.h"
+#include <cassert>
+#include <iostream>
+#include <random>
+#include <vector>
+
+static int s_passed = 0;
+static int s_failed = 0;
+
+#define TEST(name) static void name()
+#define RUN_TEST(name) do { \
+    std::cout << "  " #name "... "; \
+    try { name(); std::cout << "PASS" << std::endl; s_passed++; } \
+    catch (...) { std::cout << "FAIL" << std::endl; s_failed++; } \
+} while(0)
+#define ASSERT_TRUE(expr)  do { if (!(expr)) throw 1; } while(0)
+#define ASSERT_FALSE(expr) do { if (expr) throw 1; } while(0)
+#define ASSERT_EQ(a, b)    do { if ((a) != (b)) throw 1; } while(0)
+
+TEST(test_reset_clear) {
+    SolidityGrid grid;
+    grid.Reset(100, 20, false);
+    ASSERT_EQ(grid.GetWidth(), 100);
+    ASSERT_EQ(grid.GetHeight(), 20);
+    ASSERT_EQ(grid.GetSolidCount(), 0);
+    ASSERT_FALSE(grid.IsSolid(99, 19));
+    ASSERT_FALSE(grid.AnySolidInRect(0, 0, 99, 19));
+}
+
+TEST(test_reset_solid_leaves_padding_clear) {
+    SolidityGrid grid;
+    grid.Reset(70, 3, true);
+    ASSERT_EQ(grid.GetSolidCount(), 70 * 3);
+    ASSERT_TRUE(grid.IsSolid(69, 2));
+}
+
+TEST(test_set_and_clear) {
+    SolidityGrid grid;
+    grid.Reset(200, 10, false);
+    grid.Set(130, 4, true);
+    ASSERT_TRUE(grid.IsSolid(130, 4));
+    ASSERT_FALSE(grid.IsSolid(129, 4));
+    ASSERT_FALSE(grid.IsSolid(130, 5));
+    grid.Set(130, 4, false);
+    ASSERT_FALSE(grid.IsSolid(130, 4));
+    grid.Set(500, 4, true);     // Off the grid: ignored
+    ASSERT_EQ(grid.GetSolidCount(), 0);
+}
+
+TEST(test_outside_is_solid) {
+    SolidityGrid grid;
+    grid.Reset(10, 10, false);
+    ASSERT_TRUE(grid.IsSolid(-1, 0));
+    ASSERT_TRUE(grid.IsSolid(0, 10));
+    ASSERT_TRUE(grid.AnySolidInRect(-1, 0, 3, 3));
+    ASSERT_TRUE(grid.AnySolidInRect(5, 5, 10, 6));
+    int x = 0;
+    ASSERT_TRUE(grid.FirstSolidInRow(2, 4, 20, x));    // Runs off the right edge
+    ASSERT_EQ(x, 10);
+    ASSERT_FALSE(grid.FirstSolidInRow(2, 4, 9, x));
+    ASSERT_TRUE(grid.FirstSolidInRow(-3, 4, 9, x));
+    ASSERT_EQ(x, 4);
+    ASSERT_TRUE(grid.LastSolidInRow(2, -5, 3, x));     // Runs off the left edge
+    ASSERT_EQ(x, -1);
+    ASSERT_FALSE(grid.LastSolidInRow(2, 0, 9, x));
+}
+
+TEST(test_rect_within_one_word) {
+    SolidityGrid grid;
+    grid.Reset(64, 64, false);
+    grid.Set(10, 10, true);
+    ASSERT_TRUE(grid.AnySolidInRect(10, 10, 10, 10));
+    ASSERT_TRUE(grid.AnySolidInRect(5, 5, 15, 15));
+    ASSERT_FALSE(grid.AnySolidInRect(11, 5, 20, 15));
+    ASSERT_FALSE(grid.AnySolidInRect(0, 0, 9, 63));
+}
+
+TEST(test_rect_spanning_many_words) {
+    SolidityGrid grid;
+    grid.Reset(2000, 8, false);
+    ASSERT_FALSE(grid.AnySolidInRect(1, 0, 1998, 7));
+    grid.Set(1000, 3, true);    // Lands in the SIMD-scanned middle of the row
+    ASSERT_TRUE(grid.AnySolidInRect(1, 0, 1998, 7));
+    ASSERT_FALSE(grid.AnySolidInRect(1, 4, 1998, 7));
+    ASSERT_FALSE(grid.AnySolidInRect(1001, 0, 1998, 7));
+    int x = 0;
+    ASSERT_TRUE(grid.FirstSolidInRow(3, 0, 1999, x));
+    ASSERT_EQ(x, 1000);
+    ASSERT_FALSE(grid.FirstSolidInRow(3, 1001, 1999, x));
+    ASSERT_TRUE(grid.LastSolidInRow(3, 0, 1999, x));
+    ASSERT_EQ(x, 1000);
+    ASSERT_FALSE(grid.LastSolidInRow(3, 0, 999, x));
+}
+
+TEST(test_matches_brute_force) {
+    const int width = 333;
+    const int height = 41;
+    SolidityGrid grid;
+    grid.Reset(width, height, false);
+    std::vector<bool> solid(width * height, false);
+
+    std::mt19937 rng(1234);
+    for (int i = 0; i < 300; ++i) {
+        int x = static_cast<int>(rng() % width);
+        int y = static_cast<int>(rng() % height);
+        grid.Set(x, y, true);
+        solid[y * width + x] = true;
+    }
+
+    for (int q = 0; q < 2000; ++q) {
+        int x0 = static_cast<int>(rng() % width);
+        int x1 = x0 + static_cast<int>(rng() % (width - x0));
+        int y0 = static_cast<int>(rng() % height);
+        int y1 = y0 + static_cast<int>(rng() % std::min(4, height - y0));
+
+        bool expected = false;
+        for (int y = y0; y <= y1 && !expected; ++y) {
+            for (int x = x0; x <= x1; ++x) {
+                if (solid[y * width + x]) { expected = true; break; }
+            }
+        }
+        ASSERT_EQ(grid.AnySolidInRect(x0, y0, x1, y1), expected);
+
+        int first = -1;
+        int last = -1;
+        for (int x = x0; x <= x1; ++x) {
+            if (solid[y0 * width + x]) {
+                if (first < 0) first = x;
+                last = x;
+            }
+        }
+        int found = -1;
+        ASSERT_EQ(grid.FirstSolidInRow(y0, x0, x1, found), first >= 0);
+        if (first >= 0) ASSERT_EQ(found, first);
+        ASSERT_EQ(grid.LastSolidInRow(y0, x0, x1, found), last >= 0);
+        if (last >= 0) ASSERT_EQ(found, last);
+    }
+}
+
+int main() {
+    std::cout << "=== Solidity Grid Tests ===" << std::endl;
+    RUN_TEST(test_reset_clear);
+    RUN_TEST(test_reset_solid_leaves_padding_clear);
+    RUN_TEST(test_set_and_clear);
+    RUN_TEST(test_outside_is_solid);
+    RUN_TEST(test_rect_within_one_word);
+    RUN_TEST(test_rect_spanning_many_words);
+    RUN_TEST(test_matches_brute_force);
+
+    std::cout << std::endl << s_passed << " passed, " << s_failed << " failed" << std::endl;
+    return s_failed > 0 ? 1 : 0;
+}
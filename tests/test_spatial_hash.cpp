@@ -0,0 +1,155 @@
+// Harvest Quest — Spatial hash grid unit tests
+
+#include "world/SpatialHash.h"
+#include <algorithm>
+#include <cassert>
+#include <iostream>
+#include <random>
+#include <vector>
+
+static int s_passed = 0;
+static int s_failed = 0;
+
+#define TEST(name) static void name()
+#define RUN_TEST(name) do { \
+    std::cout << "  " #name "... "; \
+    try { name(); std::cout << "PASS" << std::endl; s_passed++; } \
+    catch (...) { std::cout << "FAIL" << std::endl; s_failed++; } \
+} while(0)
+#define ASSERT_TRUE(expr)  do { if (!(expr)) throw 1; } while(0)
+#define ASSERT_FALSE(expr) do { if (expr) throw 1; } while(0)
+#define ASSERT_EQ(a, b)    do { if ((a) != (b)) throw 1; } while(0)
+
+struct Box {
+    float x, y, w, h;
+};
+
+TEST(test_insert_and_query_aabb) {
+    SpatialHash<Box> grid;
+    Box a{10, 10, 20, 20};
+    Box b{300, 300, 20, 20};
+    grid.Update(&a, a.x, a.y, a.w, a.h);
+    grid.Update(&b, b.x, b.y, b.w, b.h);
+    ASSERT_EQ(grid.GetCount(), 2);
+
+    std::vector<Box*> found;
+    grid.QueryAABB(0, 0, 50, 50, found);
+    ASSERT_EQ(found.size(), 1u);
+    ASSERT_TRUE(found[0] == &a);
+
+    found.clear();
+    grid.QueryAABB(30, 30, 10, 10, found);   // Touching edges do not overlap
+    ASSERT_TRUE(found.empty());
+}
+
+TEST(test_item_spanning_cells_reported_once) {
+    SpatialHash<Box> grid(32.0f);
+    Box big{20, 20, 100, 100};   // Covers a 4x4 block of cells
+    grid.Update(&big, big.x, big.y, big.w, big.h);
+
+    std::vector<Box*> found;
+    grid.QueryAABB(0, 0, 200, 200, found);
+    ASSERT_EQ(found.size(), 1u);
+    found.clear();
+    grid.QueryRadius(70, 70, 5, found);
+    ASSERT_EQ(found.size(), 1u);
+}
+
+TEST(test_update_moves_between_cells) {
+    SpatialHash<Box> grid;
+    Box a{0, 0, 10, 10};
+    grid.Update(&a, 0, 0, 10, 10);
+    grid.Update(&a, 500, 500, 10, 10);
+
+    std::vector<Box*> found;
+    grid.QueryAABB(0, 0, 20, 20, found);
+    ASSERT_TRUE(found.empty());
+    grid.QueryAABB(495, 495, 20, 20, found);
+    ASSERT_EQ(found.size(), 1u);
+    ASSERT_EQ(grid.GetCount(), 1);
+}
+
+TEST(test_remove_and_clear) {
+    SpatialHash<Box> grid;
+    Box a{0, 0, 10, 10};
+    Box b{5, 5, 10, 10};
+    grid.Update(&a, a.x, a.y, a.w, a.h);
+    grid.Update(&b, b.x, b.y, b.w, b.h);
+    grid.Remove(&a);
+    ASSERT_FALSE(grid.Contains(&a));
+    ASSERT_TRUE(grid.Contains(&b));
+
+    std::vector<Box*> found;
+    grid.QueryAABB(0, 0, 20, 20, found);
+    ASSERT_EQ(found.size(), 1u);
+    grid.Clear();
+    ASSERT_EQ(grid.GetCount(), 0);
+}
+
+TEST(test_query_radius) {
+    SpatialHash<Box> grid;
+    Box near{100, 100, 10, 10};
+    Box corner{140, 140, 10, 10};
+    grid.Update(&near, near.x, near.y, near.w, near.h);
+    grid.Update(&corner, corner.x, corner.y, corner.w, corner.h);
+
+    std::vector<Box*> found;
+    grid.QueryRadius(90, 105, 12, found);
+    ASSERT_EQ(found.size(), 1u);
+    ASSERT_TRUE(found[0] == &near);
+
+    // The nearest corner of the second box is ~42 away diagonally
+    found.clear();
+    grid.QueryRadius(110, 110, 40, found);
+    ASSERT_EQ(found.size(), 1u);
+    found.clear();
+    grid.QueryRadius(110, 110, 45, found);
+    ASSERT_EQ(found.size(), 2u);
+}
+
+TEST(test_matches_brute_force_with_many_items) {
+    SpatialHash<Box> grid;
+    std::vector<Box> boxes(5000);
+    std::mt19937 rng(99);
+    std::uniform_real_distribution<float> pos(-500.0f, 8000.0f);
+    std::uniform_real_distribution<float> size(4.0f, 60.0f);
+    for (auto& box : boxes) {
+        box = Box{pos(rng), pos(rng), size(rng), size(rng)};
+        grid.Update(&box, box.x, box.y, box.w, box.h);
+    }
+    // Move half of them
+    for (size_t i = 0; i < boxes.size(); i += 2) {
+        boxes[i].x += 37.0f;
+        boxes[i].y -= 90.0f;
+        grid.Update(&boxes[i], boxes[i].x, boxes[i].y, boxes[i].w, boxes[i].h);
+    }
+
+    for (int q = 0; q < 200; ++q) {
+        float qx = pos(rng), qy = pos(rng), qw = size(rng) * 3, qh = size(rng) * 3;
+        std::vector<Box*> found;
+        grid.QueryAABB(qx, qy, qw, qh, found);
+
+        std::vector<Box*> expected;
+        for (auto& box : boxes) {
+            if (qx < box.x + box.w && qx + qw > box.x && qy < box.y + box.h && qy + qh > box.y) {
+                expected.push_back(&box);
+            }
+        }
+        std::sort(found.begin(), found.end());
+        std::sort(expected.begin(), expected.end());
+        ASSERT_TRUE(found == expected);
+    }
+}
+
+int main() {
+    std::cout << "=== Spatial Hash Tests ===" << std::endl;
+    RUN_TEST(test_insert_and_query_aabb);
+    RUN_TEST(test_item_spanning_cells_reported_once);
+    RUN_TEST(test_update_moves_between_cells);
+    RUN_TEST(test_remove_and_clear);
+    RUN_TEST(test_query_radius);
+    RUN_TEST(test_matches_brute_force_with_many_items);
+
+    std::cout << std::endl << s_passed << " passed, " << s_failed << " failed" << std::endl;
+    return s_failed > 0 ? 1 : 0;
+}
@@ -0,0 +1,117 @@
+// Harvest Quest — Texture atlas packing unit tests
+
+#include "engine/TextureAtlas.h"
+#include <cassert>
+#include <iostream>
+#include <vector>
+
+static int s_passed = 0;
+static int s_failed = 0;
+
+#define TEST(name) static void name()
+#define RUN_TEST(name) do { \
+    std::cout << "  " #name "... "; \
+    try { name(); std::cout << "PASS" << std::endl; s_passed++; } \
+    catch (...) { std::cout << "FAIL" << std::endl; s_failed++; } \
+} while(0)
+#define ASSERT_TRUE(expr)  do { if (!(expr)) throw 1; } while(0)
+#define ASSERT_FALSE(expr) do { if (expr) throw 1; } while(0)
+#define ASSERT_EQ(a, b)    do { if ((a) != (b)) throw 1; } while(0)
+
+static AtlasEntry Size(int width, int height) {
+    AtlasEntry entry;
+    entry.width = width;
+    entry.height = height;
+    return entry;
+}
+
+static bool Overlaps(const AtlasEntry& a, const AtlasEntry& b) {
+    return a.page == b.page &&
+           a.x < b.x + b.width && b.x < a.x + a.width &&
+           a.y < b.y + b.height && b.y < a.y + a.height;
+}
+
+// Every placed entry sits inside its page and clear of every other one
+static bool IsValidLayout(const std::vector<AtlasEntry>& entries, const std::vector<int>& pageSizes) {
+    for (size_t i = 0; i < entries.size(); ++i) {
+        const AtlasEntry& entry = entries[i];
+        if (entry.page < 0) continue;
+        int size = pageSizes[entry.page];
+        if (entry.x < 0 || entry.y < 0 || entry.x + entry.width > size || entry.y + entry.height > size) return false;
+        for (size_t j = i + 1; j < entries.size(); ++j) {
+            if (entries[j].page >= 0 && Overlaps(entry, entries[j])) return false;
+        }
+    }
+    return true;
+}
+
+TEST(test_default_sheets_share_one_page) {
+    // world (32px tiles), characters, dungeon and farm (16px tiles)
+    std::vector<AtlasEntry> sizes = { Size(512, 512), Size(256, 256), Size(256, 256), Size(256, 128) };
+    std::vector<AtlasEntry> entries;
+    std::vector<int> pageSizes;
+    ASSERT_EQ(TextureAtlas::Pack(sizes, TextureAtlas::MAX_PAGE_SIZE, entries, pageSizes), 1);
+    ASSERT_EQ(pageSizes[0], 1024);
+    ASSERT_TRUE(IsValidLayout(entries, pageSizes));
+    for (size_t i = 0; i < sizes.size(); ++i) {
+        ASSERT_EQ(entries[i].width, sizes[i].width);
+        ASSERT_EQ(entries[i].height, sizes[i].height);
+    }
+}
+
+TEST(test_page_is_smallest_power_of_two) {
+    std::vector<AtlasEntry> entries;
+    std::vector<int> pageSizes;
+    TextureAtlas::Pack({ Size(100, 40) }, TextureAtlas::MAX_PAGE_SIZE, entries, pageSizes);
+    ASSERT_EQ(pageSizes[0], TextureAtlas::MIN_PAGE_SIZE);
+    TextureAtlas::Pack({ Size(300, 40) }, TextureAtlas::MAX_PAGE_SIZE, entries, pageSizes);
+    ASSERT_EQ(pageSizes[0], 512);
+}
+
+TEST(test_overflow_opens_another_page) {
+    std::vector<AtlasEntry> sizes(6, Size(500, 500));
+    std::vector<AtlasEntry> entries;
+    std::vector<int> pageSizes;
+    int pages = TextureAtlas::Pack(sizes, 1024, entries, pageSizes);
+    ASSERT_EQ(pages, 2);                // Four fit on a 1024 page
+    ASSERT_TRUE(IsValidLayout(entries, pageSizes));
+    for (const AtlasEntry& entry : entries) {
+        ASSERT_TRUE(entry.page >= 0);
+    }
+}
+
+TEST(test_oversized_image_left_out) {
+    std::vector<AtlasEntry> sizes = { Size(64, 64), Size(4096, 16) };
+    std::vector<AtlasEntry> entries;
+    std::vector<int> pageSizes;
+    ASSERT_EQ(TextureAtlas::Pack(sizes, 2048, entries, pageSizes), 1);
+    ASSERT_EQ(entries[0].page, 0);
+    ASSERT_EQ(entries[1].page, -1);
+}
+
+TEST(test_build_uploads_pages) {
+    std::vector<Image> images = { GenImageColor(64, 32, WHITE), GenImageColor(32, 32, BLACK) };
+    TextureAtlas atlas;
+    ASSERT_TRUE(atlas.Build(images));
+    ASSERT_EQ(atlas.GetPageCount(), 1);
+    ASSERT_TRUE(atlas.GetPage(0).id != 0);
+    ASSERT_EQ(atlas.GetPage(0).width, TextureAtlas::MIN_PAGE_SIZE);
+    ASSERT_EQ(atlas.GetEntry(1).page, 0);
+    ASSERT_FALSE(Overlaps(atlas.GetEntry(0), atlas.GetEntry(1)));
+    for (Image& image : images) UnloadImage(image);
+
+    atlas.Clear();
+    ASSERT_EQ(atlas.GetPageCount(), 0);
+}
+
+int main() {
+    std::cout << "=== Texture Atlas Tests ===" << std::endl;
+    RUN_TEST(test_default_sheets_share_one_page);
+    RUN_TEST(test_page_is_smallest_power_of_two);
+    RUN_TEST(test_overflow_opens_another_page);
+    RUN_TEST(test_oversized_image_left_out);
+    RUN_TEST(test_build_uploads_pages);
+
+    std::cout << std::endl << s_passed << " passed, " << s_failed << " failed" << std::endl;
+    return s_failed > 0 ? 1 : 0;
+}
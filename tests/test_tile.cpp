@@ -1,5 +1,5 @@
 // Harvest Quest — Tile system unit tests
-// Tests tile registry, tile properties, and crop growth
+// Tests tile registry, tile properties, and farm plot crop growth
 
 #include "world/Tile.h"
 #include <cassert>
@@ -52,9 +52,18 @@ TEST(test_tile_default_constructor) {
     Tile tile;
     ASSERT_EQ(tile.GetType(), TileType::GRASS);
     ASSERT_EQ(tile.GetVisualId(), 0);
-    ASSERT_EQ(tile.GetSoilState(), SoilState::GRASS);
-    ASSERT_EQ(tile.GetCropType(), -1);
-    ASSERT_EQ(tile.GetGrowthStage(), 0);
+}
+
+TEST(test_tile_is_compact) {
+    // Farm state lives in FarmPlot, so the dense tile stays tiny
+    ASSERT_TRUE(sizeof(Tile) <= 2);
+}
+
+TEST(test_farm_plot_default_constructor) {
+    FarmPlot plot;
+    ASSERT_EQ(plot.GetSoilState(), SoilState::GRASS);
+    ASSERT_EQ(plot.GetCropType(), -1);
+    ASSERT_EQ(plot.GetGrowthStage(), 0);
 }
 
 TEST(test_tile_parameterized_constructor) {
@@ -64,18 +73,19 @@ TEST(test_tile_parameterized_constructor) {
     ASSERT_TRUE(tile.IsSolid());
 }
 
-TEST(test_tile_crop_growth) {
-    Tile tile(TileType::SOIL);
-    tile.SetSoilState(SoilState::CROP);
-    tile.SetCropType(0);
-    ASSERT_EQ(tile.GetGrowthStage(), 0);
+TEST(test_farm_plot_crop_growth) {
+    FarmPlot plot;
+    plot.SetSoilState(SoilState::CROP);
+    plot.SetCropType(0);
+    ASSERT_EQ(plot.GetGrowthStage(), 0);
 
-    // Simulate time passing (growth interval is 5.0s)
-    for (int i = 0; i < 4; ++i) {
-        tile.Update(5.0f);
+    // Each growth event advances one stage; the last one makes it harvestable
+    for (int i = 0; i < 3; ++i) {
+        ASSERT_TRUE(plot.AdvanceGrowth());
     }
-    ASSERT_EQ(tile.GetGrowthStage(), Tile::MAX_GROWTH_STAGE);
-    ASSERT_EQ(tile.GetSoilState(), SoilState::HARVEST);
+    ASSERT_FALSE(plot.AdvanceGrowth());
+    ASSERT_EQ(plot.GetGrowthStage(), FarmPlot::MAX_GROWTH_STAGE);
+    ASSERT_EQ(plot.GetSoilState(), SoilState::HARVEST);
 }
 
 int main() {
@@ -85,8 +95,10 @@ int main() {
     RUN_TEST(test_tile_soil_is_farmable);
     RUN_TEST(test_tile_tree_properties);
     RUN_TEST(test_tile_default_constructor);
+    RUN_TEST(test_tile_is_compact);
+    RUN_TEST(test_farm_plot_default_constructor);
     RUN_TEST(test_tile_parameterized_constructor);
-    RUN_TEST(test_tile_crop_growth);
+    RUN_TEST(test_farm_plot_crop_growth);
 
     std::cout << std::endl << s_passed << " passed, " << s_failed << " failed" << std::endl;
     return s_failed > 0 ? 1 : 0;
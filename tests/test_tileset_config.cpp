@@ -5,6 +5,7 @@
 #include "systems/Calendar.h"
 #include <cassert>
 #include <iostream>
+#include <cstdio>
 #include <fstream>
 
 static int s_passed = 0;
@@ -230,6 +231,56 @@ TEST(test_all_tile_types_have_defaults) {
     ASSERT_TRUE(cfg.GetSpriteId(TileType::TREE) >= 0);
 }
 
+// ===== Compiled Table Tests =====
+
+TEST(test_compiled_table_defaults) {
+    TilesetConfig cfg;
+    cfg.LoadDefaults();
+    ASSERT_EQ(cfg.GetTileSpriteId(TileType::GRASS, Season::SPRING, 0), 0);
+    ASSERT_EQ(cfg.GetTileSpriteId(TileType::DOOR, Season::WINTER, 5), 20);     // Variant ignored
+    ASSERT_EQ(cfg.GetTileSpriteId(TileType::WALL, Season::FALL, 3), 10);
+    ASSERT_EQ(cfg.GetTileSpriteId(TileType::DECORATION, Season::SPRING, 2), 42);
+    ASSERT_EQ(cfg.GetTileSpriteId(TileType::CROP, Season::SUMMER, 4), 34);
+    ASSERT_EQ(cfg.GetTileSpriteId(TileType::TREE, Season::SPRING, 9), 50);
+    // Water: the variant is the animation frame
+    ASSERT_EQ(cfg.GetTileSpriteId(TileType::WATER, Season::SPRING, 0), 3);
+    ASSERT_EQ(cfg.GetTileSpriteId(TileType::WATER, Season::SPRING, 3), 23);
+    ASSERT_EQ(cfg.GetTileSpriteId(TileType::WATER, Season::SPRING, 6), 3);     // Past the last frame
+}
+
+TEST(test_compiled_table_follows_reload) {
+    const char* path = "/tmp/test_compiled.cfg";
+    {
+        std::ofstream f(path);
+        f << "GRASS.WINTER 192\n";
+        f << "WALL_AUTOTILE_BASE 100\n";
+        f << "WATER_ANIM_FRAMES 60 61\n";
+    }
+
+    TilesetConfig cfg;
+    ASSERT_TRUE(cfg.LoadFromFile(path));
+    ASSERT_EQ(cfg.GetTileSpriteId(TileType::GRASS, Season::WINTER, 0), 192);
+    ASSERT_EQ(cfg.GetTileSpriteId(TileType::GRASS, Season::SUMMER, 0), 0);
+    ASSERT_EQ(cfg.GetTileSpriteId(TileType::WALL, Season::SUMMER, 255), 355);
+    ASSERT_EQ(cfg.GetTileSpriteId(TileType::WATER, Season::FALL, 1), 61);
+    ASSERT_EQ(cfg.GetTileSpriteId(TileType::WATER, Season::FALL, 2), 60);
+
+    // Every entry matches the per-type lookup it replaces
+    for (int season = 0; season < TilesetConfig::SEASON_COUNT; ++season) {
+        for (int type = 0; type < TilesetConfig::TILE_TYPE_COUNT; ++type) {
+            TileType tileType = static_cast<TileType>(type);
+            if (tileType == TileType::WATER || tileType == TileType::WALL || tileType == TileType::CROP ||
+                tileType == TileType::DECORATION || tileType == TileType::TREE) continue;
+            ASSERT_EQ(cfg.GetTileSpriteId(tileType, static_cast<Season>(season), 0),
+                      cfg.GetSpriteId(tileType, static_cast<Season>(season)));
+        }
+    }
+
+    cfg.LoadDefaults();
+    ASSERT_EQ(cfg.GetTileSpriteId(TileType::GRASS, Season::WINTER, 0), 0);
+    std::remove(path);
+}
+
 int main() {
     std::cout << "=== TilesetConfig Tests ===" << std::endl;
     RUN_TEST(test_defaults_load);
@@ -246,6 +297,8 @@ int main() {
     RUN_TEST(test_overrides_persist_on_reload);
     RUN_TEST(test_sheet_file_with_spaces);
     RUN_TEST(test_all_tile_types_have_defaults);
+    RUN_TEST(test_compiled_table_defaults);
+    RUN_TEST(test_compiled_table_follows_reload);
 
     std::cout << std::endl << s_passed << " passed, " << s_failed << " failed" << std::endl;
     return s_failed > 0 ? 1 : 0;
@@ -0,0 +1,138 @@
+// Harvest Quest — Timer wheel unit tests
+
+#include "world/TimerWheel.h"
+#include <cassert>
+#include <iostream>
+#include <vector>
+
+static int s_passed = 0;
+static int s_failed = 0;
+
+#define TEST(name) static void name()
+#define RUN_TEST(name) do { \
+    std::cout << "  " #name "... "; \
+    try { name(); std::cout << "PASS" << std::endl; s_passed++; } \
+    catch (...) { std::cout << "FAIL" << std::endl; s_failed++; } \
+} while(0)
+#define ASSERT_TRUE(expr)  do { if (!(expr)) throw 1; } while(0)
+#define ASSERT_FALSE(expr) do { if (expr) throw 1; } while(0)
+#define ASSERT_EQ(a, b)    do { if ((a) != (b)) throw 1; } while(0)
+
+static TileEvent MakeEvent(int index) {
+    return TileEvent{index, TileEventType::CROP_GROWTH, 0};
+}
+
+// Advance one tick at a time and return the tick the event fired on (0 = never)
+static std::uint64_t FireTick(TimerWheel& wheel, std::uint64_t maxTicks) {
+    std::vector<TileEvent> due;
+    for (std::uint64_t i = 0; i < maxTicks; ++i) {
+        wheel.AdvanceTicks(1, due);
+        if (!due.empty()) return wheel.GetCurrentTick();
+    }
+    return 0;
+}
+
+TEST(test_empty_wheel) {
+    TimerWheel wheel;
+    std::vector<TileEvent> due;
+    wheel.AdvanceTicks(1000, due);
+    ASSERT_TRUE(due.empty());
+    ASSERT_EQ(wheel.GetPendingCount(), 0);
+    ASSERT_EQ(wheel.GetCurrentTick(), 1000u);
+}
+
+TEST(test_fires_on_exact_tick) {
+    TimerWheel wheel;
+    wheel.ScheduleTicks(5, MakeEvent(7));
+    ASSERT_EQ(wheel.GetPendingCount(), 1);
+
+    std::vector<TileEvent> due;
+    wheel.AdvanceTicks(4, due);
+    ASSERT_TRUE(due.empty());
+    wheel.AdvanceTicks(1, due);
+    ASSERT_EQ(due.size(), 1u);
+    ASSERT_EQ(due[0].tileIndex, 7);
+    ASSERT_EQ(wheel.GetPendingCount(), 0);
+}
+
+TEST(test_zero_delay_fires_next_tick) {
+    TimerWheel wheel;
+    wheel.ScheduleTicks(0, MakeEvent(1));
+    ASSERT_EQ(FireTick(wheel, 10), 1u);
+}
+
+TEST(test_multi_level_delays) {
+    // Delays that start in each level of the wheel must cascade down and fire on time
+    const std::uint64_t delays[] = {63, 64, 65, 4095, 4096, 10000, 300000};
+    for (std::uint64_t delay : delays) {
+        TimerWheel wheel;
+        std::vector<TileEvent> due;
+        wheel.AdvanceTicks(37, due);  // Start off a slot boundary
+        wheel.ScheduleTicks(delay, MakeEvent(0));
+        ASSERT_EQ(FireTick(wheel, delay + 10), 37 + delay);
+    }
+}
+
+TEST(test_far_future_delay_is_clamped_not_lost) {
+    TimerWheel wheel;
+    wheel.ScheduleTicks(TimerWheel::MAX_DELAY_TICKS + 100, MakeEvent(3));
+
+    std::vector<TileEvent> due;
+    wheel.AdvanceTicks(TimerWheel::MAX_DELAY_TICKS, due);
+    ASSERT_TRUE(due.empty());
+    ASSERT_EQ(wheel.GetPendingCount(), 1);
+    wheel.AdvanceTicks(100, due);
+    ASSERT_EQ(due.size(), 1u);
+}
+
+TEST(test_many_events_same_slot) {
+    TimerWheel wheel;
+    for (int i = 0; i < 100; ++i) {
+        wheel.ScheduleTicks(10, MakeEvent(i));
+    }
+    std::vector<TileEvent> due;
+    wheel.AdvanceTicks(10, due);
+    ASSERT_EQ(due.size(), 100u);
+    ASSERT_EQ(wheel.GetPendingCount(), 0);
+}
+
+TEST(test_advance_with_seconds) {
+    TimerWheel wheel;
+    wheel.Schedule(1.0f, MakeEvent(0));  // 20 ticks
+
+    // Small frame steps accumulate into whole ticks
+    std::vector<TileEvent> due;
+    for (int i = 0; i < 59; ++i) {
+        wheel.Advance(1.0f / 60.0f, due);
+    }
+    ASSERT_TRUE(due.empty());
+    wheel.Advance(2.0f / 60.0f, due);
+    ASSERT_EQ(due.size(), 1u);
+}
+
+TEST(test_clear) {
+    TimerWheel wheel;
+    wheel.ScheduleTicks(3, MakeEvent(0));
+    wheel.ScheduleTicks(5000, MakeEvent(1));
+    wheel.Clear();
+    ASSERT_EQ(wheel.GetPendingCount(), 0);
+
+    std::vector<TileEvent> due;
+    wheel.AdvanceTicks(6000, due);
+    ASSERT_TRUE(due.empty());
+}
+
+int main() {
+    std::cout << "=== Timer Wheel Tests ===" << std::endl;
+    RUN_TEST(test_empty_wheel);
+    RUN_TEST(test_fires_on_exact_tick);
+    RUN_TEST(test_zero_delay_fires_next_tick);
+    RUN_TEST(test_multi_level_delays);
+    RUN_TEST(test_far_future_delay_is_clamped_not_lost);
+    RUN_TEST(test_many_events_same_slot);
+    RUN_TEST(test_advance_with_seconds);
+    RUN_TEST(test_clear);
+
+    std::cout << std::endl << s_passed << " passed, " << s_failed << " failed" << std::endl;
+    return s_failed > 0 ? 1 : 0;
+}